@@ -51,6 +51,12 @@ set(protobuf_HEADERS
   ${descriptor_proto_proto_srcs}
   ${plugin_proto_proto_srcs}
 )
+if(HAVE_ZSTD)
+  list(APPEND protobuf_HEADERS ${libprotobuf_zstd_hdrs})
+endif()
+if(HAVE_LZ4)
+  list(APPEND protobuf_HEADERS ${libprotobuf_lz4_hdrs})
+endif()
 foreach(_header ${protobuf_HEADERS})
   string(REPLACE "${protobuf_SOURCE_DIR}/src" "" _header ${_header})
   get_filename_component(_extract_from "${protobuf_SOURCE_DIR}/src/${_header}" ABSOLUTE)
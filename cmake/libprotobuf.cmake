@@ -2,6 +2,12 @@
 
 include(${protobuf_SOURCE_DIR}/src/file_lists.cmake)
 
+# Optional compression streams, see protobuf_WITH_ZSTD and protobuf_WITH_LZ4.
+set(libprotobuf_zstd_srcs ${protobuf_SOURCE_DIR}/src/google/protobuf/io/zstd_stream.cc)
+set(libprotobuf_zstd_hdrs ${protobuf_SOURCE_DIR}/src/google/protobuf/io/zstd_stream.h)
+set(libprotobuf_lz4_srcs ${protobuf_SOURCE_DIR}/src/google/protobuf/io/lz4_stream.cc)
+set(libprotobuf_lz4_hdrs ${protobuf_SOURCE_DIR}/src/google/protobuf/io/lz4_stream.h)
+
 add_library(libprotobuf ${protobuf_SHARED_OR_STATIC}
   ${libprotobuf_srcs}
   ${libprotobuf_hdrs}
@@ -19,6 +25,14 @@ target_link_libraries(libprotobuf PRIVATE ${CMAKE_THREAD_LIBS_INIT})
 if(protobuf_WITH_ZLIB)
   target_link_libraries(libprotobuf PRIVATE ${ZLIB_LIBRARIES})
 endif()
+if(HAVE_ZSTD)
+  target_sources(libprotobuf PRIVATE ${libprotobuf_zstd_srcs} ${libprotobuf_zstd_hdrs})
+  target_link_libraries(libprotobuf PRIVATE ${ZSTD_LIBRARIES})
+endif()
+if(HAVE_LZ4)
+  target_sources(libprotobuf PRIVATE ${libprotobuf_lz4_srcs} ${libprotobuf_lz4_hdrs})
+  target_link_libraries(libprotobuf PRIVATE ${LZ4_LIBRARIES})
+endif()
 if(protobuf_LINK_LIBATOMIC)
   target_link_libraries(libprotobuf PRIVATE atomic)
 endif()
@@ -27,6 +41,10 @@ if(${CMAKE_SYSTEM_NAME} STREQUAL "Android")
 endif()
 target_include_directories(libprotobuf PUBLIC ${protobuf_SOURCE_DIR}/src)
 target_link_libraries(libprotobuf PUBLIC ${protobuf_ABSL_USED_TARGETS})
+if(NOT (BUILD_SHARED_LIBS AND MSVC))
+  # Only arenaz_profile.cc needs it; keep it out of libprotobuf-lite.
+  target_link_libraries(libprotobuf PRIVATE absl::symbolize)
+endif()
 if(protobuf_BUILD_SHARED_LIBS)
   target_compile_definitions(libprotobuf
     PUBLIC  PROTOBUF_USE_DLLS
@@ -78,6 +78,21 @@ foreach(proto_file ${tests_protos})
   set(tests_proto_files ${tests_proto_files} ${pb_src} ${pb_hdr})
 endforeach(proto_file)
 
+# unittest_table_driven.proto is compiled with generator options that make its
+# messages serialize from their tables, so it is kept out of tests_protos.
+set(table_driven_test_proto
+  ${protobuf_SOURCE_DIR}/src/google/protobuf/unittest_table_driven.proto)
+string(REPLACE .proto .pb.h pb_hdr ${table_driven_test_proto})
+string(REPLACE .proto .pb.cc pb_src ${table_driven_test_proto})
+add_custom_command(
+  OUTPUT ${pb_hdr} ${pb_src}
+  DEPENDS ${protobuf_PROTOC_EXE} ${table_driven_test_proto}
+  COMMAND ${protobuf_PROTOC_EXE} ${table_driven_test_proto}
+      --proto_path=${protobuf_SOURCE_DIR}/src
+      --cpp_out=experimental_table_driven_serialization,experimental_tail_call_table_mode=always:${protobuf_SOURCE_DIR}/src
+)
+set(tests_proto_files ${tests_proto_files} ${pb_src} ${pb_hdr})
+
 set(common_test_files
   ${test_util_hdrs}
   ${lite_test_util_srcs}
@@ -294,6 +294,11 @@ failure:
   return target;
 }
 
+::uint8_t* Any::_InternalSerializeFlatSized(
+    ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  return Any::_InternalSerialize(target, stream);
+}
+
 ::size_t Any::ByteSizeLong() const {
 // @@protoc_insertion_point(message_byte_size_start:google.protobuf.Any)
   ::size_t total_size = 0;
@@ -319,6 +324,32 @@ failure:
   return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
+::size_t Any::FlatByteSizeLong(
+    ::_pbi::FlatSizeCache* sizes) const {
+  ::size_t total_size = 0;
+  (void) sizes;
+
+  // string type_url = 1;
+  if (!this->_internal_type_url().empty()) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
+        this->_internal_type_url());
+  }
+
+  // bytes value = 2;
+  if (!this->_internal_value().empty()) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::BytesSize(
+        this->_internal_value());
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    total_size += ::_pbi::WireFormat::ComputeUnknownFieldsSize(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance));
+  }
+  return total_size;
+}
+
 const ::PROTOBUF_NAMESPACE_ID::Message::ClassData Any::_class_data_ = {
     ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
     Any::MergeImpl
@@ -190,9 +190,14 @@ class PROTOBUF_EXPORT Any final :
   bool IsInitialized() const final;
 
   ::size_t ByteSizeLong() const final;
+  ::size_t FlatByteSizeLong(
+      ::PROTOBUF_NAMESPACE_ID::internal::FlatSizeCache* sizes) const final;
+  typedef void InternalFlatSizeCacheSupported_;
   const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
   ::uint8_t* _InternalSerialize(
       ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  ::uint8_t* _InternalSerializeFlatSized(
+      ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
   int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
   private:
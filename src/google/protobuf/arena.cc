@@ -40,6 +40,7 @@
 #include "absl/base/attributes.h"
 #include "absl/synchronization/mutex.h"
 #include "google/protobuf/arena_allocation_policy.h"
+#include "google/protobuf/arena_block_pool.h"
 #include "google/protobuf/arenaz_sampler.h"
 #include "google/protobuf/port.h"
 #include "google/protobuf/serial_arena.h"
@@ -50,6 +51,12 @@
 #include <sanitizer/asan_interface.h>
 #endif  // ADDRESS_SANITIZER
 
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif  // __linux__
+
 // Must be included last.
 #include "google/protobuf/port_def.inc"
 
@@ -79,6 +86,75 @@ ArenaBlock* SentryArenaBlock() {
 }
 #endif
 
+#ifdef __linux__
+// Huge page blocks are mapped in multiples of the huge page size, so that the
+// tail of a block does not fall back to regular pages.
+size_t HugePageMappingSize(size_t size) {
+  constexpr size_t kHugePageSize = AllocationPolicy::kHugePageSize;
+  return (size + kHugePageSize - 1) & ~(kHugePageSize - 1);
+}
+
+// Asks the kernel to place the pages of [p, p + size) on the NUMA node of the
+// calling thread. Arena blocks are only allocated by the thread that owns
+// them, so this keeps a SerialArena's memory local to its thread even if
+// another thread happens to touch a page first. Failures are ignored: memory
+// then follows the default (first touch) policy.
+void BindToCurrentNumaNode(void* p, size_t size) {
+#if defined(SYS_getcpu) && defined(SYS_mbind)
+  constexpr int kMpolPreferred = 1;  // MPOL_PREFERRED in <linux/mempolicy.h>
+  constexpr unsigned kMaxNodes = 1024;
+  constexpr unsigned kBitsPerWord = 8 * sizeof(unsigned long);
+  unsigned cpu, node;
+  if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0 || node >= kMaxNodes) {
+    return;
+  }
+  unsigned long nodemask[kMaxNodes / kBitsPerWord] = {};
+  nodemask[node / kBitsPerWord] = 1UL << (node % kBitsPerWord);
+  syscall(SYS_mbind, p, size, kMpolPreferred, nodemask, kMaxNodes + 1, 0);
+#endif
+}
+#endif  // __linux__
+
+void* AllocateHugePageBlock(size_t size) {
+#ifdef __linux__
+  constexpr size_t kHugePageSize = AllocationPolicy::kHugePageSize;
+  if (size >= kHugePageSize) {
+    const size_t mapping_size = HugePageMappingSize(size);
+    // mmap only guarantees page alignment; map one extra huge page and unmap
+    // what lies outside the aligned range.
+    void* p = mmap(nullptr, mapping_size + kHugePageSize,
+                   PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    GOOGLE_ABSL_CHECK(p != MAP_FAILED) << "mmap of " << mapping_size
+                                << " bytes failed";
+    char* begin = static_cast<char*>(p);
+    char* aligned = reinterpret_cast<char*>(
+        (reinterpret_cast<uintptr_t>(begin) + kHugePageSize - 1) &
+        ~(kHugePageSize - 1));
+    char* end = begin + mapping_size + kHugePageSize;
+    if (aligned != begin) munmap(begin, aligned - begin);
+    if (aligned + mapping_size != end) {
+      munmap(aligned + mapping_size, end - (aligned + mapping_size));
+    }
+    BindToCurrentNumaNode(aligned, mapping_size);
+#ifdef MADV_HUGEPAGE
+    madvise(aligned, mapping_size, MADV_HUGEPAGE);
+#endif
+    return aligned;
+  }
+#endif  // __linux__
+  return ::operator new(size);
+}
+
+void DeallocateHugePageBlock(void* p, size_t size) {
+#ifdef __linux__
+  if (size >= AllocationPolicy::kHugePageSize) {
+    munmap(p, HugePageMappingSize(size));
+    return;
+  }
+#endif  // __linux__
+  internal::SizedDelete(p, size);
+}
+
 }  // namespace
 
 static SerialArena::Memory AllocateMemory(const AllocationPolicy* policy_ptr,
@@ -99,7 +175,11 @@ static SerialArena::Memory AllocateMemory(const AllocationPolicy* policy_ptr,
   size = std::max(size, SerialArena::kBlockHeaderSize + min_bytes);
 
   void* mem;
-  if (policy.block_alloc == nullptr) {
+  if (policy.block_pool != nullptr) {
+    mem = policy.block_pool->Allocate(&size);
+  } else if (policy.huge_pages) {
+    mem = AllocateHugePageBlock(size);
+  } else if (policy.block_alloc == nullptr) {
     mem = ::operator new(size);
   } else {
     mem = policy.block_alloc(size);
@@ -111,6 +191,8 @@ class GetDeallocator {
  public:
   GetDeallocator(const AllocationPolicy* policy, size_t* space_allocated)
       : dealloc_(policy ? policy->block_dealloc : nullptr),
+        pool_(policy ? policy->block_pool : nullptr),
+        huge_pages_(policy ? policy->huge_pages : false),
         space_allocated_(space_allocated) {}
 
   void operator()(SerialArena::Memory mem) const {
@@ -119,7 +201,11 @@ class GetDeallocator {
     // so return it in an unpoisoned state.
     ASAN_UNPOISON_MEMORY_REGION(mem.ptr, mem.size);
 #endif  // ADDRESS_SANITIZER
-    if (dealloc_) {
+    if (pool_) {
+      pool_->Release(mem.ptr, mem.size);
+    } else if (huge_pages_) {
+      DeallocateHugePageBlock(mem.ptr, mem.size);
+    } else if (dealloc_) {
       dealloc_(mem.ptr, mem.size);
     } else {
       internal::SizedDelete(mem.ptr, mem.size);
@@ -129,6 +215,8 @@ class GetDeallocator {
 
  private:
   void (*dealloc_)(void*, size_t);
+  ArenaBlockPool* pool_;
+  bool huge_pages_;
   size_t* space_allocated_;
 };
 
@@ -166,6 +254,7 @@ void SerialArena::Init(ArenaBlock* b, size_t offset) {
   space_allocated_.store(b->size, std::memory_order_relaxed);
   cached_block_length_ = 0;
   cached_blocks_ = nullptr;
+  spare_blocks_ = nullptr;
 }
 
 SerialArena* SerialArena::New(Memory mem, ThreadSafeArena& parent) {
@@ -180,6 +269,11 @@ SerialArena* SerialArena::New(Memory mem, ThreadSafeArena& parent) {
 
 template <typename Deallocator>
 SerialArena::Memory SerialArena::Free(Deallocator deallocator) {
+  while (spare_blocks_ != nullptr) {
+    Memory spare = {spare_blocks_, spare_blocks_->size};
+    spare_blocks_ = spare_blocks_->next;
+    deallocator(spare);
+  }
   ArenaBlock* b = head();
   Memory mem = {b, b->size};
   while (b->next) {
@@ -231,13 +325,21 @@ void SerialArena::AllocateNewBlock(size_t n) {
   // but with a CPU regression. The regression might have been an artifact of
   // the microbenchmark.
 
-  auto mem = AllocateMemory(parent_.AllocPolicy(), old_head->size, n);
-  // We don't want to emit an expensive RMW instruction that requires
-  // exclusive access to a cacheline. Hence we write it in terms of a
-  // regular add.
-  space_allocated_.store(
-      space_allocated_.load(std::memory_order_relaxed) + mem.size,
-      std::memory_order_relaxed);
+  Memory mem;
+  if (PROTOBUF_PREDICT_FALSE(spare_blocks_ != nullptr) &&
+      spare_blocks_->size >= kBlockHeaderSize + n) {
+    // Blocks kept by RewindTo() are still counted in space_allocated_.
+    mem = {spare_blocks_, spare_blocks_->size};
+    spare_blocks_ = spare_blocks_->next;
+  } else {
+    mem = AllocateMemory(parent_.AllocPolicy(), old_head->size, n);
+    // We don't want to emit an expensive RMW instruction that requires
+    // exclusive access to a cacheline. Hence we write it in terms of a
+    // regular add.
+    space_allocated_.store(
+        space_allocated_.load(std::memory_order_relaxed) + mem.size,
+        std::memory_order_relaxed);
+  }
   ThreadSafeArenaStats::RecordAllocateStats(parent_.arena_stats_.MutableStats(),
                                             /*used=*/used,
                                             /*allocated=*/mem.size, wasted);
@@ -271,6 +373,53 @@ uint64_t SerialArena::SpaceUsed() const {
   return current_space_used + space_used_.load(std::memory_order_relaxed);
 }
 
+ArenaCheckpoint SerialArena::Checkpoint() {
+  ArenaCheckpoint checkpoint;
+  checkpoint.serial = this;
+  checkpoint.head = head();
+  checkpoint.ptr = ptr();
+  checkpoint.limit = limit_;
+  checkpoint.space_used = space_used_.load(std::memory_order_relaxed);
+  return checkpoint;
+}
+
+void SerialArena::RewindTo(const ArenaCheckpoint& checkpoint) {
+  auto destroy_nodes = [](char* it, char* limit) {
+    while (it < limit) {
+      it += cleanup::DestroyNode(it);
+    }
+  };
+
+  // Walk the blocks allocated since the checkpoint newest first, the same
+  // order CleanupList() destroys objects in.
+  ArenaBlock* b = head();
+  char* nodes = limit_;
+  while (b != checkpoint.head) {
+    GOOGLE_ABSL_DCHECK(!b->IsSentry());
+    destroy_nodes(nodes, b->Limit());
+    ArenaBlock* next = b->next;
+    GOOGLE_ABSL_DCHECK(next != nullptr) << "Checkpoint block is not in this arena.";
+    nodes = static_cast<char*>(next->cleanup_nodes);
+    PROTOBUF_POISON_MEMORY_REGION(b->Pointer(kBlockHeaderSize),
+                                  b->Limit() - b->Pointer(kBlockHeaderSize));
+    spare_blocks_ = new (b) ArenaBlock{spare_blocks_, b->size};
+    b = next;
+  }
+  if (!b->IsSentry()) {
+    destroy_nodes(nodes, checkpoint.limit);
+  }
+
+  set_ptr(checkpoint.ptr);
+  limit_ = checkpoint.limit;
+  head_.store(b, std::memory_order_release);
+  space_used_.store(checkpoint.space_used, std::memory_order_relaxed);
+  // Arrays returned to the freelists may live in the memory that was just
+  // discarded.
+  cached_block_length_ = 0;
+  cached_blocks_ = nullptr;
+  PROTOBUF_POISON_MEMORY_REGION(ptr(), limit_ - ptr());
+}
+
 void SerialArena::CleanupList() {
   ArenaBlock* b = head();
   if (b->IsSentry()) return;
@@ -710,6 +859,28 @@ void ThreadSafeArena::AddCleanup(void* elem, void (*cleanup)(void*)) {
   arena->AddCleanup(elem, cleanup);
 }
 
+ArenaCheckpoint ThreadSafeArena::Checkpoint() {
+  SerialArena* serial;
+  if (!GetSerialArenaFast(&serial)) {
+    serial = GetSerialArenaFallback(0);
+  }
+  ArenaCheckpoint checkpoint = serial->Checkpoint();
+  checkpoint.lifecycle_id = tag_and_id_;
+  return checkpoint;
+}
+
+void ThreadSafeArena::RewindTo(const ArenaCheckpoint& checkpoint) {
+  GOOGLE_ABSL_CHECK(checkpoint.lifecycle_id == tag_and_id_)
+      << "Checkpoint was taken on another arena or before Reset().";
+  SerialArena* serial;
+  if (!GetSerialArenaFast(&serial)) {
+    serial = GetSerialArenaFallback(0);
+  }
+  GOOGLE_ABSL_CHECK(serial == checkpoint.serial)
+      << "RewindTo() must be called on the thread that took the checkpoint.";
+  serial->RewindTo(checkpoint);
+}
+
 PROTOBUF_NOINLINE
 void* ThreadSafeArena::AllocateAlignedWithCleanupFallback(
     size_t n, size_t align, void (*destructor)(void*)) {
@@ -110,6 +110,9 @@ void arena_delete_object(void* object) {
 }
 }  // namespace internal
 
+// Opaque allocation state returned by Arena::Checkpoint().
+using ArenaCheckpoint = internal::ArenaCheckpoint;
+
 // ArenaOptions provides optional additional parameters to arena construction
 // that control its block-allocation behavior.
 struct ArenaOptions {
@@ -143,6 +146,20 @@ struct ArenaOptions {
   // calls free.
   void (*block_dealloc)(void*, size_t) = nullptr;
 
+  // A pool to take blocks from and return them to, or nullptr for none. If
+  // set, block_alloc and block_dealloc are ignored and the pool must outlive
+  // the arena. See arena_block_pool.h.
+  ArenaBlockPool* block_pool = nullptr;
+
+  // If true, blocks of 2 MiB and more are mapped directly from the OS, 2 MiB
+  // aligned and advised for transparent huge pages, which cuts TLB misses for
+  // arenas holding many megabytes. Since each thread allocates from its own
+  // blocks, they are also bound to the NUMA node of the thread that allocates
+  // them. max_block_size is raised to 2 MiB if it is smaller, and
+  // block_alloc and block_dealloc are ignored. Smaller blocks and platforms
+  // other than Linux use the default allocator.
+  bool use_huge_pages = false;
+
  private:
   internal::AllocationPolicy AllocationPolicy() const {
     internal::AllocationPolicy res;
@@ -150,6 +167,12 @@ struct ArenaOptions {
     res.max_block_size = max_block_size;
     res.block_alloc = block_alloc;
     res.block_dealloc = block_dealloc;
+    res.block_pool = block_pool;
+    res.huge_pages = use_huge_pages;
+    if (use_huge_pages &&
+        res.max_block_size < internal::AllocationPolicy::kHugePageSize) {
+      res.max_block_size = internal::AllocationPolicy::kHugePageSize;
+    }
     return res;
   }
 
@@ -353,6 +376,44 @@ class PROTOBUF_EXPORT PROTOBUF_ALIGNAS(8) Arena final {
   // of the allocated blocks. This method is not thread-safe.
   uint64_t Reset() { return impl_.Reset(); }
 
+  // Saves the allocation state of the calling thread so that everything it
+  // allocates on this arena afterwards can be discarded with RewindTo(), e.g.
+  // to reuse the same memory for scratch messages in every iteration of a
+  // loop:
+  //
+  //   ArenaCheckpoint checkpoint = arena.Checkpoint();
+  //   for (...) {
+  //     auto* scratch = Arena::CreateMessage<Scratch>(&arena);
+  //     ...
+  //     arena.RewindTo(checkpoint);
+  //   }
+  //
+  // Only allocations made by the calling thread are covered.
+  ArenaCheckpoint Checkpoint() { return impl_.Checkpoint(); }
+
+  // Runs the destructors registered by the calling thread since `checkpoint`
+  // was taken, newest first, and makes the memory it allocated since then
+  // available again. Blocks allocated since the checkpoint are kept and reused
+  // by later allocations rather than freed. Any object allocated after the
+  // checkpoint is unusable after this call, and so are checkpoints taken after
+  // `checkpoint`. Must be called on the thread that took `checkpoint`, and not
+  // after Reset(). This method is not thread-safe with respect to other
+  // allocations by the calling thread.
+  //
+  // Objects created before the checkpoint survive, but memory they allocated
+  // on the arena after it does not: the buffer of a RepeatedField or
+  // RepeatedPtrField that grew, a string that was set or grew, a sub-message
+  // created by a mutable_*() accessor, or a map that rehashed. Those objects
+  // are left pointing at discarded memory and must not be used afterwards.
+  // That includes their destruction when the arena runs their destructor, as
+  // it does for non-message types created with Arena::Create(). Reserve() what
+  // they need before the checkpoint, or create them after it. In
+  // AddressSanitizer builds the discarded memory is poisoned, so such uses are
+  // reported.
+  void RewindTo(const ArenaCheckpoint& checkpoint) {
+    impl_.RewindTo(checkpoint);
+  }
+
   // Adds |object| to a list of heap-allocated objects to be freed with |delete|
   // when the arena is destroyed or reset.
   template <typename T>
@@ -38,6 +38,9 @@
 
 namespace google {
 namespace protobuf {
+
+class ArenaBlockPool;  // defined in arena_block_pool.h
+
 namespace internal {
 
 // `AllocationPolicy` defines `Arena` allocation policies. Applications can
@@ -47,6 +50,8 @@ namespace internal {
 // public configuration class such as `ArenaOptions`.
 struct AllocationPolicy {
   static constexpr size_t kDefaultStartBlockSize = 256;
+  // Size and alignment of the blocks mapped when `huge_pages` is set.
+  static constexpr size_t kHugePageSize = size_t{2} << 20;
 
   size_t start_block_size = kDefaultStartBlockSize;
   size_t max_block_size = GetDefaultArenaMaxBlockSize();
@@ -54,10 +59,21 @@ struct AllocationPolicy {
   void* (*block_alloc)(size_t) = nullptr;
   void (*block_dealloc)(void*, size_t) = nullptr;
 
+  // If set, blocks come from and go back to this pool instead of
+  // block_alloc / block_dealloc.
+  ArenaBlockPool* block_pool = nullptr;
+
+  // If set, blocks of at least kHugePageSize are mapped directly, aligned to
+  // kHugePageSize, advised for transparent huge pages and preferably placed
+  // on the NUMA node of the allocating thread. Takes precedence over
+  // block_alloc / block_dealloc, but not over block_pool.
+  bool huge_pages = false;
+
   bool IsDefault() const {
     return start_block_size == kDefaultStartBlockSize &&
            max_block_size == GetDefaultArenaMaxBlockSize() &&
-           block_alloc == nullptr && block_dealloc == nullptr;
+           block_alloc == nullptr && block_dealloc == nullptr &&
+           block_pool == nullptr && !huge_pages;
   }
 };
 
@@ -0,0 +1,186 @@
+// Protocol Buffers - Google's data interchange format
+// Copyright 2008 Google Inc.  All rights reserved.
+// https://developers.google.com/protocol-buffers/
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "google/protobuf/arena_block_pool.h"
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <thread>
+
+#include "absl/base/optimization.h"
+#include "absl/base/thread_annotations.h"
+#include "absl/numeric/bits.h"
+#include "absl/synchronization/mutex.h"
+#include "google/protobuf/port.h"
+
+// Must be included last.
+#include "google/protobuf/port_def.inc"
+
+namespace google {
+namespace protobuf {
+namespace {
+
+// Smaller blocks share the size class of the default start block size.
+constexpr int kMinSizeClass = 8;
+constexpr int kNumSizeClasses = 64 - kMinSizeClass;
+constexpr size_t kNumShards = 16;
+
+// Rounds `size` up to a power of two, and returns its log2.
+int SizeClass(size_t size) {
+  if (size <= size_t{1} << kMinSizeClass) return kMinSizeClass;
+  return static_cast<int>(absl::bit_width(size - 1));
+}
+
+struct FreeBlock {
+  FreeBlock* next;
+};
+
+}  // namespace
+
+struct alignas(ABSL_CACHELINE_SIZE) ArenaBlockPool::Shard {
+  absl::Mutex mu;
+  FreeBlock* free_blocks[kNumSizeClasses] ABSL_GUARDED_BY(mu) = {};
+  uint64_t hits ABSL_GUARDED_BY(mu) = 0;
+  uint64_t misses ABSL_GUARDED_BY(mu) = 0;
+  // Only written with `mu` held, but read without it by threads looking for a
+  // shard to take blocks from.
+  std::atomic<size_t> retained_bytes{0};
+};
+
+ArenaBlockPool::ArenaBlockPool(const Options& options)
+    : options_(options), shards_(new Shard[kNumShards]) {}
+
+ArenaBlockPool::~ArenaBlockPool() {
+  Trim();
+  delete[] shards_;
+}
+
+ArenaBlockPool* ArenaBlockPool::Global() {
+  static ArenaBlockPool* const pool = new ArenaBlockPool();
+  return pool;
+}
+
+ArenaBlockPool::Shard& ArenaBlockPool::ThisThreadShard() const {
+  return shards_[std::hash<std::thread::id>()(std::this_thread::get_id()) %
+                 kNumShards];
+}
+
+void* ArenaBlockPool::TryAllocateFrom(Shard& shard, int size_class) {
+  absl::MutexLock lock(&shard.mu);
+  FreeBlock*& head = shard.free_blocks[size_class - kMinSizeClass];
+  if (head == nullptr) return nullptr;
+  FreeBlock* block = head;
+  head = block->next;
+  ++shard.hits;
+  shard.retained_bytes.store(
+      shard.retained_bytes.load(std::memory_order_relaxed) -
+          (size_t{1} << size_class),
+      std::memory_order_relaxed);
+  return block;
+}
+
+void ArenaBlockPool::RecordMiss() {
+  Shard& shard = ThisThreadShard();
+  absl::MutexLock lock(&shard.mu);
+  ++shard.misses;
+}
+
+void* ArenaBlockPool::Allocate(size_t* size) {
+  if (*size <= options_.max_block_size) {
+    const int size_class = SizeClass(*size);
+    *size = size_t{1} << size_class;
+    Shard& own = ThisThreadShard();
+    if (void* block = TryAllocateFrom(own, size_class)) return block;
+    // Blocks go back to the shard of the thread destroying the arena, which
+    // need not be the one creating the next arena.
+    for (size_t i = 0; i < kNumShards; ++i) {
+      Shard& shard = shards_[i];
+      if (&shard == &own ||
+          shard.retained_bytes.load(std::memory_order_relaxed) < *size) {
+        continue;
+      }
+      if (void* block = TryAllocateFrom(shard, size_class)) return block;
+    }
+  }
+  RecordMiss();
+  return ::operator new(*size);
+}
+
+void ArenaBlockPool::Release(void* block, size_t size) {
+  const int size_class = SizeClass(size);
+  // Only blocks handed out by Allocate() have a size class of their own.
+  if (size <= options_.max_block_size && size == size_t{1} << size_class) {
+    Shard& shard = ThisThreadShard();
+    absl::MutexLock lock(&shard.mu);
+    const size_t retained = shard.retained_bytes.load(std::memory_order_relaxed);
+    if (retained + size <= options_.max_retained_bytes / kNumShards) {
+      FreeBlock*& head = shard.free_blocks[size_class - kMinSizeClass];
+      head = new (block) FreeBlock{head};
+      shard.retained_bytes.store(retained + size, std::memory_order_relaxed);
+      return;
+    }
+  }
+  internal::SizedDelete(block, size);
+}
+
+ArenaBlockPool::Stats ArenaBlockPool::GetStats() const {
+  Stats stats;
+  for (size_t i = 0; i < kNumShards; ++i) {
+    Shard& shard = shards_[i];
+    absl::MutexLock lock(&shard.mu);
+    stats.hits += shard.hits;
+    stats.misses += shard.misses;
+    stats.retained_bytes += shard.retained_bytes.load(std::memory_order_relaxed);
+  }
+  return stats;
+}
+
+void ArenaBlockPool::Trim() {
+  for (size_t i = 0; i < kNumShards; ++i) {
+    Shard& shard = shards_[i];
+    absl::MutexLock lock(&shard.mu);
+    for (int size_class = kMinSizeClass;
+         size_class < kMinSizeClass + kNumSizeClasses; ++size_class) {
+      FreeBlock*& head = shard.free_blocks[size_class - kMinSizeClass];
+      while (head != nullptr) {
+        FreeBlock* block = head;
+        head = block->next;
+        internal::SizedDelete(block, size_t{1} << size_class);
+      }
+    }
+    shard.retained_bytes.store(0, std::memory_order_relaxed);
+  }
+}
+
+}  // namespace protobuf
+}  // namespace google
+
+#include "google/protobuf/port_undef.inc"
@@ -0,0 +1,123 @@
+// Protocol Buffers - Google's data interchange format
+// Copyright 2008 Google Inc.  All rights reserved.
+// https://developers.google.com/protocol-buffers/
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// This file defines ArenaBlockPool, a process-wide cache of arena blocks.
+
+#ifndef GOOGLE_PROTOBUF_ARENA_BLOCK_POOL_H__
+#define GOOGLE_PROTOBUF_ARENA_BLOCK_POOL_H__
+
+#include <cstddef>
+#include <cstdint>
+
+// Must be included last.
+#include "google/protobuf/port_def.inc"
+
+namespace google {
+namespace protobuf {
+
+// ArenaBlockPool keeps the blocks of destroyed arenas around so that arenas
+// created later can reuse them instead of going to the system allocator. It is
+// meant for servers creating one short-lived Arena per request: with a pool,
+// arena setup and teardown stop hitting malloc once the pool is warm. This
+// pays off for arenas whose blocks are large enough for malloc to hand them to
+// mmap; small blocks are usually served as fast by malloc's own caches.
+//
+// An arena uses a pool when ArenaOptions::block_pool is set. Freed blocks are
+// kept in freelists per power-of-two size class, so sizes follow the geometric
+// growth of arena blocks, and requests are rounded up to the size class. The
+// freelists are sharded by thread to keep concurrent arenas from contending on
+// a single lock; a thread whose shard is empty takes blocks from the others.
+//
+// All member functions are thread-safe. A pool must outlive every arena using
+// it; Global() returns a pool that is never destroyed.
+class PROTOBUF_EXPORT ArenaBlockPool {
+ public:
+  struct Options {
+    // Bound on the bytes kept in the freelists. It is split evenly between
+    // the shards; blocks released to a full shard are returned to the system
+    // allocator.
+    size_t max_retained_bytes = size_t{64} << 20;
+    // Larger blocks are never pooled.
+    size_t max_block_size = size_t{1} << 20;
+  };
+
+  struct Stats {
+    // Blocks handed out from the freelists.
+    uint64_t hits = 0;
+    // Blocks that had to be allocated from the system.
+    uint64_t misses = 0;
+    // Bytes currently held in the freelists.
+    size_t retained_bytes = 0;
+
+    double hit_rate() const {
+      return hits + misses == 0
+                 ? 0
+                 : static_cast<double>(hits) / static_cast<double>(hits + misses);
+    }
+  };
+
+  ArenaBlockPool() : ArenaBlockPool(Options()) {}
+  explicit ArenaBlockPool(const Options& options);
+  ArenaBlockPool(const ArenaBlockPool&) = delete;
+  ArenaBlockPool& operator=(const ArenaBlockPool&) = delete;
+  ~ArenaBlockPool();
+
+  // Returns a process-wide pool with default options.
+  static ArenaBlockPool* Global();
+
+  // Returns a block of at least `*size` bytes and sets `*size` to its actual
+  // size. Used by Arena.
+  void* Allocate(size_t* size);
+
+  // Takes back a block returned by Allocate(). Used by Arena.
+  void Release(void* block, size_t size);
+
+  Stats GetStats() const;
+
+  // Returns all retained blocks to the system allocator.
+  void Trim();
+
+ private:
+  struct Shard;
+
+  Shard& ThisThreadShard() const;
+  void* TryAllocateFrom(Shard& shard, int size_class);
+  void RecordMiss();
+
+  const Options options_;
+  Shard* shards_;
+};
+
+}  // namespace protobuf
+}  // namespace google
+
+#include "google/protobuf/port_undef.inc"
+
+#endif  // GOOGLE_PROTOBUF_ARENA_BLOCK_POOL_H__
@@ -0,0 +1,126 @@
+// Protocol Buffers - Google's data interchange format
+// Copyright 2008 Google Inc.  All rights reserved.
+// https://developers.google.com/protocol-buffers/
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Measures parsing a large message, many megabytes of small sub-messages,
+// into an arena with the default block allocation and with
+// ArenaOptions::use_huge_pages.  Each configuration is run with one thread
+// and with several threads that parse into arenas of their own, which is
+// where binding blocks to the NUMA node of the allocating thread matters.
+// Every parse uses a fresh arena, so block allocation is part of the cost;
+// the arena is kept and Reset() in a second pass.
+//
+// Usage: arena_huge_pages_benchmark [sub-messages] [threads]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "google/protobuf/arena.h"
+#include "google/protobuf/stubs/logging.h"
+#include "google/protobuf/unittest.pb.h"
+
+namespace google {
+namespace protobuf {
+namespace {
+
+using ::protobuf_unittest::TestAllTypes;
+
+double Seconds(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                       start)
+      .count();
+}
+
+std::string MakeMessage(int count) {
+  TestAllTypes message;
+  for (int i = 0; i < count; ++i) {
+    message.add_repeated_nested_message()->set_bb(i);
+    message.add_repeated_foreign_message()->set_c(i);
+  }
+  return message.SerializeAsString();
+}
+
+// Parses `data` `rounds` times on each of `threads` threads and returns the
+// total throughput in MB/s.
+double Measure(const std::string& data, int rounds, int threads,
+               bool huge_pages, bool reuse) {
+  ArenaOptions options;
+  options.use_huge_pages = huge_pages;
+  auto parse = [&] {
+    Arena reused(options);
+    for (int r = 0; r < rounds; ++r) {
+      if (reuse) {
+        reused.Reset();
+        auto* message = Arena::CreateMessage<TestAllTypes>(&reused);
+        GOOGLE_ABSL_CHECK(message->ParseFromString(data));
+      } else {
+        Arena arena(options);
+        auto* message = Arena::CreateMessage<TestAllTypes>(&arena);
+        GOOGLE_ABSL_CHECK(message->ParseFromString(data));
+      }
+    }
+  };
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; ++t) workers.emplace_back(parse);
+  for (auto& worker : workers) worker.join();
+  return static_cast<double>(data.size()) * rounds * threads /
+         Seconds(start) / 1e6;
+}
+
+int Run(int count, int threads) {
+  const std::string data = MakeMessage(count);
+  const int rounds = static_cast<int>(200e6 / data.size()) + 1;
+  printf("message of %.1f MB, %d rounds\n", data.size() / 1e6, rounds);
+  for (int t : {1, threads}) {
+    for (bool reuse : {false, true}) {
+      const double plain = Measure(data, rounds, t, false, reuse);
+      const double huge = Measure(data, rounds, t, true, reuse);
+      printf(
+          "%2d thread(s), %-11s default %7.1f  huge pages %7.1f MB/s "
+          "(%.2fx)\n",
+          t, reuse ? "Reset()" : "fresh arena", plain, huge, huge / plain);
+    }
+  }
+  return 0;
+}
+
+}  // namespace
+}  // namespace protobuf
+}  // namespace google
+
+int main(int argc, char* argv[]) {
+  int count = argc > 1 ? atoi(argv[1]) : 600000;
+  int threads = argc > 2 ? atoi(argv[2]) : 4;
+  return google::protobuf::Run(count, threads);
+}
@@ -35,6 +35,7 @@
 #include <cstring>
 #include <memory>
 #include <string>
+#include <thread>
 #include <type_traits>
 #include <typeinfo>
 #include <vector>
@@ -44,6 +45,7 @@
 #include "google/protobuf/stubs/logging.h"
 #include "absl/strings/string_view.h"
 #include "absl/synchronization/barrier.h"
+#include "google/protobuf/arena_block_pool.h"
 #include "google/protobuf/arena_test_util.h"
 #include "google/protobuf/descriptor.h"
 #include "google/protobuf/extension_set.h"
@@ -69,6 +71,7 @@ using protobuf_unittest::TestAllExtensions;
 using protobuf_unittest::TestAllTypes;
 using protobuf_unittest::TestEmptyMessage;
 using protobuf_unittest::TestOneof2;
+using protobuf_unittest::TestParsingMerge;
 using protobuf_unittest::TestRepeatedString;
 
 namespace google {
@@ -831,6 +834,64 @@ TEST(ArenaTest, RepeatedPtrFieldAddClearedTest) {
   }
 }
 
+TEST(ArenaTest, RepeatedPtrFieldAddN) {
+  Arena arena;
+  auto* field = Arena::CreateMessage<RepeatedPtrField<TestAllTypes>>(&arena);
+  field->Add()->set_optional_int32(1);
+  field->RemoveLast();
+
+  field->AddN(5);
+  ASSERT_EQ(field->size(), 5);
+  EXPECT_EQ(field->ClearedCount(), 0);
+  for (const TestAllTypes& message : *field) {
+    EXPECT_EQ(message.GetArena(), &arena);
+    EXPECT_EQ(message.ByteSizeLong(), 0);
+  }
+  // The cleared element is reused, and the other four are constructed next to
+  // each other.
+  for (int i = 2; i < 5; ++i) {
+    EXPECT_EQ(&field->Get(i), &field->Get(i - 1) + 1);
+  }
+
+  field->AddN(0);
+  EXPECT_EQ(field->size(), 5);
+
+  // Types that need their destructor run are created one by one.
+  auto* strings = Arena::CreateMessage<RepeatedPtrField<std::string>>(&arena);
+  strings->AddN(3);
+  ASSERT_EQ(strings->size(), 3);
+  strings->Mutable(2)->assign(100, 'x');
+}
+
+TEST(ArenaTest, ParseAllocatesRepeatedMessagesTogether) {
+  TestParsingMerge::RepeatedFieldsGenerator generator;
+  for (int i = 0; i < 10; ++i) {
+    generator.add_field1()->set_optional_string(std::string(100, 'a' + i));
+  }
+  const std::string data = generator.SerializeAsString();
+
+  // Large enough for the whole message, so that no block boundary separates
+  // the elements.
+  std::vector<char> block(64 * 1024);
+  Arena arena(block.data(), block.size());
+  auto* parsed =
+      Arena::CreateMessage<TestParsingMerge::RepeatedFieldsGenerator>(&arena);
+  ASSERT_TRUE(parsed->ParseFromString(data));
+  ASSERT_EQ(parsed->field1_size(), 10);
+  // The elements were all allocated before the strings they hold.
+  const char* first = reinterpret_cast<const char*>(&parsed->field1(0));
+  const size_t stride =
+      reinterpret_cast<const char*>(&parsed->field1(1)) - first;
+  EXPECT_GE(stride, sizeof(TestAllTypes));
+  EXPECT_LT(stride, sizeof(TestAllTypes) + 100);
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(reinterpret_cast<const char*>(&parsed->field1(i)),
+              first + i * stride);
+    EXPECT_EQ(parsed->field1(i).optional_string(), std::string(100, 'a' + i));
+  }
+  EXPECT_EQ(parsed->field1().ClearedCount(), 0);
+}
+
 TEST(ArenaTest, AddAllocatedToRepeatedField) {
   // Heap->arena case.
   Arena arena1;
@@ -1487,6 +1548,221 @@ TEST(ArenaTest, BlockSizeSmallerThanAllocation) {
   }
 }
 
+namespace {
+
+// Fills an arena using `pool` with a few dozen blocks and returns how much it
+// allocated.
+uint64_t UsePooledArena(ArenaBlockPool* pool) {
+  ArenaOptions options;
+  options.block_pool = pool;
+  Arena arena(options);
+  for (int i = 0; i < 100; ++i) Arena::CreateArray<char>(&arena, 1000);
+  return arena.SpaceAllocated();
+}
+
+}  // namespace
+
+TEST(ArenaTest, BlockPoolReusesBlocks) {
+  ArenaBlockPool pool;
+  const uint64_t space_allocated = UsePooledArena(&pool);
+  ArenaBlockPool::Stats stats = pool.GetStats();
+  const uint64_t num_blocks = stats.misses;
+  EXPECT_GT(num_blocks, 1);
+  EXPECT_EQ(stats.hits, 0);
+  EXPECT_EQ(stats.retained_bytes, space_allocated);
+
+  EXPECT_EQ(UsePooledArena(&pool), space_allocated);
+  stats = pool.GetStats();
+  EXPECT_EQ(stats.hits, num_blocks);
+  EXPECT_EQ(stats.misses, num_blocks);
+  EXPECT_EQ(stats.retained_bytes, space_allocated);
+  EXPECT_DOUBLE_EQ(stats.hit_rate(), 0.5);
+
+  pool.Trim();
+  EXPECT_EQ(pool.GetStats().retained_bytes, 0);
+}
+
+TEST(ArenaTest, BlockPoolRetainsAtMostMaxRetainedBytes) {
+  ArenaBlockPool::Options pool_options;
+  pool_options.max_retained_bytes = 4096;
+  ArenaBlockPool pool(pool_options);
+  UsePooledArena(&pool);
+  EXPECT_GT(pool.GetStats().retained_bytes, 0);
+  EXPECT_LE(pool.GetStats().retained_bytes, 4096);
+}
+
+TEST(ArenaTest, BlockPoolSkipsLargeBlocks) {
+  ArenaBlockPool::Options pool_options;
+  pool_options.max_block_size = 8192;
+  ArenaBlockPool pool(pool_options);
+  ArenaOptions options;
+  options.block_pool = &pool;
+  {
+    Arena arena(options);
+    Arena::CreateArray<char>(&arena, 100000);
+  }
+  ArenaBlockPool::Stats stats = pool.GetStats();
+  EXPECT_GT(stats.retained_bytes, 0);
+  EXPECT_LE(stats.retained_bytes, 8192);
+}
+
+TEST(ArenaTest, BlockPoolWithConcurrentArenas) {
+  ArenaBlockPool pool;
+  ArenaOptions options;
+  options.block_pool = &pool;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&] {
+      for (int j = 0; j < 100; ++j) {
+        Arena arena(options);
+        TestUtil::SetAllFields(Arena::CreateMessage<TestAllTypes>(&arena));
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  ArenaBlockPool::Stats stats = pool.GetStats();
+  EXPECT_GT(stats.hits, stats.misses);
+}
+
+TEST(ArenaTest, HugePageBlocks) {
+  TestAllTypes original;
+  TestUtil::SetAllFields(&original);
+  for (int i = 0; i < 10000; ++i) {
+    original.add_repeated_string(std::string(1000, 'a' + i % 26));
+  }
+  const std::string data = original.SerializeAsString();
+
+  ArenaOptions options;
+  options.use_huge_pages = true;
+  Arena arena(options);
+  TestAllTypes* message = Arena::CreateMessage<TestAllTypes>(&arena);
+  ASSERT_TRUE(message->ParseFromString(data));
+  EXPECT_EQ(message->SerializeAsString(), data);
+  // Large single allocations get a block of their own.
+  char* array = Arena::CreateArray<char>(&arena, 5 << 20);
+  memset(array, 0, 5 << 20);
+  EXPECT_GE(arena.SpaceAllocated(), 5 << 20);
+
+  // The policy applies to blocks of every thread.
+  std::thread thread([&] {
+    Arena::CreateMessage<TestAllTypes>(&arena)->ParseFromString(data);
+  });
+  thread.join();
+  // Reset() unmaps all but the first block.
+  arena.Reset();
+  EXPECT_LT(arena.SpaceAllocated(), 4096);
+}
+
+TEST(ArenaTest, RewindToReusesMemory) {
+  Arena arena;
+  Arena::CreateArray<char>(&arena, 100);
+  const uint64_t space_used = arena.SpaceUsed();
+  ArenaCheckpoint checkpoint = arena.Checkpoint();
+  char* first = Arena::CreateArray<char>(&arena, 100);
+  for (int i = 0; i < 100; ++i) Arena::CreateArray<char>(&arena, 1000);
+  EXPECT_GT(arena.SpaceUsed(), space_used + 100000);
+
+  arena.RewindTo(checkpoint);
+  EXPECT_EQ(arena.SpaceUsed(), space_used);
+  EXPECT_EQ(Arena::CreateArray<char>(&arena, 100), first);
+}
+
+TEST(ArenaTest, RewindToRunsDestructorsRegisteredAfterCheckpoint) {
+  Notifier notifier;
+  {
+    Arena arena;
+    Arena::Create<SimpleDataType>(&arena)->SetNotifier(&notifier);
+    ArenaCheckpoint checkpoint = arena.Checkpoint();
+    for (int i = 0; i < 1000; ++i) {
+      Arena::Create<SimpleDataType>(&arena)->SetNotifier(&notifier);
+      Arena::Create<std::string>(&arena, 100, 'x');
+    }
+    arena.RewindTo(checkpoint);
+    EXPECT_EQ(notifier.GetCount(), 1000);
+    // Rewinding again with nothing allocated since is a no-op.
+    arena.RewindTo(checkpoint);
+    EXPECT_EQ(notifier.GetCount(), 1000);
+  }
+  EXPECT_EQ(notifier.GetCount(), 1001);
+}
+
+TEST(ArenaTest, RewindToDiscardsGrowthOfOlderObjects) {
+  // Everything fits in the initial block, so allocations after the rewind
+  // start where the checkpoint was taken.
+  std::vector<char> buffer(1 << 16);
+  Arena arena(buffer.data(), buffer.size());
+  auto* reserved = Arena::CreateMessage<TestAllTypes>(&arena);
+  reserved->mutable_repeated_int32()->Reserve(100);
+  auto* unreserved = Arena::CreateMessage<TestAllTypes>(&arena);
+  ArenaCheckpoint checkpoint = arena.Checkpoint();
+  for (int i = 0; i < 100; ++i) {
+    reserved->add_repeated_int32(i);
+    unreserved->add_repeated_int32(i);
+  }
+  const char* unreserved_data =
+      reinterpret_cast<const char*>(unreserved->repeated_int32().data());
+  arena.RewindTo(checkpoint);
+
+  // The buffer `unreserved` grew into after the checkpoint is handed out
+  // again, so `unreserved` must not be used any more; the arena does not run
+  // message destructors. `reserved` allocated nothing after the checkpoint
+  // and is still valid.
+  const size_t size = 8192;
+  char* reused = Arena::CreateArray<char>(&arena, size);
+  EXPECT_GE(unreserved_data, reused);
+  EXPECT_LT(unreserved_data, reused + size);
+  memset(reused, 0xff, size);
+  ASSERT_EQ(reserved->repeated_int32_size(), 100);
+  for (int i = 0; i < 100; ++i) EXPECT_EQ(reserved->repeated_int32(i), i);
+}
+
+TEST(ArenaTest, RewindToKeepsBlocksForReuse) {
+  Arena arena;
+  ArenaCheckpoint checkpoint = arena.Checkpoint();
+  uint64_t space_allocated = 0;
+  for (int i = 0; i < 10; ++i) {
+    for (int j = 0; j < 100; ++j) {
+      TestAllTypes* message = Arena::CreateMessage<TestAllTypes>(&arena);
+      TestUtil::SetAllFields(message);
+      TestUtil::ExpectAllFieldsSet(*message);
+    }
+    arena.RewindTo(checkpoint);
+    if (i == 0) space_allocated = arena.SpaceAllocated();
+    EXPECT_EQ(arena.SpaceAllocated(), space_allocated);
+  }
+}
+
+TEST(ArenaTest, RewindToWithInitialBlock) {
+  char buffer[1024];
+  Arena arena(buffer, sizeof(buffer));
+  ArenaCheckpoint checkpoint = arena.Checkpoint();
+  char* first = Arena::CreateArray<char>(&arena, 8);
+  EXPECT_TRUE(first >= buffer && first < buffer + sizeof(buffer));
+  for (int i = 0; i < 10; ++i) Arena::CreateArray<char>(&arena, 1000);
+  arena.RewindTo(checkpoint);
+  EXPECT_EQ(Arena::CreateArray<char>(&arena, 8), first);
+}
+
+TEST(ArenaTest, RewindToWithBlockPool) {
+  ArenaBlockPool pool;
+  ArenaOptions options;
+  options.block_pool = &pool;
+  uint64_t space_allocated;
+  {
+    Arena arena(options);
+    ArenaCheckpoint checkpoint = arena.Checkpoint();
+    for (int i = 0; i < 10; ++i) {
+      for (int j = 0; j < 100; ++j) Arena::CreateArray<char>(&arena, 1000);
+      arena.RewindTo(checkpoint);
+    }
+    // Blocks kept by RewindTo() are reused without going through the pool.
+    EXPECT_EQ(pool.GetStats().hits, 0);
+    space_allocated = arena.SpaceAllocated();
+  }
+  // Kept blocks go back to the pool with the others.
+  EXPECT_EQ(pool.GetStats().retained_bytes, space_allocated);
+}
+
 TEST(ArenaTest, GetArenaShouldReturnTheArenaForArenaAllocatedMessages) {
   Arena arena;
   ArenaMessage* message = Arena::CreateMessage<ArenaMessage>(&arena);
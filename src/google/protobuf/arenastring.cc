@@ -67,6 +67,14 @@ constexpr size_t kStringAlign = alignof(std::string);
 static_assert((kStringAlign > kNewAlign ? kStringAlign : kNewAlign) >= 4, "");
 static_assert(alignof(ExplicitlyConstructedArenaString) >= 4, "");
 
+// MSVC's checked iterators make std::string allocate a heap "proxy" object
+// even for inlined values, so its strings are never safe to leak.
+#if defined(_ITERATOR_DEBUG_LEVEL) && _ITERATOR_DEBUG_LEVEL > 0
+constexpr bool kEnableFixedSizeArenaStrings = false;
+#else
+constexpr bool kEnableFixedSizeArenaStrings = true;
+#endif
+
 }  // namespace
 
 const std::string& LazyString::Init() const {
@@ -102,11 +110,43 @@ inline TaggedStringPtr CreateString(absl::string_view value) {
   return res;
 }
 
+// Returns true if `s` keeps its contents inside its own footprint, i.e. it is
+// using the small string optimization. Such a string owns no memory besides
+// the std::string instance itself, so destroying it is a no-op.
+inline bool IsInlinedString(const std::string& s) {
+  const char* begin = reinterpret_cast<const char*>(&s);
+  return s.data() >= begin && s.data() < begin + sizeof(std::string);
+}
+
+// Returns the longest value std::string keeps inline, e.g. 15 for libstdc++
+// and 22 for libc++. This is smaller than sizeof(std::string), and by how much
+// depends on the library, so it is read from an empty string once.
+inline size_t InlinedStringCapacity() {
+  static const size_t capacity = std::string().capacity();
+  return capacity;
+}
+
 #ifndef GOOGLE_PROTOBUF_INTERNAL_DONATE_STEAL
 
 // Creates an arena allocated std::string value.
+//
+// Values short enough for the small string optimization are created as fixed
+// size arena strings: they carry no heap buffer, so they need no cleanup node
+// and cost nothing at arena destruction or reset. Longer values get a regular
+// mutable arena string whose destructor is registered with the arena.
 TaggedStringPtr CreateArenaString(Arena& arena, absl::string_view s) {
   TaggedStringPtr res;
+  if (kEnableFixedSizeArenaStrings && s.length() <= InlinedStringCapacity()) {
+    void* mem = arena.AllocateAligned(sizeof(std::string), alignof(std::string));
+    std::string* str = ::new (mem) std::string(s.data(), s.length());
+    if (PROTOBUF_PREDICT_TRUE(IsInlinedString(*str))) {
+      res.SetFixedSizeArena(str);
+    } else {
+      arena.OwnDestructor(str);
+      res.SetMutableArena(str);
+    }
+    return res;
+  }
   res.SetMutableArena(Arena::Create<std::string>(&arena, s.data(), s.length()));
   return res;
 }
@@ -129,12 +169,17 @@ void ArenaStringPtr::Set(absl::string_view value, Arena* arena) {
       tagged_ptr_ = CreateString(value);
       delete old;
     } else {
-      auto* old = UnsafeMutablePointer();
+      auto* old = IsFixedSizeArena() ? MutableFixedSizeArena(arena)
+                                     : UnsafeMutablePointer();
       tagged_ptr_ = CreateArenaString(*arena, value);
       old->assign("garbagedata");
     }
 #else   // PROTOBUF_FORCE_COPY_DEFAULT_STRING
-    UnsafeMutablePointer()->assign(value.data(), value.length());
+    if (IsFixedSizeArena()) {
+      AssignFixedSizeArena(value, arena);
+    } else {
+      UnsafeMutablePointer()->assign(value.data(), value.length());
+    }
 #endif  // PROTOBUF_FORCE_COPY_DEFAULT_STRING
   }
 }
@@ -154,12 +199,17 @@ void ArenaStringPtr::Set(const std::string& value, Arena* arena) {
       tagged_ptr_ = CreateString(value);
       delete old;
     } else {
-      auto* old = UnsafeMutablePointer();
+      auto* old = IsFixedSizeArena() ? MutableFixedSizeArena(arena)
+                                     : UnsafeMutablePointer();
       tagged_ptr_ = CreateArenaString(*arena, value);
       old->assign("garbagedata");
     }
 #else   // PROTOBUF_FORCE_COPY_DEFAULT_STRING
-    UnsafeMutablePointer()->assign(value);
+    if (IsFixedSizeArena()) {
+      AssignFixedSizeArena(value, arena);
+    } else {
+      UnsafeMutablePointer()->assign(value);
+    }
 #endif  // PROTOBUF_FORCE_COPY_DEFAULT_STRING
   }
 }
@@ -201,6 +251,10 @@ std::string* ArenaStringPtr::MutableNoCopy(Arena* arena) {
   ScopedCheckPtrInvariants check(&tagged_ptr_);
   if (tagged_ptr_.IsMutable()) {
     return tagged_ptr_.Get();
+  } else if (IsFixedSizeArena()) {
+    std::string* s = MutableFixedSizeArena(arena);
+    s->clear();
+    return s;
   } else {
     GOOGLE_ABSL_DCHECK(IsDefault());
     // Allocate empty. The contents are not relevant.
@@ -208,9 +262,29 @@ std::string* ArenaStringPtr::MutableNoCopy(Arena* arena) {
   }
 }
 
+std::string* ArenaStringPtr::MutableFixedSizeArena(Arena* arena) {
+  GOOGLE_ABSL_DCHECK(IsFixedSizeArena());
+  GOOGLE_ABSL_DCHECK(arena != nullptr);
+  // The caller may grow the string beyond its inline capacity, after which it
+  // owns a heap buffer and must be destroyed along with the arena.
+  std::string* s = tagged_ptr_.Get();
+  arena->OwnDestructor(s);
+  return tagged_ptr_.SetMutableArena(s);
+}
+
+void ArenaStringPtr::AssignFixedSizeArena(absl::string_view value,
+                                          Arena* arena) {
+  std::string* s = tagged_ptr_.Get();
+  // Assigning within the current (inline) capacity does not allocate, so the
+  // value can stay a fixed size arena string.
+  if (value.length() > s->capacity()) s = MutableFixedSizeArena(arena);
+  s->assign(value.data(), value.length());
+}
+
 template <typename... Lazy>
 std::string* ArenaStringPtr::MutableSlow(::google::protobuf::Arena* arena,
                                          const Lazy&... lazy_default) {
+  if (IsFixedSizeArena()) return MutableFixedSizeArena(arena);
   GOOGLE_ABSL_DCHECK(IsDefault());
 
   // For empty defaults, this ends up calling the default constructor which is
@@ -276,6 +350,8 @@ void ArenaStringPtr::ClearToDefault(const LazyString& default_value,
   (void)arena;
   if (IsDefault()) {
     // Already set to default -- do nothing.
+  } else if (IsFixedSizeArena()) {
+    AssignFixedSizeArena(default_value.get(), arena);
   } else {
     UnsafeMutablePointer()->assign(default_value.get());
   }
@@ -290,6 +366,14 @@ const char* EpsCopyInputStream::ReadArenaString(const char* ptr,
   int size = ReadSize(&ptr);
   if (!ptr) return nullptr;
 
+  // Short values available in the buffer become fixed size arena strings,
+  // which spares them the arena cleanup node.
+  if (static_cast<size_t>(size) <= InlinedStringCapacity() &&
+      size <= buffer_end_ + kSlopBytes - ptr) {
+    s->tagged_ptr_ = CreateArenaString(*arena, absl::string_view(ptr, size));
+    return ptr + size;
+  }
+
   auto* str = s->NewString(arena);
   ptr = ReadString(ptr, size, str);
   GOOGLE_PROTOBUF_PARSER_ASSERT(ptr);
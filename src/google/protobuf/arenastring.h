@@ -125,8 +125,14 @@ class TaggedStringPtr {
     // size arena strings are immutable, with the exception of custom internal
     // updates to the content that fit inside the existing capacity.
     // Fixed size arena strings must never be deleted or destroyed.
+    // ArenaStringPtr uses them for values that fit the small string buffer of
+    // the std::string instance, which then needs no arena cleanup node.
     kFixedSizeArena = kArenaBit,
   };
+  // Note that there is no type for strings aliasing the parsed input: all tag
+  // combinations are taken, and accessors hand out `const std::string&`, which
+  // always owns its contents. Parses with aliasing enabled therefore still copy
+  // string fields.
 
   TaggedStringPtr() = default;
   explicit constexpr TaggedStringPtr(ExplicitlyConstructedArenaString* ptr)
@@ -370,7 +376,15 @@ struct PROTOBUF_EXPORT ArenaStringPtr {
 
   TaggedStringPtr tagged_ptr_;
 
-  bool IsFixedSizeArena() const { return false; }
+  bool IsFixedSizeArena() const { return tagged_ptr_.IsFixedSizeArena(); }
+
+  // Turns the current fixed size arena string into a mutable arena string by
+  // registering its destructor with `arena`, and returns it.
+  std::string* MutableFixedSizeArena(Arena* arena);
+
+  // Assigns `value` to the current fixed size arena string, keeping it fixed
+  // size if `value` fits its inline capacity.
+  void AssignFixedSizeArena(absl::string_view value, Arena* arena);
 
   // Swaps tagged pointer without debug hardening. This is to allow python
   // protobuf to maintain pointer stability even in DEBUG builds.
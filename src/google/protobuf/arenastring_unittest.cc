@@ -110,6 +110,89 @@ TEST_P(SingleArena, NullDefault) {
   field.Destroy();
 }
 
+TEST_P(SingleArena, ShortValueGrowsThroughMutable) {
+  auto arena = GetArena();
+  ArenaStringPtr field;
+  field.InitDefault();
+  field.Set("short", arena.get());
+  EXPECT_EQ("short", field.Get());
+
+  // Growing a short value past its inline capacity must not leak the buffer.
+  std::string* mut = field.Mutable(arena.get());
+  EXPECT_EQ(mut, &field.Get());
+  EXPECT_EQ("short", *mut);
+  mut->append(" grown into a long long long long value");
+  EXPECT_EQ("short grown into a long long long long value", field.Get());
+  field.Destroy();
+}
+
+TEST_P(SingleArena, ValuesAroundInlineCapacity) {
+  auto arena = GetArena();
+  const size_t capacity = std::string().capacity();
+  for (size_t length : {capacity - 1, capacity, capacity + 1,
+                        sizeof(std::string) - 1, sizeof(std::string)}) {
+    const std::string value(length, 'x');
+    ArenaStringPtr field;
+    field.InitDefault();
+    field.Set(value, arena.get());
+    EXPECT_EQ(value, field.Get());
+    field.Mutable(arena.get())->append("y");
+    EXPECT_EQ(value + "y", field.Get());
+    field.Destroy();
+  }
+}
+
+TEST_P(SingleArena, ShortValueOverwritten) {
+  auto arena = GetArena();
+  ArenaStringPtr field;
+  field.InitDefault();
+  field.Set("short", arena.get());
+  field.Set("tiny", arena.get());
+  EXPECT_EQ("tiny", field.Get());
+  field.Set("Test long long long long value", arena.get());
+  EXPECT_EQ("Test long long long long value", field.Get());
+  field.Set("short", arena.get());
+  EXPECT_EQ("short", field.Get());
+  field.Set(std::string("Moved long long long long value"), arena.get());
+  EXPECT_EQ("Moved long long long long value", field.Get());
+  field.Destroy();
+}
+
+TEST_P(SingleArena, ShortValueMutableNoCopy) {
+  auto arena = GetArena();
+  ArenaStringPtr field;
+  field.InitDefault();
+  field.Set("short", arena.get());
+  std::string* mut = field.MutableNoCopy(arena.get());
+  EXPECT_EQ(mut, &field.Get());
+  *mut = "Test long long long long value";
+  EXPECT_EQ("Test long long long long value", field.Get());
+  field.Destroy();
+}
+
+TEST_P(SingleArena, ShortValueClearToDefault) {
+  auto arena = GetArena();
+  ArenaStringPtr field;
+  field.InitDefault();
+  field.Set("short", arena.get());
+  field.ClearToDefault(nonempty_default, arena.get());
+  EXPECT_EQ("default", field.Get());
+  field.ClearToEmpty();
+  EXPECT_EQ("", field.Get());
+  field.Destroy();
+}
+
+TEST_P(SingleArena, ShortValueRelease) {
+  auto arena = GetArena();
+  ArenaStringPtr field;
+  field.InitDefault();
+  field.Set("short", arena.get());
+  std::unique_ptr<std::string> released(field.Release());
+  EXPECT_EQ("short", *released);
+  EXPECT_TRUE(field.IsDefault());
+  field.Destroy();
+}
+
 class DualArena : public testing::TestWithParam<std::tuple<bool, bool>> {
  public:
   std::unique_ptr<Arena> GetLhsArena() {
@@ -0,0 +1,281 @@
+// Protocol Buffers - Google's data interchange format
+// Copyright 2008 Google Inc.  All rights reserved.
+// https://developers.google.com/protocol-buffers/
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "google/protobuf/arenaz_profile.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/debugging/symbolize.h"
+#include "absl/strings/string_view.h"
+#include "google/protobuf/arenaz_sampler.h"
+#include "google/protobuf/io/coded_stream.h"
+#include "google/protobuf/io/zero_copy_stream_impl_lite.h"
+#include "google/protobuf/wire_format_lite.h"
+
+// Must be included last.
+#include "google/protobuf/port_def.inc"
+
+namespace google {
+namespace protobuf {
+namespace {
+
+using internal::WireFormatLite;
+
+// Field numbers from profile.proto.
+enum ProfileField {
+  kProfileSampleType = 1,
+  kProfileSample = 2,
+  kProfileLocation = 4,
+  kProfileFunction = 5,
+  kProfileStringTable = 6,
+  kProfileDropFrames = 7,
+  kProfilePeriodType = 11,
+  kProfilePeriod = 12,
+  kProfileDefaultSampleType = 14,
+};
+enum ValueTypeField { kValueTypeType = 1, kValueTypeUnit = 2 };
+enum SampleField { kSampleLocationId = 1, kSampleValue = 2, kSampleLabel = 3 };
+enum LabelField { kLabelKey = 1, kLabelNum = 3, kLabelNumUnit = 4 };
+enum LocationField { kLocationId = 1, kLocationAddress = 3, kLocationLine = 4 };
+enum LineField { kLineFunctionId = 1 };
+enum FunctionField {
+  kFunctionId = 1,
+  kFunctionName = 2,
+  kFunctionSystemName = 3,
+};
+
+// Frames matching this are dropped by pprof along with their callees. The
+// creation stack is captured inside the sampler, which runs from
+// ThreadSafeArena's constructor.
+constexpr absl::string_view kDropFrames =
+    ".*google::protobuf::internal::ThreadSafeArena::.*";
+
+// Writes the fields of one embedded message to a string, so that it can be
+// written length-delimited into its parent.
+class MessageWriter {
+ public:
+  MessageWriter() : stream_(&buffer_), out_(&stream_) {}
+
+  io::CodedOutputStream* out() { return &out_; }
+
+  void WriteInt64(int field, int64_t value) {
+    if (value != 0) WireFormatLite::WriteInt64(field, value, &out_);
+  }
+  void WriteUInt64(int field, uint64_t value) {
+    if (value != 0) WireFormatLite::WriteUInt64(field, value, &out_);
+  }
+  // Writes a packed repeated int64 or uint64 field; both use plain varints.
+  void WritePackedVarints(int field, const std::vector<uint64_t>& values) {
+    MessageWriter packed;
+    for (uint64_t value : values) packed.out()->WriteVarint64(value);
+    WireFormatLite::WriteBytes(field, packed.Finish(), &out_);
+  }
+  void WriteMessage(int field, MessageWriter& message) {
+    WireFormatLite::WriteBytes(field, message.Finish(), &out_);
+  }
+
+  const std::string& Finish() {
+    out_.Trim();
+    return buffer_;
+  }
+
+ private:
+  std::string buffer_;
+  io::StringOutputStream stream_;
+  io::CodedOutputStream out_;
+};
+
+class ProfileBuilder {
+ public:
+  ProfileBuilder() { StringId(""); }
+
+  int64_t StringId(absl::string_view s) {
+    auto it = strings_.find(s);
+    if (it != strings_.end()) return it->second;
+    string_table_.emplace_back(s);
+    int64_t id = static_cast<int64_t>(string_table_.size() - 1);
+    strings_.emplace(string_table_.back(), id);
+    return id;
+  }
+
+  void AddSampleType(absl::string_view type, absl::string_view unit) {
+    MessageWriter value_type;
+    value_type.WriteInt64(kValueTypeType, StringId(type));
+    value_type.WriteInt64(kValueTypeUnit, StringId(unit));
+    profile_.WriteMessage(kProfileSampleType, value_type);
+  }
+
+  void AddSample(const ArenazSample& sample) {
+    MessageWriter message;
+    std::vector<uint64_t> location_ids;
+    location_ids.reserve(sample.stack.size());
+    for (void* pc : sample.stack) location_ids.push_back(LocationId(pc));
+    message.WritePackedVarints(kSampleLocationId, location_ids);
+    message.WritePackedVarints(
+        kSampleValue, {static_cast<uint64_t>(sample.num_blocks),
+                       static_cast<uint64_t>(sample.bytes_allocated),
+                       static_cast<uint64_t>(sample.bytes_used),
+                       static_cast<uint64_t>(sample.bytes_wasted)});
+
+    MessageWriter label;
+    label.WriteInt64(kLabelKey, StringId("block_size"));
+    label.WriteInt64(kLabelNum, static_cast<int64_t>(sample.max_block_size));
+    label.WriteInt64(kLabelNumUnit, StringId("bytes"));
+    message.WriteMessage(kSampleLabel, label);
+    profile_.WriteMessage(kProfileSample, message);
+  }
+
+  std::string Finish() {
+    profile_.WriteInt64(kProfileDropFrames, StringId(kDropFrames));
+    MessageWriter period_type;
+    period_type.WriteInt64(kValueTypeType, StringId("arenas"));
+    period_type.WriteInt64(kValueTypeUnit, StringId("count"));
+    profile_.WriteMessage(kProfilePeriodType, period_type);
+    profile_.WriteInt64(kProfilePeriod,
+                        internal::ThreadSafeArenazSampleParameter());
+    profile_.WriteInt64(kProfileDefaultSampleType, StringId("allocated_space"));
+    for (const std::string& s : string_table_) {
+      WireFormatLite::WriteString(kProfileStringTable, s, profile_.out());
+    }
+    return profile_.Finish();
+  }
+
+ private:
+  uint64_t LocationId(void* pc) {
+    auto it = locations_.find(pc);
+    if (it != locations_.end()) return it->second;
+    const uint64_t id = locations_.size() + 1;
+    locations_.emplace(pc, id);
+
+    MessageWriter location;
+    location.WriteUInt64(kLocationId, id);
+    location.WriteUInt64(kLocationAddress, reinterpret_cast<uintptr_t>(pc));
+    // Return addresses point past the call; look up the call itself.
+    char name[1024];
+    if (absl::Symbolize(static_cast<char*>(pc) - 1, name, sizeof(name))) {
+      MessageWriter line;
+      line.WriteUInt64(kLineFunctionId, FunctionId(name));
+      location.WriteMessage(kLocationLine, line);
+    }
+    profile_.WriteMessage(kProfileLocation, location);
+    return id;
+  }
+
+  uint64_t FunctionId(absl::string_view name) {
+    auto it = functions_.find(name);
+    if (it != functions_.end()) return it->second;
+    const uint64_t id = functions_.size() + 1;
+    const int64_t name_id = StringId(name);
+    functions_.emplace(string_table_[name_id], id);
+
+    MessageWriter function;
+    function.WriteUInt64(kFunctionId, id);
+    function.WriteInt64(kFunctionName, name_id);
+    function.WriteInt64(kFunctionSystemName, name_id);
+    profile_.WriteMessage(kProfileFunction, function);
+    return id;
+  }
+
+  MessageWriter profile_;
+  std::vector<std::string> string_table_;
+  absl::flat_hash_map<std::string, int64_t> strings_;
+  absl::flat_hash_map<void*, uint64_t> locations_;
+  absl::flat_hash_map<std::string, uint64_t> functions_;
+};
+
+}  // namespace
+
+std::vector<ArenazSample> SnapshotArenazSamples() {
+  std::vector<ArenazSample> samples;
+#if defined(PROTOBUF_ARENAZ_SAMPLE)
+  using internal::ThreadSafeArenaStats;
+  absl::flat_hash_map<std::pair<std::vector<void*>, size_t>, size_t> index;
+  internal::GlobalThreadSafeArenazSampler().Iterate(
+      [&](const ThreadSafeArenaStats& info) {
+        std::vector<void*> stack(info.stack, info.stack + info.depth);
+        for (size_t bin = 0; bin < ThreadSafeArenaStats::kBlockHistogramBins;
+             ++bin) {
+          const ThreadSafeArenaStats::BlockStats& block_stats =
+              info.block_histogram[bin];
+          const int64_t num_blocks =
+              block_stats.num_allocations.load(std::memory_order_relaxed);
+          const int64_t allocated =
+              block_stats.bytes_allocated.load(std::memory_order_relaxed);
+          const int64_t used =
+              block_stats.bytes_used.load(std::memory_order_relaxed);
+          const int64_t wasted =
+              block_stats.bytes_wasted.load(std::memory_order_relaxed);
+          if (num_blocks == 0 && allocated == 0 && used == 0 && wasted == 0) {
+            continue;
+          }
+          auto inserted = index.emplace(std::make_pair(stack, bin),
+                                        samples.size());
+          if (inserted.second) {
+            samples.emplace_back();
+            samples.back().stack = stack;
+            std::pair<size_t, size_t> range =
+                ThreadSafeArenaStats::MinMaxBlockSizeForBin(bin);
+            samples.back().min_block_size = range.first;
+            samples.back().max_block_size = range.second;
+          }
+          ArenazSample& sample = samples[inserted.first->second];
+          sample.num_blocks += num_blocks * info.weight;
+          sample.bytes_allocated += allocated * info.weight;
+          sample.bytes_used += used * info.weight;
+          sample.bytes_wasted += wasted * info.weight;
+        }
+      });
+#endif  // defined(PROTOBUF_ARENAZ_SAMPLE)
+  return samples;
+}
+
+std::string ArenazSamplesToPprof(const std::vector<ArenazSample>& samples) {
+  ProfileBuilder builder;
+  builder.AddSampleType("blocks", "count");
+  builder.AddSampleType("allocated_space", "bytes");
+  builder.AddSampleType("used_space", "bytes");
+  builder.AddSampleType("wasted_space", "bytes");
+  for (const ArenazSample& sample : samples) builder.AddSample(sample);
+  return builder.Finish();
+}
+
+std::string ExportArenazProfile() {
+  return ArenazSamplesToPprof(SnapshotArenazSamples());
+}
+
+}  // namespace protobuf
+}  // namespace google
+
+#include "google/protobuf/port_undef.inc"
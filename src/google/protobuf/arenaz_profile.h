@@ -0,0 +1,92 @@
+// Protocol Buffers - Google's data interchange format
+// Copyright 2008 Google Inc.  All rights reserved.
+// https://developers.google.com/protocol-buffers/
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Exports the statistics collected by the arenaz sampler (see
+// arenaz_sampler.h) from a running process.
+
+#ifndef GOOGLE_PROTOBUF_ARENAZ_PROFILE_H__
+#define GOOGLE_PROTOBUF_ARENAZ_PROFILE_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Must be included last.
+#include "google/protobuf/port_def.inc"
+
+namespace google {
+namespace protobuf {
+
+// Aggregated statistics of the blocks in one size range allocated by the
+// sampled arenas that were created with the same stack. All counts are scaled
+// by the sampling weight, so they estimate the totals over all arenas rather
+// than over the sampled ones.
+//
+// Used and wasted bytes are only known for blocks an arena has moved past, not
+// for the block each thread is currently allocating from.
+struct ArenazSample {
+  // Stack of return addresses of the arena's creation, innermost first.
+  std::vector<void*> stack;
+  // Range of the block sizes covered by this sample.
+  size_t min_block_size = 0;
+  size_t max_block_size = 0;
+
+  int64_t num_blocks = 0;
+  int64_t bytes_allocated = 0;
+  int64_t bytes_used = 0;
+  int64_t bytes_wasted = 0;
+};
+
+// Returns the statistics of all arenas currently tracked by the arenaz
+// sampler, aggregated by creation stack and block size. Returns an empty
+// vector if arena sampling is compiled out.
+PROTOBUF_EXPORT std::vector<ArenazSample> SnapshotArenazSamples();
+
+// Encodes `samples` as a pprof heap profile, i.e. a serialized
+// perftools.profiles.Profile (profile.proto), with the sample types
+// "blocks/count", "allocated_space/bytes" (the default), "used_space/bytes"
+// and "wasted_space/bytes". Each sample is labeled with "block_size", the
+// upper bound of its block size range. Stack frames are symbolized in process
+// where possible, and frames inside the arena implementation are dropped, so
+// `pprof -sample_index=wasted_space` ranks the call sites creating arenas by
+// the space they leave unused.
+PROTOBUF_EXPORT std::string ArenazSamplesToPprof(
+    const std::vector<ArenazSample>& samples);
+
+// Equivalent to ArenazSamplesToPprof(SnapshotArenazSamples()).
+PROTOBUF_EXPORT std::string ExportArenazProfile();
+
+}  // namespace protobuf
+}  // namespace google
+
+#include "google/protobuf/port_undef.inc"
+
+#endif  // GOOGLE_PROTOBUF_ARENAZ_PROFILE_H__
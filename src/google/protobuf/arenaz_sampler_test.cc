@@ -39,6 +39,10 @@
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include "google/protobuf/arena.h"
+#include "google/protobuf/arenaz_profile.h"
+#include "google/protobuf/io/coded_stream.h"
+#include "google/protobuf/unknown_field_set.h"
 
 
 // Must be included last.
@@ -587,8 +591,123 @@ TEST(ThreadSafeArenazSamplerTest, SampleFirstArena) {
   EXPECT_TRUE(sampled);
   EXPECT_TRUE(unsampled);
 }
+
+TEST(ArenazProfileTest, SnapshotAggregatesByStackAndBlockSize) {
+  SetThreadSafeArenazEnabled(true);
+  int32_t oldparam = ThreadSafeArenazSampleParameter();
+  SetThreadSafeArenazSampleParameter(1);
+  SetThreadSafeArenazGlobalNextSample(0);
+  std::vector<std::unique_ptr<google::protobuf::Arena>> arenas;
+  for (int i = 0; i < 10; ++i) {
+    arenas.push_back(std::make_unique<google::protobuf::Arena>());
+    for (int j = 0; j < 100; ++j) arenas.back()->AllocateAligned(1000);
+  }
+  int64_t bytes_allocated = 0;
+  int64_t bytes_wasted = 0;
+  for (const ArenazSample& sample : SnapshotArenazSamples()) {
+    EXPECT_FALSE(sample.stack.empty());
+    EXPECT_LE(sample.min_block_size, sample.max_block_size);
+    bytes_allocated += sample.bytes_allocated;
+    bytes_wasted += sample.bytes_wasted;
+  }
+  EXPECT_GT(bytes_allocated, 0);
+  EXPECT_GT(bytes_wasted, 0);
+  SetThreadSafeArenazSampleParameter(oldparam);
+}
 #endif  // defined(PROTOBUF_ARENAZ_SAMPLE)
 
+std::vector<uint64_t> ReadPackedVarints(const std::string& data) {
+  io::CodedInputStream input(reinterpret_cast<const uint8_t*>(data.data()),
+                             static_cast<int>(data.size()));
+  std::vector<uint64_t> values;
+  uint64_t value;
+  while (input.ReadVarint64(&value)) values.push_back(value);
+  return values;
+}
+
+const UnknownField* FindField(const UnknownFieldSet& fields, int number) {
+  for (int i = 0; i < fields.field_count(); ++i) {
+    if (fields.field(i).number() == number) return &fields.field(i);
+  }
+  return nullptr;
+}
+
+TEST(ArenazProfileTest, EncodesPprofProfile) {
+  ArenazSample sample;
+  // A return address right after the start of a known function.
+  void* pc =
+      reinterpret_cast<char*>(&google::protobuf::ArenazSamplesToPprof) + 1;
+  sample.stack = {pc, pc};
+  sample.min_block_size = 129;
+  sample.max_block_size = 256;
+  sample.num_blocks = 3;
+  sample.bytes_allocated = 768;
+  sample.bytes_used = 600;
+  sample.bytes_wasted = 168;
+
+  UnknownFieldSet profile;
+  ASSERT_TRUE(profile.ParseFromString(ArenazSamplesToPprof({sample, sample})));
+
+  std::vector<std::string> strings;
+  std::vector<std::string> samples;
+  int num_sample_types = 0;
+  int num_locations = 0;
+  int num_functions = 0;
+  for (int i = 0; i < profile.field_count(); ++i) {
+    const UnknownField& field = profile.field(i);
+    switch (field.number()) {
+      case 1:
+        ++num_sample_types;
+        break;
+      case 2:
+        samples.push_back(field.length_delimited());
+        break;
+      case 4:
+        ++num_locations;
+        break;
+      case 5:
+        ++num_functions;
+        break;
+      case 6:
+        strings.push_back(field.length_delimited());
+        break;
+    }
+  }
+  EXPECT_EQ(num_sample_types, 4);
+  EXPECT_EQ(samples.size(), 2);
+  // Both frames share a location.
+  EXPECT_EQ(num_locations, 1);
+  ASSERT_FALSE(strings.empty());
+  EXPECT_EQ(strings[0], "");
+  EXPECT_THAT(strings, testing::Contains("wasted_space"));
+  EXPECT_THAT(strings, testing::Contains("block_size"));
+  if (num_functions > 0) {
+    EXPECT_THAT(strings, testing::Contains(testing::HasSubstr(
+                             "ArenazSamplesToPprof")));
+  }
+
+  UnknownFieldSet first_sample;
+  ASSERT_TRUE(first_sample.ParseFromString(samples[0]));
+  const UnknownField* location_ids = FindField(first_sample, 1);
+  ASSERT_NE(location_ids, nullptr);
+  EXPECT_THAT(ReadPackedVarints(location_ids->length_delimited()),
+              testing::ElementsAre(1, 1));
+  const UnknownField* values = FindField(first_sample, 2);
+  ASSERT_NE(values, nullptr);
+  EXPECT_THAT(ReadPackedVarints(values->length_delimited()),
+              testing::ElementsAre(3, 768, 600, 168));
+}
+
+TEST(ArenazProfileTest, EmptyProfile) {
+  UnknownFieldSet profile;
+  ASSERT_TRUE(profile.ParseFromString(ArenazSamplesToPprof({})));
+  EXPECT_EQ(FindField(profile, 2), nullptr);
+  EXPECT_NE(FindField(profile, 1), nullptr);
+#if !defined(PROTOBUF_ARENAZ_SAMPLE)
+  EXPECT_TRUE(SnapshotArenazSamples().empty());
+#endif  // !defined(PROTOBUF_ARENAZ_SAMPLE)
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace protobuf
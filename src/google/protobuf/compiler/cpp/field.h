@@ -116,8 +116,16 @@ class FieldGeneratorBase {
   virtual void GenerateSerializeWithCachedSizesToArray(
       io::Printer* p) const = 0;
 
+  virtual void GenerateSerializeWithFlatSizesToArray(io::Printer* p) const {
+    GenerateSerializeWithCachedSizesToArray(p);
+  }
+
   virtual void GenerateByteSize(io::Printer* p) const = 0;
 
+  virtual void GenerateFlatByteSize(io::Printer* p) const {
+    GenerateByteSize(p);
+  }
+
   virtual void GenerateIsInitialized(io::Printer* p) const {}
 
   virtual void GenerateIfHasField(io::Printer* p) const;
@@ -344,6 +352,15 @@ class FieldGenerator {
     impl_->GenerateSerializeWithCachedSizesToArray(p);
   }
 
+  // Generates statements like GenerateSerializeWithCachedSizesToArray(), but
+  // for the message's _InternalSerializeFlatSized() method: sub-message sizes
+  // are taken from the stream, in the order GenerateFlatByteSize() recorded
+  // them.
+  void GenerateSerializeWithFlatSizesToArray(io::Printer* p) const {
+    auto vars = PushVarsForCall(p);
+    impl_->GenerateSerializeWithFlatSizesToArray(p);
+  }
+
   // Generates statements to compute the serialized size of this field, which
   // are placed in the message's ByteSize() method.
   void GenerateByteSize(io::Printer* p) const {
@@ -351,6 +368,16 @@ class FieldGenerator {
     impl_->GenerateByteSize(p);
   }
 
+  // Generates statements like GenerateByteSize(), but for the message's
+  // FlatByteSizeLong() method: sub-message sizes are recorded in `sizes`
+  // rather than in the sub-messages' cached sizes.  Fields that have no
+  // sub-messages of their own can rely on the default, which is identical to
+  // GenerateByteSize().
+  void GenerateFlatByteSize(io::Printer* p) const {
+    auto vars = PushVarsForCall(p);
+    impl_->GenerateFlatByteSize(p);
+  }
+
   // Generates lines to call IsInitialized() for eligible message fields. Non
   // message fields won't need to override this function.
   void GenerateIsInitialized(io::Printer* p) const {
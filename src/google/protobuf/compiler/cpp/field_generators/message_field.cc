@@ -118,7 +118,10 @@ class MessageFieldGenerator : public FieldGeneratorBase {
   void GenerateCopyConstructorCode(io::Printer* printer) const override;
   void GenerateSerializeWithCachedSizesToArray(
       io::Printer* printer) const override;
+  void GenerateSerializeWithFlatSizesToArray(
+      io::Printer* printer) const override;
   void GenerateByteSize(io::Printer* printer) const override;
+  void GenerateFlatByteSize(io::Printer* printer) const override;
   void GenerateIsInitialized(io::Printer* printer) const override;
   void GenerateConstexprAggregateInitializer(
       io::Printer* printer) const override;
@@ -166,7 +169,10 @@ class RepeatedMessageFieldGenerator : public FieldGeneratorBase {
   void GenerateDestructorCode(io::Printer* printer) const override;
   void GenerateSerializeWithCachedSizesToArray(
       io::Printer* printer) const override;
+  void GenerateSerializeWithFlatSizesToArray(
+      io::Printer* printer) const override;
   void GenerateByteSize(io::Printer* printer) const override;
+  void GenerateFlatByteSize(io::Printer* printer) const override;
   void GenerateIsInitialized(io::Printer* printer) const override;
 
  private:
@@ -577,6 +583,23 @@ void MessageFieldGenerator::GenerateSerializeWithCachedSizesToArray(
   }
 }
 
+void MessageFieldGenerator::GenerateSerializeWithFlatSizesToArray(
+    io::Printer* printer) const {
+  GOOGLE_ABSL_CHECK(!IsFieldStripped(descriptor_, options_));
+
+  // Groups and implicit weak fields are serialized with cached sizes.
+  if (descriptor_->type() != FieldDescriptor::TYPE_MESSAGE ||
+      implicit_weak_field_) {
+    GenerateSerializeWithCachedSizesToArray(printer);
+    return;
+  }
+  Formatter format(printer, variables_);
+  format(
+      "target = ::$proto_ns$::internal::WireFormatLite::\n"
+      "  InternalWriteMessageFlatSized($number$, _Internal::$name$(this),\n"
+      "    target, stream);\n");
+}
+
 void MessageFieldGenerator::GenerateByteSize(io::Printer* printer) const {
   GOOGLE_ABSL_CHECK(!IsFieldStripped(descriptor_, options_));
 
@@ -587,6 +610,22 @@ void MessageFieldGenerator::GenerateByteSize(io::Printer* printer) const {
       "    *$field$);\n");
 }
 
+void MessageFieldGenerator::GenerateFlatByteSize(io::Printer* printer) const {
+  GOOGLE_ABSL_CHECK(!IsFieldStripped(descriptor_, options_));
+
+  // Groups and implicit weak fields are serialized with cached sizes.
+  if (descriptor_->type() != FieldDescriptor::TYPE_MESSAGE ||
+      implicit_weak_field_) {
+    GenerateByteSize(printer);
+    return;
+  }
+  Formatter format(printer, variables_);
+  format(
+      "total_size += $tag_size$ +\n"
+      "  ::$proto_ns$::internal::WireFormatLite::MessageSize(\n"
+      "    _Internal::$name$(this), sizes);\n");
+}
+
 void MessageFieldGenerator::GenerateIsInitialized(io::Printer* printer) const {
   GOOGLE_ABSL_CHECK(!IsFieldStripped(descriptor_, options_));
 
@@ -1021,6 +1060,28 @@ void RepeatedMessageFieldGenerator::GenerateSerializeWithCachedSizesToArray(
   }
 }
 
+void RepeatedMessageFieldGenerator::GenerateSerializeWithFlatSizesToArray(
+    io::Printer* printer) const {
+  GOOGLE_ABSL_CHECK(!IsFieldStripped(descriptor_, options_));
+
+  // Groups and implicit weak fields are serialized with cached sizes.
+  if (descriptor_->type() != FieldDescriptor::TYPE_MESSAGE ||
+      implicit_weak_field_) {
+    GenerateSerializeWithCachedSizesToArray(printer);
+    return;
+  }
+  Formatter format(printer, variables_);
+  format(
+      "for (unsigned i = 0,\n"
+      "    n = static_cast<unsigned>(this->_internal_$name$_size());"
+      " i < n; i++) {\n"
+      "  const auto& repfield = this->_internal_$name$(i);\n"
+      "  target = ::$proto_ns$::internal::WireFormatLite::\n"
+      "      InternalWriteMessageFlatSized($number$, repfield, target, "
+      "stream);\n"
+      "}\n");
+}
+
 void RepeatedMessageFieldGenerator::GenerateByteSize(
     io::Printer* printer) const {
   GOOGLE_ABSL_CHECK(!IsFieldStripped(descriptor_, options_));
@@ -1034,6 +1095,27 @@ void RepeatedMessageFieldGenerator::GenerateByteSize(
       "}\n");
 }
 
+void RepeatedMessageFieldGenerator::GenerateFlatByteSize(
+    io::Printer* printer) const {
+  GOOGLE_ABSL_CHECK(!IsFieldStripped(descriptor_, options_));
+
+  // Groups and implicit weak fields are serialized with cached sizes.
+  if (descriptor_->type() != FieldDescriptor::TYPE_MESSAGE ||
+      implicit_weak_field_) {
+    GenerateByteSize(printer);
+    return;
+  }
+  Formatter format(printer, variables_);
+  format(
+      "total_size += $tag_size$UL * this->_internal_$name$_size();\n"
+      "for (unsigned i = 0,\n"
+      "    n = static_cast<unsigned>(this->_internal_$name$_size());"
+      " i < n; i++) {\n"
+      "  total_size += ::$proto_ns$::internal::WireFormatLite::MessageSize(\n"
+      "      this->_internal_$name$(i), sizes);\n"
+      "}\n");
+}
+
 void RepeatedMessageFieldGenerator::GenerateIsInitialized(
     io::Printer* printer) const {
   GOOGLE_ABSL_CHECK(!IsFieldStripped(descriptor_, options_));
@@ -1051,11 +1133,254 @@ void RepeatedMessageFieldGenerator::GenerateIsInitialized(
         "  return false;\n");
   }
 }
+
+// ===================================================================
+
+// A singular [lazy = true] message field, stored as an internal::LazyField
+// that keeps the field's serialized bytes until the message is accessed.
+class LazyMessageFieldGenerator : public FieldGeneratorBase {
+ public:
+  LazyMessageFieldGenerator(const FieldDescriptor* descriptor,
+                            const Options& options,
+                            MessageSCCAnalyzer* scc_analyzer);
+  ~LazyMessageFieldGenerator() override = default;
+
+  void GeneratePrivateMembers(io::Printer* printer) const override;
+  void GenerateAccessorDeclarations(io::Printer* printer) const override;
+  void GenerateInlineAccessorDefinitions(io::Printer* printer) const override;
+  void GenerateClearingCode(io::Printer* printer) const override;
+  void GenerateMergingCode(io::Printer* printer) const override;
+  void GenerateSwappingCode(io::Printer* printer) const override;
+  void GenerateDestructorCode(io::Printer* printer) const override;
+  void GenerateConstructorCode(io::Printer* printer) const override {}
+  void GenerateCopyConstructorCode(io::Printer* printer) const override;
+  void GenerateSerializeWithCachedSizesToArray(
+      io::Printer* printer) const override;
+  void GenerateByteSize(io::Printer* printer) const override;
+  void GenerateIsInitialized(io::Printer* printer) const override;
+  void GenerateConstexprAggregateInitializer(
+      io::Printer* printer) const override;
+  void GenerateAggregateInitializer(io::Printer* printer) const override;
+  void GenerateCopyAggregateInitializer(io::Printer* printer) const override;
+
+ private:
+  bool has_required_fields_;
+};
+
+LazyMessageFieldGenerator::LazyMessageFieldGenerator(
+    const FieldDescriptor* descriptor, const Options& options,
+    MessageSCCAnalyzer* scc_analyzer)
+    : FieldGeneratorBase(descriptor, options),
+      has_required_fields_(
+          !ShouldIgnoreRequiredFieldCheck(descriptor, options) &&
+          scc_analyzer->HasRequiredFields(descriptor->message_type())) {
+  SetMessageVariables(descriptor, options, /*implicit_weak=*/false,
+                      &variables_);
+}
+
+void LazyMessageFieldGenerator::GeneratePrivateMembers(
+    io::Printer* printer) const {
+  Formatter format(printer, variables_);
+  format("::$proto_ns$::internal::LazyField $name$_;\n");
+}
+
+void LazyMessageFieldGenerator::GenerateAccessorDeclarations(
+    io::Printer* printer) const {
+  Formatter format(printer, variables_);
+  format(
+      "$deprecated_attr$const $type$& ${1$$name$$}$() const;\n"
+      "PROTOBUF_NODISCARD $deprecated_attr$$type$* "
+      "${1$$release_name$$}$();\n"
+      "$deprecated_attr$$type$* ${1$mutable_$name$$}$();\n"
+      "$deprecated_attr$void ${1$set_allocated_$name$$}$"
+      "($type$* $name$);\n"
+      "private:\n"
+      "const $type$& ${1$_internal_$name$$}$() const;\n"
+      "$type$* ${1$_internal_mutable_$name$$}$();\n"
+      "public:\n"
+      "$deprecated_attr$void "
+      "${1$unsafe_arena_set_allocated_$name$$}$(\n"
+      "    $type$* $name$);\n"
+      "$deprecated_attr$$type$* ${1$unsafe_arena_release_$name$$}$();\n",
+      descriptor_);
+}
+
+void LazyMessageFieldGenerator::GenerateInlineAccessorDefinitions(
+    io::Printer* printer) const {
+  Formatter format(printer, variables_);
+  // The recorded bytes are parsed on the first call of any accessor below.
+  format(
+      "inline const $type$& $classname$::_internal_$name$() const {\n"
+      "  return static_cast<const $type$&>($field$.GetMessage(\n"
+      "      $type$::default_instance(), GetArenaForAllocation()));\n"
+      "}\n"
+      "inline const $type$& $classname$::$name$() const {\n"
+      "$annotate_get$"
+      "  // @@protoc_insertion_point(field_get:$full_name$)\n"
+      "  return _internal_$name$();\n"
+      "}\n"
+      "inline void $classname$::unsafe_arena_set_allocated_$name$(\n"
+      "    $type$* $name$) {\n"
+      "  $field$.UnsafeArenaSetAllocated($name$, GetArenaForAllocation());\n");
+  if (internal::cpp::HasHasbit(descriptor_)) {
+    format(
+        "  if ($name$) {\n"
+        "    $set_hasbit$\n"
+        "  } else {\n"
+        "    $clear_hasbit$\n"
+        "  }\n");
+  }
+  format(
+      "$annotate_set$"
+      "  // @@protoc_insertion_point(field_unsafe_arena_set_allocated"
+      ":$full_name$)\n"
+      "}\n"
+      "inline $type$* $classname$::$release_name$() {\n"
+      "$annotate_release$"
+      "  $clear_hasbit$\n"
+      "  $type$* temp = static_cast<$type$*>($field$.UnsafeArenaRelease(\n"
+      "      $type$::default_instance(), GetArenaForAllocation()));\n"
+      "#ifdef PROTOBUF_FORCE_COPY_IN_RELEASE\n"
+      "  auto* old =  reinterpret_cast<::$proto_ns$::MessageLite*>(temp);\n"
+      "  temp = ::$proto_ns$::internal::DuplicateIfNonNull(temp);\n"
+      "  if (GetArenaForAllocation() == nullptr) { delete old; }\n"
+      "#else  // PROTOBUF_FORCE_COPY_IN_RELEASE\n"
+      "  if (GetArenaForAllocation() != nullptr) {\n"
+      "    temp = ::$proto_ns$::internal::DuplicateIfNonNull(temp);\n"
+      "  }\n"
+      "#endif  // !PROTOBUF_FORCE_COPY_IN_RELEASE\n"
+      "  return temp;\n"
+      "}\n"
+      "inline $type$* $classname$::unsafe_arena_release_$name$() {\n"
+      "$annotate_release$"
+      "  // @@protoc_insertion_point(field_release:$full_name$)\n"
+      "  $clear_hasbit$\n"
+      "  return static_cast<$type$*>($field$.UnsafeArenaRelease(\n"
+      "      $type$::default_instance(), GetArenaForAllocation()));\n"
+      "}\n"
+      "inline $type$* $classname$::_internal_mutable_$name$() {\n"
+      "  $set_hasbit$\n"
+      "  return static_cast<$type$*>($field$.MutableMessage(\n"
+      "      $type$::default_instance(), GetArenaForAllocation()));\n"
+      "}\n"
+      "inline $type$* $classname$::mutable_$name$() {\n"
+      "  $type$* _msg = _internal_mutable_$name$();\n"
+      "$annotate_mutable$"
+      "  // @@protoc_insertion_point(field_mutable:$full_name$)\n"
+      "  return _msg;\n"
+      "}\n"
+      "inline void $classname$::set_allocated_$name$($type$* $name$) {\n"
+      "  ::$proto_ns$::Arena* message_arena = GetArenaForAllocation();\n"
+      "  if ($name$) {\n"
+      "    ::$proto_ns$::Arena* submessage_arena =\n"
+      "        ::$proto_ns$::Arena::InternalGetOwningArena(\n"
+      "                reinterpret_cast<::$proto_ns$::MessageLite*>("
+      "$name$));\n"
+      "    if (message_arena != submessage_arena) {\n"
+      "      $name$ = ::$proto_ns$::internal::GetOwnedMessage(\n"
+      "          message_arena, $name$, submessage_arena);\n"
+      "    }\n"
+      "    $set_hasbit$\n"
+      "  } else {\n"
+      "    $clear_hasbit$\n"
+      "  }\n"
+      "  $field$.UnsafeArenaSetAllocated($name$, message_arena);\n"
+      "$annotate_set$"
+      "  // @@protoc_insertion_point(field_set_allocated:$full_name$)\n"
+      "}\n");
+}
+
+void LazyMessageFieldGenerator::GenerateClearingCode(
+    io::Printer* printer) const {
+  Formatter format(printer, variables_);
+  format("$field$.Clear();\n");
+}
+
+void LazyMessageFieldGenerator::GenerateMergingCode(
+    io::Printer* printer) const {
+  Formatter format(printer, variables_);
+  if (internal::cpp::HasHasbit(descriptor_)) {
+    format("_this->$set_hasbit$\n");
+  }
+  format(
+      "_this->$field$.MergeFrom($type$::default_instance(), from.$field$,\n"
+      "                         _this->GetArenaForAllocation());\n");
+}
+
+void LazyMessageFieldGenerator::GenerateSwappingCode(
+    io::Printer* printer) const {
+  Formatter format(printer, variables_);
+  format("$field$.InternalSwap(&other->$field$);\n");
+}
+
+void LazyMessageFieldGenerator::GenerateDestructorCode(
+    io::Printer* printer) const {
+  Formatter format(printer, variables_);
+  format("$field$.Destroy();\n");
+}
+
+void LazyMessageFieldGenerator::GenerateCopyConstructorCode(
+    io::Printer* printer) const {
+  Formatter format(printer, variables_);
+  format(
+      "_this->$field$.MergeFrom($type$::default_instance(), from.$field$,\n"
+      "                         nullptr);\n");
+}
+
+void LazyMessageFieldGenerator::GenerateSerializeWithCachedSizesToArray(
+    io::Printer* printer) const {
+  Formatter format(printer, variables_);
+  format("target = $field$.InternalWrite($number$, target, stream);\n");
+}
+
+void LazyMessageFieldGenerator::GenerateByteSize(io::Printer* printer) const {
+  Formatter format(printer, variables_);
+  format(
+      "total_size += $tag_size$ +\n"
+      "  ::$proto_ns$::internal::WireFormatLite::LengthDelimitedSize(\n"
+      "    $field$.ByteSizeLong());\n");
+}
+
+void LazyMessageFieldGenerator::GenerateIsInitialized(
+    io::Printer* printer) const {
+  if (!has_required_fields_) return;
+
+  // Checking required fields parses the message.
+  Formatter format(printer, variables_);
+  format(
+      "if (!$field$.IsEmpty()) {\n"
+      "  if (!$field$.IsInitialized($type$::default_instance(),\n"
+      "                             GetArenaForAllocation())) {\n"
+      "    return false;\n"
+      "  }\n"
+      "}\n");
+}
+
+void LazyMessageFieldGenerator::GenerateConstexprAggregateInitializer(
+    io::Printer* printer) const {
+  Formatter format(printer, variables_);
+  format("/*decltype($field$)*/{}");
+}
+
+void LazyMessageFieldGenerator::GenerateCopyAggregateInitializer(
+    io::Printer* printer) const {
+  Formatter format(printer, variables_);
+  format("/*decltype($field$)*/{}");
+}
+
+void LazyMessageFieldGenerator::GenerateAggregateInitializer(
+    io::Printer* printer) const {
+  Formatter format(printer, variables_);
+  format("/*decltype($field$)*/{}");
+}
 }  // namespace
 
 std::unique_ptr<FieldGeneratorBase> MakeSinguarMessageGenerator(
     const FieldDescriptor* desc, const Options& options,
     MessageSCCAnalyzer* scc) {
+  if (IsLazy(desc, options, scc)) {
+    return absl::make_unique<LazyMessageFieldGenerator>(desc, options, scc);
+  }
   return absl::make_unique<MessageFieldGenerator>(desc, options, scc);
 }
 
@@ -468,6 +468,11 @@ void FileGenerator::GenerateSourceIncludes(io::Printer* p) {
       options_.tctable_mode != Options::kTCTableNever) {
     IncludeFile("third_party/protobuf/generated_message_tctable_impl.h", p);
   }
+  if (HasGeneratedMethods(file_, options_) &&
+      options_.table_driven_serialization) {
+    IncludeFile("third_party/protobuf/generated_message_tctable_serializer.h",
+                p);
+  }
 
   if (options_.proto_h) {
     // Use the smaller .proto.h files.
@@ -1246,7 +1251,6 @@ void FileGenerator::GenerateLibraryIncludes(io::Printer* p) {
     IncludeFile("third_party/protobuf/weak_field_map.h", p);
   }
   if (HasLazyFields(file_, options_, &scc_analyzer_)) {
-    GOOGLE_ABSL_CHECK(!options_.opensource_runtime);
     IncludeFile("third_party/protobuf/lazy_field.h", p);
   }
   if (ShouldVerify(file_, options_, &scc_analyzer_)) {
@@ -195,6 +195,8 @@ bool CppGenerator::Generate(const FileDescriptor* file,
             "Unknown value for experimental_tail_call_table_mode: " + value;
         return false;
       }
+    } else if (key == "experimental_table_driven_serialization") {
+      file_options.table_driven_serialization = true;
     } else {
       *error = "Unknown generator option: " + key;
       return false;
@@ -209,6 +211,16 @@ bool CppGenerator::Generate(const FileDescriptor* file,
     return false;
   }
 
+  // Table-driven serialization walks the tables of the table-driven parser,
+  // so they must always be generated.
+  if (file_options.table_driven_serialization &&
+      file_options.tctable_mode != Options::kTCTableAlways) {
+    *error =
+        "The experimental_table_driven_serialization option requires "
+        "experimental_tail_call_table_mode=always.";
+    return false;
+  }
+
   // -----------------------------------------------------------------
 
 
@@ -223,7 +223,13 @@ bool IsEagerlyVerifiedLazy(const FieldDescriptor* field, const Options& options,
 
 bool IsLazilyVerifiedLazy(const FieldDescriptor* field,
                           const Options& options) {
-  return false;
+  // Only singular message fields outside of oneofs are backed by LazyField;
+  // the annotation is ignored elsewhere and such fields are parsed eagerly.
+  return IsExplicitLazy(field) &&
+         field->type() == FieldDescriptor::TYPE_MESSAGE &&
+         !field->is_repeated() && !field->is_extension() &&
+         field->real_containing_oneof() == nullptr &&
+         !field->options().weak() && !options.lite_implicit_weak_fields;
 }
 
 absl::flat_hash_map<absl::string_view, std::string> MessageVars(
@@ -632,8 +632,10 @@ bool HasWeakFields(const FileDescriptor* desc, const Options& options);
 // given field.
 inline static bool ShouldIgnoreRequiredFieldCheck(const FieldDescriptor* field,
                                                   const Options& options) {
-  // Do not check "required" for lazily verified lazy fields.
-  return IsLazilyVerifiedLazy(field, options);
+  // Do not check "required" for [unverified_lazy] fields. Other lazy fields
+  // are parsed for the check if their type has required fields.
+  return IsLazilyVerifiedLazy(field, options) &&
+         field->options().unverified_lazy();
 }
 
 struct MessageAnalysis {
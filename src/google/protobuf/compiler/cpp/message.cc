@@ -1009,7 +1009,7 @@ void MessageGenerator::GenerateSingularFieldHasBits(
     if (IsLazy(field, options_, scc_analyzer_)) {
       format(
           "inline bool $classname$::_internal_has_$name$() const {\n"
-          "  return !$field$.IsCleared();\n"
+          "  return !$field$.IsEmpty();\n"
           "}\n");
     } else {
       format(
@@ -1551,6 +1551,12 @@ void MessageGenerator::GenerateClassDefinition(io::Printer* p) {
           "bool IsInitialized() const final;\n"
           "\n"
           "::size_t ByteSizeLong() const final;\n");
+      if (HasFlatByteSize()) {
+        format(
+            "::size_t FlatByteSizeLong(\n"
+            "    ::$proto_ns$::internal::FlatSizeCache* sizes) const final;\n"
+            "typedef void InternalFlatSizeCacheSupported_;\n");
+      }
 
       parse_function_generator_->GenerateMethodDecls(p);
 
@@ -1558,6 +1564,12 @@ void MessageGenerator::GenerateClassDefinition(io::Printer* p) {
           "$uint8$* _InternalSerialize(\n"
           "    $uint8$* target, ::$proto_ns$::io::EpsCopyOutputStream* stream) "
           "const final;\n");
+      if (HasFlatByteSize()) {
+        format(
+            "$uint8$* _InternalSerializeFlatSized(\n"
+            "    $uint8$* target, ::$proto_ns$::io::EpsCopyOutputStream* "
+            "stream) const final;\n");
+      }
     }
   }
 
@@ -2071,9 +2083,13 @@ void MessageGenerator::GenerateClassMethods(io::Printer* p) {
     GenerateSerializeWithCachedSizesToArray(p);
     format("\n");
 
+    GenerateSerializeWithFlatSizesToArray(p);
+
     GenerateByteSize(p);
     format("\n");
 
+    GenerateFlatByteSize(p);
+
     GenerateMergeFrom(p);
     format("\n");
 
@@ -2218,8 +2234,8 @@ std::pair<size_t, size_t> MessageGenerator::GenerateOffsets(io::Printer* p) {
     if (ShouldSplit(field, options_)) {
       format(" | ::_pbi::kSplitFieldOffsetMask /*split*/");
     }
-    if (IsEagerlyVerifiedLazy(field, options_, scc_analyzer_)) {
-      format(" | 0x1u /*eagerly verified lazy*/");
+    if (IsLazy(field, options_, scc_analyzer_)) {
+      format(" | 0x1u /*lazy*/");
     } else if (IsStringInlined(field, options_)) {
       format(" | 0x1u /*inlined*/");
     }
@@ -3586,7 +3602,11 @@ void MessageGenerator::GenerateSerializeOneofFields(
   for (auto field : fields) {
     format("case k$1$: {\n", UnderscoresToCamelCase(field->name(), true));
     format.Indent();
-    field_generators_.get(field).GenerateSerializeWithCachedSizesToArray(p);
+    if (serialize_flat_sizes_) {
+      field_generators_.get(field).GenerateSerializeWithFlatSizesToArray(p);
+    } else {
+      field_generators_.get(field).GenerateSerializeWithCachedSizesToArray(p);
+    }
     format("break;\n");
     format.Outdent();
     format("}\n");
@@ -3626,7 +3646,11 @@ void MessageGenerator::GenerateSerializeOneField(io::Printer* p,
     have_enclosing_if = EmitFieldNonDefaultCondition(p, "this->", field);
   }
 
-  field_generators_.get(field).GenerateSerializeWithCachedSizesToArray(p);
+  if (serialize_flat_sizes_) {
+    field_generators_.get(field).GenerateSerializeWithFlatSizesToArray(p);
+  } else {
+    field_generators_.get(field).GenerateSerializeWithCachedSizesToArray(p);
+  }
 
   if (have_enclosing_if) {
     format.Outdent();
@@ -3647,6 +3671,25 @@ void MessageGenerator::GenerateSerializeOneExtensionRange(
       "internal_default_instance(), $start$, $end$, target, stream);\n\n");
 }
 
+void MessageGenerator::GenerateSerializeUnknownFields(io::Printer* p) {
+  Formatter format(p);
+  format("if (PROTOBUF_PREDICT_FALSE($have_unknown_fields$)) {\n");
+  format.Indent();
+  if (UseUnknownFieldSet(descriptor_->file(), options_)) {
+    format(
+        "target = "
+        "::_pbi::WireFormat::"
+        "InternalSerializeUnknownFieldsToArray(\n"
+        "    $unknown_fields$, target, stream);\n");
+  } else {
+    format(
+        "target = stream->WriteRaw($unknown_fields$.data(),\n"
+        "    static_cast<int>($unknown_fields$.size()), target);\n");
+  }
+  format.Outdent();
+  format("}\n");
+}
+
 void MessageGenerator::GenerateSerializeWithCachedSizesToArray(io::Printer* p) {
   if (HasSimpleBaseClass(descriptor_, options_)) return;
   Formatter format(p);
@@ -3680,6 +3723,20 @@ void MessageGenerator::GenerateSerializeWithCachedSizesToArray(io::Printer* p) {
 
   format("// @@protoc_insertion_point(serialize_to_array_start:$full_name$)\n");
 
+  if (UseTableDrivenSerialization()) {
+    format(
+        "target = ::_pbi::TcSerializer::SerializeFields(\n"
+        "    *this, &_table_.header, target, stream);\n");
+    GenerateSerializeUnknownFields(p);
+    format(
+        "// @@protoc_insertion_point(serialize_to_array_end:$full_name$)\n");
+    format.Outdent();
+    format(
+        "  return target;\n"
+        "}\n");
+    return;
+  }
+
   if (!ShouldSerializeInOrder(descriptor_, options_)) {
     format.Outdent();
     format("#ifdef NDEBUG\n");
@@ -3708,6 +3765,31 @@ void MessageGenerator::GenerateSerializeWithCachedSizesToArray(io::Printer* p) {
       "}\n");
 }
 
+void MessageGenerator::GenerateSerializeWithFlatSizesToArray(io::Printer* p) {
+  if (HasSimpleBaseClass(descriptor_, options_) || !HasFlatByteSize()) return;
+  Formatter format(p);
+  format(
+      "$uint8$* $classname$::_InternalSerializeFlatSized(\n"
+      "    $uint8$* target, ::$proto_ns$::io::EpsCopyOutputStream* stream) "
+      "const {\n"
+      "$annotate_serialize$");
+  format.Indent();
+  if (!HasFlatSizedFields()) {
+    format("return $classname$::_InternalSerialize(target, stream);\n");
+  } else {
+    // Always in field number order, which is the order FlatByteSizeLong()
+    // records the sizes in.
+    serialize_flat_sizes_ = true;
+    GenerateSerializeWithCachedSizesBody(p);
+    serialize_flat_sizes_ = false;
+    format("return target;\n");
+  }
+  format.Outdent();
+  format(
+      "}\n"
+      "\n");
+}
+
 void MessageGenerator::GenerateSerializeWithCachedSizesBody(io::Printer* p) {
   if (HasSimpleBaseClass(descriptor_, options_)) return;
   Formatter format(p);
@@ -3896,21 +3978,7 @@ void MessageGenerator::GenerateSerializeWithCachedSizesBody(io::Printer* p) {
     e.EmitIfNotNull(largest_weak_field.Release());
   }
 
-  format("if (PROTOBUF_PREDICT_FALSE($have_unknown_fields$)) {\n");
-  format.Indent();
-  if (UseUnknownFieldSet(descriptor_->file(), options_)) {
-    format(
-        "target = "
-        "::_pbi::WireFormat::"
-        "InternalSerializeUnknownFieldsToArray(\n"
-        "    $unknown_fields$, target, stream);\n");
-  } else {
-    format(
-        "target = stream->WriteRaw($unknown_fields$.data(),\n"
-        "    static_cast<int>($unknown_fields$.size()), target);\n");
-  }
-  format.Outdent();
-  format("}\n");
+  GenerateSerializeUnknownFields(p);
 }
 
 void MessageGenerator::GenerateSerializeWithCachedSizesBodyShuffled(
@@ -3985,21 +4053,7 @@ void MessageGenerator::GenerateSerializeWithCachedSizesBodyShuffled(
   format.Outdent();
   format("}\n");
 
-  format("if (PROTOBUF_PREDICT_FALSE($have_unknown_fields$)) {\n");
-  format.Indent();
-  if (UseUnknownFieldSet(descriptor_->file(), options_)) {
-    format(
-        "target = "
-        "::_pbi::WireFormat::"
-        "InternalSerializeUnknownFieldsToArray(\n"
-        "    $unknown_fields$, target, stream);\n");
-  } else {
-    format(
-        "target = stream->WriteRaw($unknown_fields$.data(),\n"
-        "    static_cast<int>($unknown_fields$.size()), target);\n");
-  }
-  format.Outdent();
-  format("}\n");
+  GenerateSerializeUnknownFields(p);
 }
 
 std::vector<uint32_t> MessageGenerator::RequiredFieldsBitMask() const {
@@ -4267,6 +4321,115 @@ void MessageGenerator::GenerateByteSize(io::Printer* p) {
   format("}\n");
 }
 
+bool MessageGenerator::HasFlatByteSize() const {
+  // TcSerializer takes sub-message sizes from their cached sizes.
+  return !descriptor_->options().message_set_wire_format() &&
+         num_weak_fields_ == 0 && !UseTableDrivenSerialization();
+}
+
+bool MessageGenerator::HasFlatSizedFields() const {
+  for (const auto* field : FieldRange(descriptor_)) {
+    if (!IsFieldStripped(field, options_) &&
+        field->type() == FieldDescriptor::TYPE_MESSAGE && !field->is_map() &&
+        !IsLazy(field, options_, scc_analyzer_) &&
+        !IsImplicitWeakField(field, options_, scc_analyzer_)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool MessageGenerator::UseTableDrivenSerialization() const {
+  if (!options_.table_driven_serialization ||
+      options_.tctable_mode != Options::kTCTableAlways ||
+      HasSimpleBaseClass(descriptor_, options_) ||
+      IsMapEntryMessage(descriptor_) ||
+      descriptor_->options().message_set_wire_format() ||
+      !ShouldSerializeInOrder(descriptor_, options_)) {
+    return false;
+  }
+  // The table only describes extensions in a single range.
+  if (descriptor_->extension_range_count() > 1) return false;
+  // Fields the table-driven parser leaves to the generated fallback are not
+  // described well enough to be serialized from the table either.
+  for (const auto* field : FieldRange(descriptor_)) {
+    if (IsFieldStripped(field, options_) || field->is_map() ||
+        field->options().weak() || IsLazy(field, options_, scc_analyzer_) ||
+        IsImplicitWeakField(field, options_, scc_analyzer_)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void MessageGenerator::GenerateFlatByteSize(io::Printer* p) {
+  if (HasSimpleBaseClass(descriptor_, options_) || !HasFlatByteSize()) return;
+  Formatter format(p);
+
+  // Unlike ByteSizeLong(), which groups fields by has-bit word, this visits
+  // the fields in the order _InternalSerialize() writes them, so that
+  // sub-message sizes are recorded in the order they are consumed.
+  format(
+      "::size_t $classname$::FlatByteSizeLong(\n"
+      "    ::_pbi::FlatSizeCache* sizes) const {\n"
+      "$annotate_bytesize$");
+  format.Indent();
+  format(
+      "::size_t total_size = 0;\n"
+      "(void) sizes;\n"
+      "\n");
+
+  if (descriptor_->extension_range_count() > 0) {
+    // Extensions are serialized with their cached sizes.
+    format(
+        "total_size += $extensions$.ByteSize();\n"
+        "\n");
+  }
+
+  for (auto field : SortFieldsByNumber(descriptor_)) {
+    if (IsFieldStripped(field, options_)) continue;
+    auto v = p->WithVars(FieldVars(field, options_));
+    PrintFieldComment(format, field);
+
+    bool have_enclosing_if = false;
+    if (HasHasbit(field)) {
+      auto v = p->WithVars(HasbitVars(HasBitIndex(field)));
+      field_generators_.get(field).GenerateIfHasField(p);
+      format.Indent();
+      have_enclosing_if = true;
+    } else if (field->is_optional()) {
+      have_enclosing_if = EmitFieldNonDefaultCondition(p, "this->", field);
+    }
+
+    field_generators_.get(field).GenerateFlatByteSize(p);
+
+    if (have_enclosing_if) {
+      format.Outdent();
+      format("}\n");
+    }
+    format("\n");
+  }
+
+  if (UseUnknownFieldSet(descriptor_->file(), options_)) {
+    format(
+        "if (PROTOBUF_PREDICT_FALSE($have_unknown_fields$)) {\n"
+        "  total_size += ::_pbi::WireFormat::ComputeUnknownFieldsSize(\n"
+        "      $unknown_fields$);\n"
+        "}\n");
+  } else {
+    format(
+        "if (PROTOBUF_PREDICT_FALSE($have_unknown_fields$)) {\n"
+        "  total_size += $unknown_fields$.size();\n"
+        "}\n");
+  }
+  format("return total_size;\n");
+
+  format.Outdent();
+  format(
+      "}\n"
+      "\n");
+}
+
 void MessageGenerator::GenerateIsInitialized(io::Printer* p) {
   if (HasSimpleBaseClass(descriptor_, options_)) return;
   Formatter format(p);
@@ -129,7 +129,9 @@ class MessageGenerator {
   void GenerateSerializeWithCachedSizesToArray(io::Printer* p);
   void GenerateSerializeWithCachedSizesBody(io::Printer* p);
   void GenerateSerializeWithCachedSizesBodyShuffled(io::Printer* p);
+  void GenerateSerializeWithFlatSizesToArray(io::Printer* p);
   void GenerateByteSize(io::Printer* p);
+  void GenerateFlatByteSize(io::Printer* p);
   void GenerateMergeFrom(io::Printer* p);
   void GenerateClassSpecificMergeImpl(io::Printer* p);
   void GenerateCopyFrom(io::Printer* p);
@@ -149,6 +151,7 @@ class MessageGenerator {
       io::Printer* p, const std::vector<const FieldDescriptor*>& fields);
   void GenerateSerializeOneExtensionRange(
       io::Printer* p, const Descriptor::ExtensionRange* range);
+  void GenerateSerializeUnknownFields(io::Printer* p);
 
   // Generates has_foo() functions and variables for singular field has-bits.
   void GenerateSingularFieldHasBits(const FieldDescriptor* field,
@@ -176,6 +179,18 @@ class MessageGenerator {
   //   at construction.
   ArenaDtorNeeds NeedsArenaDestructor() const;
 
+  // Returns true if the message overrides FlatByteSizeLong().  Otherwise it
+  // inherits the default, which calls ByteSizeLong(), and is serialized with
+  // cached sizes when it is a sub-message of one that does.
+  bool HasFlatByteSize() const;
+  // Returns true if some field of the message takes its size from the flat
+  // sizes, so that _InternalSerializeFlatSized() needs a body of its own.
+  bool HasFlatSizedFields() const;
+
+  // Returns true if _InternalSerialize() is implemented with TcSerializer
+  // instead of per-field generated code.
+  bool UseTableDrivenSerialization() const;
+
   size_t HasBitsSize() const;
   size_t InlinedStringDonatedSize() const;
   int HasBitIndex(const FieldDescriptor* field) const;
@@ -207,6 +222,9 @@ class MessageGenerator {
   std::vector<const ExtensionGenerator*> extension_generators_;
   int num_required_fields_ = 0;
   int num_weak_fields_ = 0;
+  // Set while GenerateSerializeWithFlatSizesToArray() emits the body of
+  // _InternalSerializeFlatSized().
+  bool serialize_flat_sizes_ = false;
 
   std::unique_ptr<MessageLayoutHelper> message_layout_helper_;
   std::unique_ptr<ParseFunctionGenerator> parse_function_generator_;
@@ -72,6 +72,7 @@ struct Options {
     kTCTableGuarded,
     kTCTableAlways
   } tctable_mode = kTCTableNever;
+  bool table_driven_serialization = false;
   int num_cc_files = 0;
   bool safe_boundary_check = false;
   bool proto_h = false;
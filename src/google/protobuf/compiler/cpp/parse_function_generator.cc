@@ -636,6 +636,10 @@ void ParseFunctionGenerator::GenerateTailCallTable(Formatter& format) {
               case TailCallTableInfo::kNumericOffset:
                 format("{_fl::Offset{$1$}},\n", aux_entry.offset);
                 break;
+              case TailCallTableInfo::kFallbackTypeCard:
+                // Only tables built by reflection use this.
+                GOOGLE_ABSL_LOG(FATAL) << "Not supported.";
+                break;
             }
           }
         }
@@ -1043,49 +1047,16 @@ void ParseFunctionGenerator::GenerateLengthDelim(Formatter& format,
             format("ptr = ctx->ParseMessage(&$msg$$field$, ptr);\n");
           }
         } else if (IsLazy(field, options_, scc_analyzer_)) {
-          bool eager_verify =
-              IsEagerlyVerifiedLazy(field, options_, scc_analyzer_);
-          if (ShouldVerify(descriptor_, options_, scc_analyzer_)) {
-            format(
-                "ctx->set_lazy_eager_verify_func($1$);\n",
-                eager_verify
-                    ? absl::StrCat("&", ClassName(field->message_type(), true),
-                                   "::InternalVerify")
-                    : "nullptr");
-          }
-          if (field->real_containing_oneof()) {
-            format(
-                "if ($msg$$1$_case() != k$2$) {\n"
-                "  $msg$clear_$1$();\n"
-                "  $msg$$field$ = ::$proto_ns$::Arena::CreateMessage<\n"
-                "      ::$proto_ns$::internal::LazyField>("
-                "$msg$GetArenaForAllocation());\n"
-                "  $msg$set_has_$name$();\n"
-                "}\n"
-                "auto* lazy_field = $msg$$field$;\n",
-                field->containing_oneof()->name(),
-                UnderscoresToCamelCase(field->name(), true));
-          } else if (internal::cpp::HasHasbit(field)) {
-            format(
-                "_Internal::set_has_$name$(&$has_bits$);\n"
-                "auto* lazy_field = &$msg$$field$;\n");
-          } else {
-            format("auto* lazy_field = &$msg$$field$;\n");
+          // Only the field's bytes are recorded; the message is parsed from
+          // them on first access.
+          if (internal::cpp::HasHasbit(field)) {
+            format("_Internal::set_has_$name$(&$has_bits$);\n");
           }
           format(
-              "::$proto_ns$::internal::LazyFieldParseHelper<\n"
-              "  ::$proto_ns$::internal::LazyField> parse_helper(\n"
-              "    $1$::default_instance(),\n"
-              "    $msg$GetArenaForAllocation(),\n"
-              "    ::google::protobuf::internal::LazyVerifyOption::$2$,\n"
-              "    lazy_field);\n"
-              "ptr = ctx->ParseMessage(&parse_helper, ptr);\n",
-              FieldMessageTypeName(field, options_),
-              eager_verify ? "kEager" : "kLazy");
-          if (ShouldVerify(descriptor_, options_, scc_analyzer_) &&
-              eager_verify) {
-            format("ctx->set_lazy_eager_verify_func(nullptr);\n");
-          }
+              "ptr = $msg$$field$._InternalParse(\n"
+              "    $1$::default_instance(), $msg$GetArenaForAllocation(), "
+              "ptr, ctx);\n",
+              FieldMessageTypeName(field, options_));
         } else if (IsImplicitWeakField(field, options_, scc_analyzer_)) {
           if (!field->is_repeated()) {
             format(
@@ -1359,8 +1330,22 @@ void ParseFunctionGenerator::GenerateFieldSwitch(
     int tag_size = io::CodedOutputStream::VarintSize32(tag);
     bool is_repeat = ShouldRepeat(field, wiretype);
     if (is_repeat) {
+      format("ptr -= $1$;\n", tag_size);
+      if (field->is_map()) {
+        format(
+            "::$proto_ns$::internal::ReserveMapEntries<$1$>(&$msg$$field$, "
+            "ptr, ctx);\n",
+            tag);
+      } else if (field->type() == FieldDescriptor::TYPE_MESSAGE &&
+                 !IsLazy(field, options_, scc_analyzer_) &&
+                 !IsImplicitWeakField(field, options_, scc_analyzer_) &&
+                 !IsWeak(field, options_)) {
+        format(
+            "::$proto_ns$::internal::PreallocateRepeatedMessages<$1$>(\n"
+            "    &$msg$$field$, ptr, ctx);\n",
+            tag);
+      }
       format(
-          "ptr -= $1$;\n"
           "do {\n"
           "  ptr += $1$;\n",
           tag_size);
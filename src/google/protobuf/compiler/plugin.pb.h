@@ -216,9 +216,14 @@ class PROTOC_EXPORT Version final :
   bool IsInitialized() const final;
 
   ::size_t ByteSizeLong() const final;
+  ::size_t FlatByteSizeLong(
+      ::PROTOBUF_NAMESPACE_ID::internal::FlatSizeCache* sizes) const final;
+  typedef void InternalFlatSizeCacheSupported_;
   const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
   ::uint8_t* _InternalSerialize(
       ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  ::uint8_t* _InternalSerializeFlatSized(
+      ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
   int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
   private:
@@ -408,9 +413,14 @@ class PROTOC_EXPORT CodeGeneratorRequest final :
   bool IsInitialized() const final;
 
   ::size_t ByteSizeLong() const final;
+  ::size_t FlatByteSizeLong(
+      ::PROTOBUF_NAMESPACE_ID::internal::FlatSizeCache* sizes) const final;
+  typedef void InternalFlatSizeCacheSupported_;
   const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
   ::uint8_t* _InternalSerialize(
       ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  ::uint8_t* _InternalSerializeFlatSized(
+      ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
   int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
   private:
@@ -629,9 +639,14 @@ class PROTOC_EXPORT CodeGeneratorResponse_File final :
   bool IsInitialized() const final;
 
   ::size_t ByteSizeLong() const final;
+  ::size_t FlatByteSizeLong(
+      ::PROTOBUF_NAMESPACE_ID::internal::FlatSizeCache* sizes) const final;
+  typedef void InternalFlatSizeCacheSupported_;
   const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
   ::uint8_t* _InternalSerialize(
       ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  ::uint8_t* _InternalSerializeFlatSized(
+      ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
   int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
   private:
@@ -836,9 +851,14 @@ class PROTOC_EXPORT CodeGeneratorResponse final :
   bool IsInitialized() const final;
 
   ::size_t ByteSizeLong() const final;
+  ::size_t FlatByteSizeLong(
+      ::PROTOBUF_NAMESPACE_ID::internal::FlatSizeCache* sizes) const final;
+  typedef void InternalFlatSizeCacheSupported_;
   const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
   ::uint8_t* _InternalSerialize(
       ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  ::uint8_t* _InternalSerializeFlatSized(
+      ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
   int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
   private:
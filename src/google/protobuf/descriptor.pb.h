@@ -511,9 +511,14 @@ class PROTOBUF_EXPORT FileDescriptorSet final :
   bool IsInitialized() const final;
 
   ::size_t ByteSizeLong() const final;
+  ::size_t FlatByteSizeLong(
+      ::PROTOBUF_NAMESPACE_ID::internal::FlatSizeCache* sizes) const final;
+  typedef void InternalFlatSizeCacheSupported_;
   const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
   ::uint8_t* _InternalSerialize(
       ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  ::uint8_t* _InternalSerializeFlatSized(
+      ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
   int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
   private:
@@ -673,9 +678,14 @@ class PROTOBUF_EXPORT FileDescriptorProto final :
   bool IsInitialized() const final;
 
   ::size_t ByteSizeLong() const final;
+  ::size_t FlatByteSizeLong(
+      ::PROTOBUF_NAMESPACE_ID::internal::FlatSizeCache* sizes) const final;
+  typedef void InternalFlatSizeCacheSupported_;
   const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
   ::uint8_t* _InternalSerialize(
       ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  ::uint8_t* _InternalSerializeFlatSized(
+      ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
   int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
   private:
@@ -1066,9 +1076,14 @@ class PROTOBUF_EXPORT DescriptorProto_ExtensionRange final :
   bool IsInitialized() const final;
 
   ::size_t ByteSizeLong() const final;
+  ::size_t FlatByteSizeLong(
+      ::PROTOBUF_NAMESPACE_ID::internal::FlatSizeCache* sizes) const final;
+  typedef void InternalFlatSizeCacheSupported_;
   const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
   ::uint8_t* _InternalSerialize(
       ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  ::uint8_t* _InternalSerializeFlatSized(
+      ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
   int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
   private:
@@ -1247,9 +1262,14 @@ class PROTOBUF_EXPORT DescriptorProto_ReservedRange final :
   bool IsInitialized() const final;
 
   ::size_t ByteSizeLong() const final;
+  ::size_t FlatByteSizeLong(
+      ::PROTOBUF_NAMESPACE_ID::internal::FlatSizeCache* sizes) const final;
+  typedef void InternalFlatSizeCacheSupported_;
   const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
   ::uint8_t* _InternalSerialize(
       ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  ::uint8_t* _InternalSerializeFlatSized(
+      ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
   int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
   private:
@@ -1412,9 +1432,14 @@ class PROTOBUF_EXPORT DescriptorProto final :
   bool IsInitialized() const final;
 
   ::size_t ByteSizeLong() const final;
+  ::size_t FlatByteSizeLong(
+      ::PROTOBUF_NAMESPACE_ID::internal::FlatSizeCache* sizes) const final;
+  typedef void InternalFlatSizeCacheSupported_;
   const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
   ::uint8_t* _InternalSerialize(
       ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  ::uint8_t* _InternalSerializeFlatSized(
+      ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
   int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
   private:
@@ -1756,9 +1781,14 @@ class PROTOBUF_EXPORT ExtensionRangeOptions final :
   bool IsInitialized() const final;
 
   ::size_t ByteSizeLong() const final;
+  ::size_t FlatByteSizeLong(
+      ::PROTOBUF_NAMESPACE_ID::internal::FlatSizeCache* sizes) const final;
+  typedef void InternalFlatSizeCacheSupported_;
   const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
   ::uint8_t* _InternalSerialize(
       ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  ::uint8_t* _InternalSerializeFlatSized(
+      ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
   int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
   private:
@@ -2071,9 +2101,14 @@ class PROTOBUF_EXPORT FieldDescriptorProto final :
   bool IsInitialized() const final;
 
   ::size_t ByteSizeLong() const final;
+  ::size_t FlatByteSizeLong(
+      ::PROTOBUF_NAMESPACE_ID::internal::FlatSizeCache* sizes) const final;
+  typedef void InternalFlatSizeCacheSupported_;
   const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
   ::uint8_t* _InternalSerialize(
       ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  ::uint8_t* _InternalSerializeFlatSized(
+      ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
   int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
   private:
@@ -2422,9 +2457,14 @@ class PROTOBUF_EXPORT OneofDescriptorProto final :
   bool IsInitialized() const final;
 
   ::size_t ByteSizeLong() const final;
+  ::size_t FlatByteSizeLong(
+      ::PROTOBUF_NAMESPACE_ID::internal::FlatSizeCache* sizes) const final;
+  typedef void InternalFlatSizeCacheSupported_;
   const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
   ::uint8_t* _InternalSerialize(
       ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  ::uint8_t* _InternalSerializeFlatSized(
+      ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
   int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
   private:
@@ -2597,9 +2637,14 @@ class PROTOBUF_EXPORT EnumDescriptorProto_EnumReservedRange final :
   bool IsInitialized() const final;
 
   ::size_t ByteSizeLong() const final;
+  ::size_t FlatByteSizeLong(
+      ::PROTOBUF_NAMESPACE_ID::internal::FlatSizeCache* sizes) const final;
+  typedef void InternalFlatSizeCacheSupported_;
   const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
   ::uint8_t* _InternalSerialize(
       ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  ::uint8_t* _InternalSerializeFlatSized(
+      ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
   int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
   private:
@@ -2762,9 +2807,14 @@ class PROTOBUF_EXPORT EnumDescriptorProto final :
   bool IsInitialized() const final;
 
   ::size_t ByteSizeLong() const final;
+  ::size_t FlatByteSizeLong(
+      ::PROTOBUF_NAMESPACE_ID::internal::FlatSizeCache* sizes) const final;
+  typedef void InternalFlatSizeCacheSupported_;
   const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
   ::uint8_t* _InternalSerialize(
       ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  ::uint8_t* _InternalSerializeFlatSized(
+      ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
   int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
   private:
@@ -3005,9 +3055,14 @@ class PROTOBUF_EXPORT EnumValueDescriptorProto final :
   bool IsInitialized() const final;
 
   ::size_t ByteSizeLong() const final;
+  ::size_t FlatByteSizeLong(
+      ::PROTOBUF_NAMESPACE_ID::internal::FlatSizeCache* sizes) const final;
+  typedef void InternalFlatSizeCacheSupported_;
   const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
   ::uint8_t* _InternalSerialize(
       ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  ::uint8_t* _InternalSerializeFlatSized(
+      ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
   int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
   private:
@@ -3191,9 +3246,14 @@ class PROTOBUF_EXPORT ServiceDescriptorProto final :
   bool IsInitialized() const final;
 
   ::size_t ByteSizeLong() const final;
+  ::size_t FlatByteSizeLong(
+      ::PROTOBUF_NAMESPACE_ID::internal::FlatSizeCache* sizes) const final;
+  typedef void InternalFlatSizeCacheSupported_;
   const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
   ::uint8_t* _InternalSerialize(
       ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  ::uint8_t* _InternalSerializeFlatSized(
+      ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
   int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
   private:
@@ -3386,9 +3446,14 @@ class PROTOBUF_EXPORT MethodDescriptorProto final :
   bool IsInitialized() const final;
 
   ::size_t ByteSizeLong() const final;
+  ::size_t FlatByteSizeLong(
+      ::PROTOBUF_NAMESPACE_ID::internal::FlatSizeCache* sizes) const final;
+  typedef void InternalFlatSizeCacheSupported_;
   const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
   ::uint8_t* _InternalSerialize(
       ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  ::uint8_t* _InternalSerializeFlatSized(
+      ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
   int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
   private:
@@ -3615,9 +3680,14 @@ class PROTOBUF_EXPORT FileOptions final :
   bool IsInitialized() const final;
 
   ::size_t ByteSizeLong() const final;
+  ::size_t FlatByteSizeLong(
+      ::PROTOBUF_NAMESPACE_ID::internal::FlatSizeCache* sizes) const final;
+  typedef void InternalFlatSizeCacheSupported_;
   const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
   ::uint8_t* _InternalSerialize(
       ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  ::uint8_t* _InternalSerializeFlatSized(
+      ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
   int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
   private:
@@ -4222,9 +4292,14 @@ class PROTOBUF_EXPORT MessageOptions final :
   bool IsInitialized() const final;
 
   ::size_t ByteSizeLong() const final;
+  ::size_t FlatByteSizeLong(
+      ::PROTOBUF_NAMESPACE_ID::internal::FlatSizeCache* sizes) const final;
+  typedef void InternalFlatSizeCacheSupported_;
   const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
   ::uint8_t* _InternalSerialize(
       ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  ::uint8_t* _InternalSerializeFlatSized(
+      ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
   int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
   private:
@@ -4593,9 +4668,14 @@ class PROTOBUF_EXPORT FieldOptions final :
   bool IsInitialized() const final;
 
   ::size_t ByteSizeLong() const final;
+  ::size_t FlatByteSizeLong(
+      ::PROTOBUF_NAMESPACE_ID::internal::FlatSizeCache* sizes) const final;
+  typedef void InternalFlatSizeCacheSupported_;
   const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
   ::uint8_t* _InternalSerialize(
       ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  ::uint8_t* _InternalSerializeFlatSized(
+      ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
   int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
   private:
@@ -5039,9 +5119,14 @@ class PROTOBUF_EXPORT OneofOptions final :
   bool IsInitialized() const final;
 
   ::size_t ByteSizeLong() const final;
+  ::size_t FlatByteSizeLong(
+      ::PROTOBUF_NAMESPACE_ID::internal::FlatSizeCache* sizes) const final;
+  typedef void InternalFlatSizeCacheSupported_;
   const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
   ::uint8_t* _InternalSerialize(
       ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  ::uint8_t* _InternalSerializeFlatSized(
+      ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
   int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
   private:
@@ -5354,9 +5439,14 @@ class PROTOBUF_EXPORT EnumOptions final :
   bool IsInitialized() const final;
 
   ::size_t ByteSizeLong() const final;
+  ::size_t FlatByteSizeLong(
+      ::PROTOBUF_NAMESPACE_ID::internal::FlatSizeCache* sizes) const final;
+  typedef void InternalFlatSizeCacheSupported_;
   const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
   ::uint8_t* _InternalSerialize(
       ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  ::uint8_t* _InternalSerializeFlatSized(
+      ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
   int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
   private:
@@ -5703,9 +5793,14 @@ class PROTOBUF_EXPORT EnumValueOptions final :
   bool IsInitialized() const final;
 
   ::size_t ByteSizeLong() const final;
+  ::size_t FlatByteSizeLong(
+      ::PROTOBUF_NAMESPACE_ID::internal::FlatSizeCache* sizes) const final;
+  typedef void InternalFlatSizeCacheSupported_;
   const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
   ::uint8_t* _InternalSerialize(
       ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  ::uint8_t* _InternalSerializeFlatSized(
+      ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
   int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
   private:
@@ -6030,9 +6125,14 @@ class PROTOBUF_EXPORT ServiceOptions final :
   bool IsInitialized() const final;
 
   ::size_t ByteSizeLong() const final;
+  ::size_t FlatByteSizeLong(
+      ::PROTOBUF_NAMESPACE_ID::internal::FlatSizeCache* sizes) const final;
+  typedef void InternalFlatSizeCacheSupported_;
   const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
   ::uint8_t* _InternalSerialize(
       ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  ::uint8_t* _InternalSerializeFlatSized(
+      ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
   int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
   private:
@@ -6357,9 +6457,14 @@ class PROTOBUF_EXPORT MethodOptions final :
   bool IsInitialized() const final;
 
   ::size_t ByteSizeLong() const final;
+  ::size_t FlatByteSizeLong(
+      ::PROTOBUF_NAMESPACE_ID::internal::FlatSizeCache* sizes) const final;
+  typedef void InternalFlatSizeCacheSupported_;
   const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
   ::uint8_t* _InternalSerialize(
       ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  ::uint8_t* _InternalSerializeFlatSized(
+      ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
   int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
   private:
@@ -6716,9 +6821,14 @@ class PROTOBUF_EXPORT UninterpretedOption_NamePart final :
   bool IsInitialized() const final;
 
   ::size_t ByteSizeLong() const final;
+  ::size_t FlatByteSizeLong(
+      ::PROTOBUF_NAMESPACE_ID::internal::FlatSizeCache* sizes) const final;
+  typedef void InternalFlatSizeCacheSupported_;
   const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
   ::uint8_t* _InternalSerialize(
       ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  ::uint8_t* _InternalSerializeFlatSized(
+      ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
   int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
   private:
@@ -6889,9 +6999,14 @@ class PROTOBUF_EXPORT UninterpretedOption final :
   bool IsInitialized() const final;
 
   ::size_t ByteSizeLong() const final;
+  ::size_t FlatByteSizeLong(
+      ::PROTOBUF_NAMESPACE_ID::internal::FlatSizeCache* sizes) const final;
+  typedef void InternalFlatSizeCacheSupported_;
   const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
   ::uint8_t* _InternalSerialize(
       ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  ::uint8_t* _InternalSerializeFlatSized(
+      ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
   int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
   private:
@@ -7135,9 +7250,14 @@ class PROTOBUF_EXPORT SourceCodeInfo_Location final :
   bool IsInitialized() const final;
 
   ::size_t ByteSizeLong() const final;
+  ::size_t FlatByteSizeLong(
+      ::PROTOBUF_NAMESPACE_ID::internal::FlatSizeCache* sizes) const final;
+  typedef void InternalFlatSizeCacheSupported_;
   const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
   ::uint8_t* _InternalSerialize(
       ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  ::uint8_t* _InternalSerializeFlatSized(
+      ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
   int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
   private:
@@ -7386,9 +7506,14 @@ class PROTOBUF_EXPORT SourceCodeInfo final :
   bool IsInitialized() const final;
 
   ::size_t ByteSizeLong() const final;
+  ::size_t FlatByteSizeLong(
+      ::PROTOBUF_NAMESPACE_ID::internal::FlatSizeCache* sizes) const final;
+  typedef void InternalFlatSizeCacheSupported_;
   const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
   ::uint8_t* _InternalSerialize(
       ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  ::uint8_t* _InternalSerializeFlatSized(
+      ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
   int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
   private:
@@ -7550,9 +7675,14 @@ class PROTOBUF_EXPORT GeneratedCodeInfo_Annotation final :
   bool IsInitialized() const final;
 
   ::size_t ByteSizeLong() const final;
+  ::size_t FlatByteSizeLong(
+      ::PROTOBUF_NAMESPACE_ID::internal::FlatSizeCache* sizes) const final;
+  typedef void InternalFlatSizeCacheSupported_;
   const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
   ::uint8_t* _InternalSerialize(
       ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  ::uint8_t* _InternalSerializeFlatSized(
+      ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
   int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
   private:
@@ -7788,9 +7918,14 @@ class PROTOBUF_EXPORT GeneratedCodeInfo final :
   bool IsInitialized() const final;
 
   ::size_t ByteSizeLong() const final;
+  ::size_t FlatByteSizeLong(
+      ::PROTOBUF_NAMESPACE_ID::internal::FlatSizeCache* sizes) const final;
+  typedef void InternalFlatSizeCacheSupported_;
   const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
   ::uint8_t* _InternalSerialize(
       ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  ::uint8_t* _InternalSerializeFlatSized(
+      ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
   int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
   private:
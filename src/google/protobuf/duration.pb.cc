@@ -236,6 +236,11 @@ failure:
   return target;
 }
 
+::uint8_t* Duration::_InternalSerializeFlatSized(
+    ::uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  return Duration::_InternalSerialize(target, stream);
+}
+
 ::size_t Duration::ByteSizeLong() const {
 // @@protoc_insertion_point(message_byte_size_start:google.protobuf.Duration)
   ::size_t total_size = 0;
@@ -257,6 +262,28 @@ failure:
   return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
+::size_t Duration::FlatByteSizeLong(
+    ::_pbi::FlatSizeCache* sizes) const {
+  ::size_t total_size = 0;
+  (void) sizes;
+
+  // int64 seconds = 1;
+  if (this->_internal_seconds() != 0) {
+    total_size += ::_pbi::WireFormatLite::Int64SizePlusOne(this->_internal_seconds());
+  }
+
+  // int32 nanos = 2;
+  if (this->_internal_nanos() != 0) {
+    total_size += ::_pbi::WireFormatLite::Int32SizePlusOne(this->_internal_nanos());
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    total_size += ::_pbi::WireFormat::ComputeUnknownFieldsSize(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance));
+  }
+  return total_size;
+}
+
 const ::PROTOBUF_NAMESPACE_ID::Message::ClassData Duration::_class_data_ = {
     ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
     Duration::MergeImpl
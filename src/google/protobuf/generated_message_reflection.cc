@@ -55,6 +55,7 @@
 #include "google/protobuf/generated_message_tctable_impl.h"
 #include "google/protobuf/generated_message_util.h"
 #include "google/protobuf/inlined_string_field.h"
+#include "google/protobuf/lazy_field.h"
 #include "google/protobuf/map_field.h"
 #include "google/protobuf/map_field_inl.h"
 #include "google/protobuf/repeated_field.h"
@@ -318,11 +319,9 @@ bool Reflection::IsLazyExtension(const Message& message,
 }
 
 bool Reflection::IsLazilyVerifiedLazyField(const FieldDescriptor* field) const {
-  if (field->options().unverified_lazy()) return true;
-
-  // Message fields with [lazy=true] will be eagerly verified
-  // (go/verified-lazy).
-  return field->options().lazy() && !IsEagerlyVerifiedLazyField(field);
+  // Only fields that generated code stores as a LazyField are lazy; the
+  // annotation has no effect on other fields, e.g. those of dynamic messages.
+  return schema_.IsLazyField(field) && !IsEagerlyVerifiedLazyField(field);
 }
 
 bool Reflection::IsEagerlyVerifiedLazyField(
@@ -438,6 +437,16 @@ size_t Reflection::SpaceUsedLong(const Message& message) const {
           if (schema_.IsDefaultInstance(message)) {
             // For singular fields, the prototype just stores a pointer to the
             // external type's prototype, so there is no extra memory usage.
+          } else if (schema_.IsLazyField(field)) {
+            const LazyField& lazy = GetRaw<LazyField>(message, field);
+            total_size += lazy.SpaceUsedExcludingSelfLong();
+            if (lazy.IsMaterialized()) {
+              const MessageLite& sub_message =
+                  lazy.GetMessage(*GetDefaultMessageInstance(field),
+                                  message.GetArenaForAllocation());
+              total_size += internal::DownCast<const Message&>(sub_message)
+                                .SpaceUsedLong();
+            }
           } else {
             const Message* sub_message = GetRaw<const Message*>(message, field);
             if (sub_message != nullptr) {
@@ -565,6 +574,10 @@ class SwapFieldHelper {
                           Message* rhs, Arena* rhs_arena,
                           const FieldDescriptor* field);
 
+  template <bool unsafe_shallow_swap>
+  static void SwapLazyField(const Reflection* r, Message* lhs, Message* rhs,
+                            const FieldDescriptor* field);
+
   static void SwapNonMessageNonStringField(const Reflection* r, Message* lhs,
                                            Message* rhs,
                                            const FieldDescriptor* field);
@@ -706,7 +719,9 @@ template <bool unsafe_shallow_swap>
 void SwapFieldHelper::SwapMessageField(const Reflection* r, Message* lhs,
                                        Message* rhs,
                                        const FieldDescriptor* field) {
-  if (unsafe_shallow_swap) {
+  if (r->schema_.IsLazyField(field)) {
+    SwapLazyField<unsafe_shallow_swap>(r, lhs, rhs, field);
+  } else if (unsafe_shallow_swap) {
     std::swap(*r->MutableRaw<Message*>(lhs, field),
               *r->MutableRaw<Message*>(rhs, field));
   } else {
@@ -715,6 +730,29 @@ void SwapFieldHelper::SwapMessageField(const Reflection* r, Message* lhs,
   }
 }
 
+template <bool unsafe_shallow_swap>
+void SwapFieldHelper::SwapLazyField(const Reflection* r, Message* lhs,
+                                    Message* rhs,
+                                    const FieldDescriptor* field) {
+  LazyField* lhs_lazy = r->MutableRaw<LazyField>(lhs, field);
+  LazyField* rhs_lazy = r->MutableRaw<LazyField>(rhs, field);
+  Arena* lhs_arena = lhs->GetArenaForAllocation();
+  Arena* rhs_arena = rhs->GetArenaForAllocation();
+  if (unsafe_shallow_swap || lhs_arena == rhs_arena) {
+    lhs_lazy->InternalSwap(rhs_lazy);
+    return;
+  }
+  // Copy each side into the other's arena. `tmp` ends up with the previous
+  // state of `rhs_lazy`, which lives on `rhs_arena`.
+  const Message& prototype = *r->GetDefaultMessageInstance(field);
+  LazyField tmp;
+  tmp.MergeFrom(prototype, *lhs_lazy, rhs_arena);
+  lhs_lazy->Clear();
+  lhs_lazy->MergeFrom(prototype, *rhs_lazy, lhs_arena);
+  rhs_lazy->InternalSwap(&tmp);
+  if (rhs_arena == nullptr) tmp.Destroy();
+}
+
 void SwapFieldHelper::SwapMessage(const Reflection* r, Message* lhs,
                                   Arena* lhs_arena, Message* rhs,
                                   Arena* rhs_arena,
@@ -1349,7 +1387,9 @@ void Reflection::ClearField(Message* message,
         }
 
         case FieldDescriptor::CPPTYPE_MESSAGE:
-          if (schema_.HasBitIndex(field) == static_cast<uint32_t>(-1)) {
+          if (schema_.IsLazyField(field)) {
+            MutableRaw<LazyField>(message, field)->Clear();
+          } else if (schema_.HasBitIndex(field) == static_cast<uint32_t>(-1)) {
             // Proto3 does not have has-bits and we need to set a message field
             // to nullptr in order to indicate its un-presence.
             if (message->GetArenaForAllocation() == nullptr) {
@@ -2100,6 +2140,12 @@ const Message& Reflection::GetMessage(const Message& message,
     if (schema_.InRealOneof(field) && !HasOneofField(message, field)) {
       return *GetDefaultMessageInstance(field);
     }
+    if (schema_.IsLazyField(field)) {
+      return internal::DownCast<const Message&>(
+          GetRaw<LazyField>(message, field)
+              .GetMessage(*GetDefaultMessageInstance(field),
+                          message.GetArenaForAllocation()));
+    }
     const Message* result = GetRaw<const Message*>(message, field);
     if (result == nullptr) {
       result = GetDefaultMessageInstance(field);
@@ -2119,6 +2165,12 @@ Message* Reflection::MutableMessage(Message* message,
   if (field->is_extension()) {
     return static_cast<Message*>(
         MutableExtensionSet(message)->MutableMessage(field, factory));
+  } else if (schema_.IsLazyField(field)) {
+    SetBit(message, field);
+    return internal::DownCast<Message*>(
+        MutableRaw<LazyField>(message, field)
+            ->MutableMessage(*GetDefaultMessageInstance(field),
+                             message->GetArenaForAllocation()));
   } else {
     Message* result;
 
@@ -2171,6 +2223,11 @@ void Reflection::UnsafeArenaSetAllocatedMessage(
     } else {
       SetBit(message, field);
     }
+    if (schema_.IsLazyField(field)) {
+      MutableRaw<LazyField>(message, field)->UnsafeArenaSetAllocated(
+          sub_message, message->GetArenaForAllocation());
+      return;
+    }
     Message** sub_message_holder = MutableRaw<Message*>(message, field);
     if (message->GetArenaForAllocation() == nullptr) {
       delete *sub_message_holder;
@@ -2234,6 +2291,12 @@ Message* Reflection::UnsafeArenaReleaseMessage(Message* message,
         return nullptr;
       }
     }
+    if (schema_.IsLazyField(field)) {
+      return internal::DownCast<Message*>(
+          MutableRaw<LazyField>(message, field)->UnsafeArenaRelease(
+              *GetDefaultMessageInstance(field),
+              message->GetArenaForAllocation()));
+    }
     Message** result = MutableRaw<Message*>(message, field);
     Message* ret = *result;
     *result = nullptr;
@@ -2696,6 +2759,9 @@ bool Reflection::HasBit(const Message& message,
   // proto3: no has-bits. All fields present except messages, which are
   // present only if their message-field pointer is non-null.
   if (field->cpp_type() == FieldDescriptor::CPPTYPE_MESSAGE) {
+    if (schema_.IsLazyField(field)) {
+      return !GetRaw<LazyField>(message, field).IsEmpty();
+    }
     return !schema_.IsDefaultInstance(message) &&
            GetRaw<const Message*>(message, field) != nullptr;
   } else {
@@ -3198,12 +3264,6 @@ void Reflection::PopulateTcParseEntries(
       // Weak fields are handled by the generated fallback function.
       // (These are handled by legacy Google-internal logic.)
       *entries = {};
-    } else if (field->type() == field->TYPE_ENUM &&
-               table_info.aux_entries[entry.aux_idx].type ==
-                   internal::TailCallTableInfo::kEnumValidator) {
-      // Mini parse can't handle it. Fallback to reflection.
-      *entries = {};
-      table_info.aux_entries[entry.aux_idx] = {};
     } else {
       const OneofDescriptor* oneof = field->real_containing_oneof();
       entries->offset = schema_.GetFieldOffset(field);
@@ -3217,6 +3277,16 @@ void Reflection::PopulateTcParseEntries(
       }
       entries->aux_idx = entry.aux_idx;
       entries->type_card = entry.type_card;
+      if (field->type() == field->TYPE_ENUM &&
+          table_info.aux_entries[entry.aux_idx].type ==
+              internal::TailCallTableInfo::kEnumValidator) {
+        // Mini parse can't handle it. Fallback to reflection.  The type card
+        // is kept in the aux entry for TcSerializer.
+        entries->type_card = internal::field_layout::kFkNone;
+        table_info.aux_entries[entry.aux_idx] = {
+            internal::TailCallTableInfo::kFallbackTypeCard};
+        table_info.aux_entries[entry.aux_idx].type_card = entry.type_card;
+      }
     }
 
     ++entries;
@@ -3259,6 +3329,9 @@ void Reflection::PopulateTcParseFieldAux(
       case internal::TailCallTableInfo::kNumericOffset:
         field_aux++->offset = aux_entry.offset;
         break;
+      case internal::TailCallTableInfo::kFallbackTypeCard:
+        field_aux++->fallback_type_card = aux_entry.type_card;
+        break;
     }
   }
 }
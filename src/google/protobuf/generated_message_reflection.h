@@ -229,6 +229,15 @@ struct ReflectionSchema {
            OffsetValue(offsets_[field->index()], field->type());
   }
 
+  // Returns true if the field is stored as a LazyField, which generated code
+  // marks in the low bit of the field's offset.  Dynamic messages store every
+  // message field as a pointer, whatever its options.
+  bool IsLazyField(const FieldDescriptor* field) const {
+    return field->type() == FieldDescriptor::TYPE_MESSAGE &&
+           !field->is_extension() && !InRealOneof(field) &&
+           (offsets_[field->index()] & kLazyMask) != 0;
+  }
+
   // Returns true if the field is implicitly backed by LazyField.
   bool IsEagerlyVerifiedLazyField(const FieldDescriptor* field) const {
     GOOGLE_ABSL_DCHECK_EQ(field->type(), FieldDescriptor::TYPE_MESSAGE);
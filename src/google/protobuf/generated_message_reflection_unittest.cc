@@ -1323,6 +1323,45 @@ TEST(GeneratedMessageReflectionTest, UsageErrors) {
 #endif  // PROTOBUF_HAS_DEATH_TEST
 
 
+TEST(GeneratedMessageReflectionTest, LazyField) {
+  const FieldDescriptor* field = F("optional_lazy_message");
+  const Reflection* reflection = unittest::TestAllTypes::GetReflection();
+  unittest::TestAllTypes message;
+  EXPECT_TRUE(
+      GeneratedMessageReflectionTestHelper::IsLazyField(message, field));
+  EXPECT_TRUE(GeneratedMessageReflectionTestHelper::IsLazilyVerifiedLazyField(
+      message, field));
+
+  unittest::TestAllTypes source;
+  source.mutable_optional_lazy_message()->set_bb(3);
+  ASSERT_TRUE(message.ParseFromString(source.SerializeAsString()));
+  EXPECT_TRUE(reflection->HasField(message, field));
+  EXPECT_EQ(static_cast<const unittest::TestAllTypes::NestedMessage&>(
+                reflection->GetMessage(message, field))
+                .bb(),
+            3);
+  EXPECT_GT(reflection->SpaceUsedLong(message),
+            unittest::TestAllTypes().SpaceUsedLong());
+
+  // Swapping with a message on an arena copies the field across.
+  Arena arena;
+  auto* other = Arena::CreateMessage<unittest::TestAllTypes>(&arena);
+  reflection->SwapFields(&message, other, {field});
+  EXPECT_FALSE(message.has_optional_lazy_message());
+  EXPECT_EQ(other->optional_lazy_message().bb(), 3);
+  EXPECT_EQ(other->optional_lazy_message().GetArena(), &arena);
+
+  std::unique_ptr<Message> released(reflection->ReleaseMessage(other, field));
+  ASSERT_NE(released, nullptr);
+  EXPECT_FALSE(other->has_optional_lazy_message());
+  EXPECT_EQ(released->GetArena(), nullptr);
+
+  reflection->MutableMessage(&message, field);
+  EXPECT_TRUE(message.has_optional_lazy_message());
+  reflection->ClearField(&message, field);
+  EXPECT_FALSE(message.has_optional_lazy_message());
+}
+
 using internal::IsDescendant;
 
 TEST(GeneratedMessageReflection, IsDescendantMessage) {
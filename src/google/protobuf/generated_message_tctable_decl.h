@@ -283,6 +283,10 @@ struct alignas(uint64_t) TcParseTableBase {
     uint32_t offset;
     const void* message_default_p;
     const TcParseTableBase* table;
+    // Tables built by reflection leave enum fields that need a validator to
+    // the reflection parser (kFkNone), and keep the type card the field would
+    // otherwise have here, for TcSerializer.
+    uint16_t fallback_type_card;
 
     const MessageLite* message_default() const {
       return static_cast<const MessageLite*>(message_default_p);
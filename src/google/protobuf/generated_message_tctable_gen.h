@@ -106,6 +106,7 @@ struct PROTOBUF_EXPORT TailCallTableInfo {
     kEnumRange,
     kEnumValidator,
     kNumericOffset,
+    kFallbackTypeCard,
   };
   struct AuxEntry {
     AuxType type;
@@ -117,6 +118,7 @@ struct PROTOBUF_EXPORT TailCallTableInfo {
       const FieldDescriptor* field;
       uint32_t offset;
       EnumRange enum_range;
+      uint16_t type_card;
     };
   };
   std::vector<AuxEntry> aux_entries;
@@ -702,6 +702,9 @@ class PROTOBUF_EXPORT TcParser final {
                            const TcParseTableBase::FieldEntry& entry,
                            uint16_t xform_val);
 
+  friend class TcReverseSerializer;
+  friend class TcSerializer;
+
   // For FindFieldEntry tests:
   friend class FindFieldEntryTest;
   friend struct ParseFunctionGeneratorTestPeer;
@@ -483,10 +483,19 @@ inline PROTOBUF_ALWAYS_INLINE const char* TcParser::RepeatedParseMessageAuxImpl(
   const auto expected_tag = UnalignedLoad<TagType>(ptr);
   const auto aux = *table->field_aux(data.aux_idx());
   auto& field = RefAt<RepeatedPtrFieldBase>(msg, data.offset());
+  const MessageLite* default_instance =
+      aux_is_table ? aux.table->default_instance : aux.message_default();
+  if (!group_coding && field.GetArena() != nullptr &&
+      field.ClearedCount() == 0) {
+    // Allocate the elements that are already buffered back to back, ahead of
+    // their contents.
+    const int count = ctx->CountBufferedFields(ptr, expected_tag);
+    if (count > 1) field.Preallocate(default_instance, count);
+  }
   do {
     ptr += sizeof(TagType);
-    MessageLite* submsg = field.Add<GenericTypeHandler<MessageLite>>(
-        aux_is_table ? aux.table->default_instance : aux.message_default());
+    MessageLite* submsg =
+        field.Add<GenericTypeHandler<MessageLite>>(default_instance);
     if (aux_is_table) {
       if (group_coding) {
         ptr = ctx->ParseGroup<TcParser>(submsg, ptr,
@@ -993,19 +1002,22 @@ const char* TcParser::PackedVarint(PROTOBUF_TC_PARAM_DECL) {
   // pending hasbits now:
   SyncHasbits(msg, hasbits, table);
   auto* field = &RefAt<RepeatedField<FieldType>>(msg, data.offset());
-  return ctx->ReadPackedVarint(ptr, [field](uint64_t varint) {
-    FieldType val;
-    if (zigzag) {
-      if (sizeof(FieldType) == 8) {
-        val = WireFormatLite::ZigZagDecode64(varint);
-      } else {
-        val = WireFormatLite::ZigZagDecode32(varint);
-      }
-    } else {
-      val = varint;
-    }
-    field->Add(val);
-  });
+  return ctx->ReadPackedVarint(
+      ptr,
+      [field](uint64_t varint) {
+        FieldType val;
+        if (zigzag) {
+          if (sizeof(FieldType) == 8) {
+            val = WireFormatLite::ZigZagDecode64(varint);
+          } else {
+            val = WireFormatLite::ZigZagDecode32(varint);
+          }
+        } else {
+          val = varint;
+        }
+        field->AddAlreadyReserved(val);
+      },
+      [field](int num) { field->Reserve(field->size() + num); });
 }
 
 PROTOBUF_NOINLINE const char* TcParser::FastV8P1(PROTOBUF_TC_PARAM_DECL) {
@@ -1995,9 +2007,13 @@ PROTOBUF_NOINLINE const char* TcParser::MpPackedVarint(PROTOBUF_TC_PARAM_DECL) {
   uint16_t rep = type_card & field_layout::kRepMask;
   if (rep == field_layout::kRep64Bits) {
     auto* field = &RefAt<RepeatedField<uint64_t>>(msg, entry.offset);
-    return ctx->ReadPackedVarint(ptr, [field, is_zigzag](uint64_t value) {
-      field->Add(is_zigzag ? WireFormatLite::ZigZagDecode64(value) : value);
-    });
+    return ctx->ReadPackedVarint(
+        ptr,
+        [field, is_zigzag](uint64_t value) {
+          field->AddAlreadyReserved(
+              is_zigzag ? WireFormatLite::ZigZagDecode64(value) : value);
+        },
+        [field](int num) { field->Reserve(field->size() + num); });
   } else if (rep == field_layout::kRep32Bits) {
     auto* field = &RefAt<RepeatedField<uint32_t>>(msg, entry.offset);
     if (is_validated_enum) {
@@ -2010,17 +2026,22 @@ PROTOBUF_NOINLINE const char* TcParser::MpPackedVarint(PROTOBUF_TC_PARAM_DECL) {
         }
       });
     } else {
-      return ctx->ReadPackedVarint(ptr, [field, is_zigzag](uint64_t value) {
-        field->Add(is_zigzag ? WireFormatLite::ZigZagDecode32(
-                                   static_cast<uint32_t>(value))
-                             : value);
-      });
+      return ctx->ReadPackedVarint(
+          ptr,
+          [field, is_zigzag](uint64_t value) {
+            field->AddAlreadyReserved(
+                is_zigzag ? WireFormatLite::ZigZagDecode32(
+                                static_cast<uint32_t>(value))
+                          : value);
+          },
+          [field](int num) { field->Reserve(field->size() + num); });
     }
   } else {
     GOOGLE_ABSL_DCHECK_EQ(rep, static_cast<uint16_t>(field_layout::kRep8Bits));
     auto* field = &RefAt<RepeatedField<bool>>(msg, entry.offset);
     return ctx->ReadPackedVarint(
-        ptr, [field](uint64_t value) { field->Add(value); });
+        ptr, [field](uint64_t value) { field->AddAlreadyReserved(value); },
+        [field](int num) { field->Reserve(field->size() + num); });
   }
 
   return Error(PROTOBUF_TC_PARAM_PASS);
@@ -0,0 +1,431 @@
+// Protocol Buffers - Google's data interchange format
+// Copyright 2008 Google Inc.  All rights reserved.
+// https://developers.google.com/protocol-buffers/
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "google/protobuf/generated_message_tctable_reverse.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include "google/protobuf/stubs/logging.h"
+#include "absl/numeric/bits.h"
+#include "absl/strings/internal/resize_uninitialized.h"
+#include "google/protobuf/arenastring.h"
+#include "google/protobuf/extension_set.h"
+#include "google/protobuf/generated_message_tctable_decl.h"
+#include "google/protobuf/generated_message_tctable_impl.h"
+#include "google/protobuf/generated_message_tctable_serializer.h"
+#include "google/protobuf/io/coded_stream.h"
+#include "google/protobuf/message_lite.h"
+#include "google/protobuf/repeated_field.h"
+#include "google/protobuf/repeated_ptr_field.h"
+#include "google/protobuf/wire_format_lite.h"
+
+
+// clang-format off
+#include "google/protobuf/port_def.inc"
+// clang-format on
+
+namespace google {
+namespace protobuf {
+namespace internal {
+
+namespace {
+
+namespace fl = field_layout;
+
+constexpr size_t kMinBufferSize = 128;
+
+}  // namespace
+
+bool TcReverseSerializer::Serialize(const MessageLite& msg,
+                                    GetTableFunc get_table,
+                                    std::string* output) {
+  TcReverseSerializer serializer(get_table, output);
+  serializer.WriteMessage(msg, get_table(msg));
+  if (serializer.too_large_ || serializer.written() > INT_MAX) {
+    output->clear();
+    return false;
+  }
+  serializer.Finish();
+  return true;
+}
+
+TcReverseSerializer::TcReverseSerializer(GetTableFunc get_table,
+                                         std::string* output)
+    : get_table_(get_table), buffer_(output) {
+  // Whatever capacity the output already has is reused.
+  absl::strings_internal::STLStringResizeUninitialized(
+      output, std::max(output->capacity(), kMinBufferSize));
+  begin_ = &(*output)[0];
+  end_ = begin_ + output->size();
+  ptr_ = end_;
+}
+
+void TcReverseSerializer::Grow(size_t n) {
+  const size_t used = written();
+  const size_t size = std::max(2 * buffer_->size(), used + n);
+  std::string grown;
+  absl::strings_internal::STLStringResizeUninitialized(&grown, size);
+  char* begin = &grown[0];
+  memcpy(begin + size - used, ptr_, used);
+  buffer_->swap(grown);
+  begin_ = begin;
+  end_ = begin + size;
+  ptr_ = end_ - used;
+}
+
+void TcReverseSerializer::Finish() {
+  buffer_->erase(0, static_cast<size_t>(ptr_ - begin_));
+}
+
+void TcReverseSerializer::WriteRaw(const void* data, size_t size) {
+  Reserve(size);
+  ptr_ -= size;
+  memcpy(ptr_, data, size);
+}
+
+void TcReverseSerializer::WriteVarint(uint64_t value) {
+  const size_t size = io::CodedOutputStream::VarintSize64(value);
+  Reserve(size);
+  ptr_ -= size;
+  io::CodedOutputStream::WriteVarint64ToArray(value,
+                                              reinterpret_cast<uint8_t*>(ptr_));
+}
+
+template <typename T>
+void TcReverseSerializer::WriteFixed(T value) {
+  Reserve(sizeof(T));
+  ptr_ -= sizeof(T);
+  if (sizeof(T) == sizeof(uint32_t)) {
+    io::CodedOutputStream::WriteLittleEndian32ToArray(
+        static_cast<uint32_t>(value), reinterpret_cast<uint8_t*>(ptr_));
+  } else {
+    io::CodedOutputStream::WriteLittleEndian64ToArray(
+        static_cast<uint64_t>(value), reinterpret_cast<uint8_t*>(ptr_));
+  }
+}
+
+void TcReverseSerializer::WriteString(uint32_t number,
+                                      const std::string& value) {
+  WriteRaw(value.data(), value.size());
+  WriteVarint(value.size());
+  WriteTag(number, WireFormatLite::WIRETYPE_LENGTH_DELIMITED);
+}
+
+void TcReverseSerializer::WriteMessage(const MessageLite& msg,
+                                       const TcParseTableBase* table) {
+  if (table != nullptr && !msg._internal_metadata_.have_unknown_fields() &&
+      (table->extension_offset == 0 ||
+       TcParser::RefAt<ExtensionSet>(&msg, table->extension_offset)
+               .NumExtensions() == 0)) {
+    const size_t start = written();
+    if (PROTOBUF_PREDICT_TRUE(WriteFields(msg, table))) return;
+    // Drop the fields written so far and start over.
+    ptr_ = end_ - start;
+  }
+  WriteMessageForward(msg);
+}
+
+void TcReverseSerializer::WriteMessageForward(const MessageLite& msg) {
+  const size_t size = msg.ByteSizeLong();
+  if (size > INT_MAX) {
+    too_large_ = true;
+    return;
+  }
+  Reserve(size);
+  ptr_ -= size;
+  uint8_t* start = reinterpret_cast<uint8_t*>(ptr_);
+  io::EpsCopyOutputStream stream(
+      start, static_cast<int>(size),
+      io::CodedOutputStream::IsDefaultSerializationDeterministic());
+  uint8_t* end = msg._InternalSerialize(start, &stream);
+  GOOGLE_ABSL_DCHECK(end == start + size);
+  (void)end;
+}
+
+void TcReverseSerializer::WriteSubMessage(uint32_t number,
+                                          const MessageLite& msg, bool group) {
+  if (group) {
+    WriteTag(number, WireFormatLite::WIRETYPE_END_GROUP);
+    WriteMessage(msg, get_table_(msg));
+    WriteTag(number, WireFormatLite::WIRETYPE_START_GROUP);
+    return;
+  }
+  const size_t start = written();
+  WriteMessage(msg, get_table_(msg));
+  WriteVarint(written() - start);
+  WriteTag(number, WireFormatLite::WIRETYPE_LENGTH_DELIMITED);
+}
+
+bool TcReverseSerializer::WriteFields(const MessageLite& msg,
+                                      const TcParseTableBase* table) {
+  // Field entries are sorted by field number, so walking them backwards
+  // starts with the fields numbered above 32, which are described by the
+  // lookup table, and ends with those in skipmap32.
+  const FieldEntry* entry =
+      table->field_entries_begin() + table->num_field_entries;
+  if (!WriteLookupBlockFields(msg, table, table->field_lookup_begin(),
+                              entry)) {
+    return false;
+  }
+  uint32_t present = ~table->skipmap32;
+  while (present != 0) {
+    const int bit = 31 - absl::countl_zero(present);
+    present &= ~(uint32_t{1} << bit);
+    if (!WriteField(msg, table, *--entry, static_cast<uint32_t>(bit) + 1)) {
+      return false;
+    }
+  }
+  GOOGLE_ABSL_DCHECK(entry == table->field_entries_begin());
+  return true;
+}
+
+bool TcReverseSerializer::WriteLookupBlockFields(const MessageLite& msg,
+                                                 const TcParseTableBase* table,
+                                                 const uint16_t* lookup,
+                                                 const FieldEntry*& entry) {
+  // Each block is the first field number (32 bits), the number of skip
+  // entries, and for each group of 16 field numbers a 16-bit skipmap and a
+  // field entry offset.  The list ends with a first field number of
+  // 0xFFFFFFFF.  Later blocks hold higher field numbers, so they are written
+  // first.
+  const uint32_t first_fnum =
+      lookup[0] | (static_cast<uint32_t>(lookup[1]) << 16);
+  if (first_fnum == 0xFFFFFFFF) return true;
+  const uint16_t num_skip_entries = lookup[2];
+  const uint16_t* skip_entries = lookup + 3;
+  if (!WriteLookupBlockFields(msg, table, skip_entries + 2 * num_skip_entries,
+                              entry)) {
+    return false;
+  }
+  for (int i = num_skip_entries - 1; i >= 0; --i) {
+    uint32_t present = ~skip_entries[2 * i] & 0xFFFFu;
+    while (present != 0) {
+      const int bit = 31 - absl::countl_zero(present);
+      present &= ~(uint32_t{1} << bit);
+      const uint32_t number =
+          first_fnum + 16 * static_cast<uint32_t>(i) + static_cast<uint32_t>(bit);
+      if (!WriteField(msg, table, *--entry, number)) return false;
+    }
+  }
+  return true;
+}
+
+bool TcReverseSerializer::WriteField(const MessageLite& msg,
+                                     const TcParseTableBase* table,
+                                     const FieldEntry& entry,
+                                     uint32_t number) {
+  FieldEntry resolved = entry;
+  if (!TcSerializer::ResolveEntry(table, resolved)) return false;
+  if (!TcSerializer::IsPresent(msg, resolved, number)) return true;
+  const void* base = TcSerializer::FieldBase(msg, table, resolved);
+  switch (resolved.type_card & fl::kFkMask) {
+    case fl::kFkVarint:
+    case fl::kFkPackedVarint:
+      WriteVarintField(base, resolved, number);
+      return true;
+    case fl::kFkFixed:
+    case fl::kFkPackedFixed:
+      WriteFixedField(base, resolved, number);
+      return true;
+    case fl::kFkString:
+      return WriteStringField(base, table, resolved, number);
+    case fl::kFkMessage:
+      return WriteMessageField(base, resolved, number);
+    default:
+      // kFkMap.
+      return false;
+  }
+}
+
+void TcReverseSerializer::WriteVarintField(const void* base,
+                                           const FieldEntry& entry,
+                                           uint32_t number) {
+  const uint16_t type_card = entry.type_card;
+  const uint16_t card = type_card & fl::kFcMask;
+  if (card != fl::kFcRepeated) {
+    const uint64_t value = TcSerializer::LoadVarint(
+        static_cast<const char*>(base) + entry.offset, type_card);
+    // Without presence, only non-zero values are serialized.
+    if (card == fl::kFcSingular && value == 0) return;
+    WriteVarint(value);
+    WriteTag(number, WireFormatLite::WIRETYPE_VARINT);
+    return;
+  }
+
+  const bool packed = (type_card & fl::kFkMask) == fl::kFkPackedVarint;
+  auto write_repeated = [&](const auto& field) {
+    if (field.empty()) return;
+    const auto* data = field.data();
+    if (packed) {
+      const size_t start = written();
+      for (int i = field.size() - 1; i >= 0; --i) {
+        WriteVarint(TcSerializer::LoadVarint(&data[i], type_card));
+      }
+      WriteVarint(written() - start);
+      WriteTag(number, WireFormatLite::WIRETYPE_LENGTH_DELIMITED);
+    } else {
+      for (int i = field.size() - 1; i >= 0; --i) {
+        WriteVarint(TcSerializer::LoadVarint(&data[i], type_card));
+        WriteTag(number, WireFormatLite::WIRETYPE_VARINT);
+      }
+    }
+  };
+  switch (type_card & fl::kRepMask) {
+    case fl::kRep8Bits:
+      write_repeated(TcParser::RefAt<RepeatedField<bool>>(base, entry.offset));
+      break;
+    case fl::kRep32Bits:
+      write_repeated(
+          TcParser::RefAt<RepeatedField<uint32_t>>(base, entry.offset));
+      break;
+    default:
+      write_repeated(
+          TcParser::RefAt<RepeatedField<uint64_t>>(base, entry.offset));
+      break;
+  }
+}
+
+void TcReverseSerializer::WriteFixedField(const void* base,
+                                          const FieldEntry& entry,
+                                          uint32_t number) {
+  const uint16_t type_card = entry.type_card;
+  const uint16_t card = type_card & fl::kFcMask;
+  const bool is_64 = (type_card & fl::kRepMask) == fl::kRep64Bits;
+  const uint32_t wire_type = is_64 ? WireFormatLite::WIRETYPE_FIXED64
+                                   : WireFormatLite::WIRETYPE_FIXED32;
+  if (card != fl::kFcRepeated) {
+    const void* p = static_cast<const char*>(base) + entry.offset;
+    if (is_64) {
+      const uint64_t value = *static_cast<const uint64_t*>(p);
+      // Floating point values are compared by their bits, like the
+      // generated serializers do, so that -0.0 is serialized.
+      if (card == fl::kFcSingular && value == 0) return;
+      WriteFixed(value);
+    } else {
+      const uint32_t value = *static_cast<const uint32_t*>(p);
+      if (card == fl::kFcSingular && value == 0) return;
+      WriteFixed(value);
+    }
+    WriteTag(number, wire_type);
+    return;
+  }
+
+  const bool packed = (type_card & fl::kFkMask) == fl::kFkPackedFixed;
+  auto write_repeated = [&](const auto& field) {
+    if (field.empty()) return;
+    if (packed) {
+      const size_t start = written();
+#ifdef PROTOBUF_LITTLE_ENDIAN
+      WriteRaw(field.data(), field.size() * sizeof(field.Get(0)));
+#else
+      for (int i = field.size() - 1; i >= 0; --i) WriteFixed(field.Get(i));
+#endif
+      WriteVarint(written() - start);
+      WriteTag(number, WireFormatLite::WIRETYPE_LENGTH_DELIMITED);
+    } else {
+      for (int i = field.size() - 1; i >= 0; --i) {
+        WriteFixed(field.Get(i));
+        WriteTag(number, wire_type);
+      }
+    }
+  };
+  if (is_64) {
+    write_repeated(TcParser::RefAt<RepeatedField<uint64_t>>(base, entry.offset));
+  } else {
+    write_repeated(TcParser::RefAt<RepeatedField<uint32_t>>(base, entry.offset));
+  }
+}
+
+bool TcReverseSerializer::WriteStringField(const void* base,
+                                           const TcParseTableBase* table,
+                                           const FieldEntry& entry,
+                                           uint32_t number) {
+  const uint16_t type_card = entry.type_card;
+  const uint16_t card = type_card & fl::kFcMask;
+  const uint16_t rep = type_card & fl::kRepMask;
+  if (card == fl::kFcRepeated) {
+    if (rep != fl::kRepSString) return false;
+    const auto& field =
+        TcParser::RefAt<RepeatedPtrField<std::string>>(base, entry.offset);
+    for (int i = field.size() - 1; i >= 0; --i) {
+      TcSerializer::VerifyUtf8(field.Get(i), table, entry);
+      WriteString(number, field.Get(i));
+    }
+    return true;
+  }
+
+  // Inlined strings are tagged as kRepAString but carry an aux entry with
+  // their donation state index.
+  if (rep != fl::kRepAString || entry.aux_idx != 0) return false;
+  const std::string& value =
+      TcParser::RefAt<ArenaStringPtr>(base, entry.offset).Get();
+  if (card == fl::kFcSingular && value.empty()) return true;
+  TcSerializer::VerifyUtf8(value, table, entry);
+  WriteString(number, value);
+  return true;
+}
+
+bool TcReverseSerializer::WriteMessageField(const void* base,
+                                            const FieldEntry& entry,
+                                            uint32_t number) {
+  const uint16_t type_card = entry.type_card;
+  const uint16_t rep = type_card & fl::kRepMask;
+  const bool group = rep == fl::kRepGroup;
+  // Like the parser, leave lazy fields to the generated code when they are
+  // present.
+  if ((type_card & fl::kFcMask) == fl::kFcRepeated) {
+    const auto& field =
+        TcParser::RefAt<RepeatedPtrField<MessageLite>>(base, entry.offset);
+    if (field.empty()) return true;
+    if (rep == fl::kRepLazy) return false;
+    for (int i = field.size() - 1; i >= 0; --i) {
+      WriteSubMessage(number, field.Get(i), group);
+    }
+    return true;
+  }
+  // A singular lazy field is a LazyField, not a message pointer.
+  if (rep == fl::kRepLazy) return false;
+  const MessageLite* msg =
+      TcParser::RefAt<const MessageLite*>(base, entry.offset);
+  if (msg == nullptr) return true;
+  WriteSubMessage(number, *msg, group);
+  return true;
+}
+
+}  // namespace internal
+}  // namespace protobuf
+}  // namespace google
+
+#include "google/protobuf/port_undef.inc"
@@ -0,0 +1,140 @@
+// Protocol Buffers - Google's data interchange format
+// Copyright 2008 Google Inc.  All rights reserved.
+// https://developers.google.com/protocol-buffers/
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// This file contains an experimental serializer that writes messages back to
+// front, driven by the tables of the table-driven parser.  It is not used by
+// any public API; see WireFormat::SerializeReverse().
+
+#ifndef GOOGLE_PROTOBUF_GENERATED_MESSAGE_TCTABLE_REVERSE_H__
+#define GOOGLE_PROTOBUF_GENERATED_MESSAGE_TCTABLE_REVERSE_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "google/protobuf/generated_message_tctable_decl.h"
+#include "google/protobuf/message_lite.h"
+
+// Must come last:
+#include "google/protobuf/port_def.inc"
+
+namespace google {
+namespace protobuf {
+namespace internal {
+
+// Serializes messages back to front, visiting the fields described by each
+// message's TcParseTableBase from the highest field number to the lowest.
+// Every field is written in front of the fields that follow it, so by the time
+// a length prefix is needed the sub-message it covers has already been
+// written: there is no ByteSizeLong() pass, and cached sizes are neither read
+// nor written.  The output is the same as that of _InternalSerialize().
+//
+// A message is serialized forward instead, with ByteSizeLong() and
+// _InternalSerialize() into the space in front of what has been written so
+// far, if it has no table, has unknown fields or extensions, or has a field
+// set that the table does not describe well enough to encode (maps, lazy and
+// weak fields).
+class PROTOBUF_EXPORT TcReverseSerializer {
+ public:
+  // Returns the table to serialize `msg` with, or nullptr if `msg` has none.
+  using GetTableFunc = const TcParseTableBase* (*)(const MessageLite& msg);
+
+  // Replaces the contents of `output` with the serialization of `msg`, using
+  // `get_table` to find the tables of `msg` and its sub-messages.  Returns
+  // false if the serialization would exceed 2GB.
+  static bool Serialize(const MessageLite& msg, GetTableFunc get_table,
+                        std::string* output);
+
+ private:
+  using FieldEntry = TcParseTableBase::FieldEntry;
+
+  TcReverseSerializer(GetTableFunc get_table, std::string* output);
+
+  // Number of bytes written so far.  Positions within the output are kept as
+  // values of written(), which unlike pointers survive the buffer growing.
+  size_t written() const { return static_cast<size_t>(end_ - ptr_); }
+
+  // Makes room for `n` more bytes in front of the output.
+  void Reserve(size_t n) {
+    if (PROTOBUF_PREDICT_FALSE(static_cast<size_t>(ptr_ - begin_) < n)) {
+      Grow(n);
+    }
+  }
+  void Grow(size_t n);
+  // Moves the output to the start of the buffer.
+  void Finish();
+
+  void WriteRaw(const void* data, size_t size);
+  void WriteVarint(uint64_t value);
+  template <typename T>
+  void WriteFixed(T value);
+  void WriteTag(uint32_t number, uint32_t wire_type) {
+    WriteVarint((number << 3) | wire_type);
+  }
+  void WriteString(uint32_t number, const std::string& value);
+
+  // Writes the contents of `msg`, without tag or length.
+  void WriteMessage(const MessageLite& msg, const TcParseTableBase* table);
+  void WriteMessageForward(const MessageLite& msg);
+  void WriteSubMessage(uint32_t number, const MessageLite& msg, bool group);
+
+  // These return false if they find a field they cannot encode.
+  bool WriteFields(const MessageLite& msg, const TcParseTableBase* table);
+  bool WriteLookupBlockFields(const MessageLite& msg,
+                              const TcParseTableBase* table,
+                              const uint16_t* lookup,
+                              const FieldEntry*& entry);
+  bool WriteField(const MessageLite& msg, const TcParseTableBase* table,
+                  const FieldEntry& entry, uint32_t number);
+
+  void WriteVarintField(const void* base, const FieldEntry& entry,
+                        uint32_t number);
+  void WriteFixedField(const void* base, const FieldEntry& entry,
+                       uint32_t number);
+  bool WriteStringField(const void* base, const TcParseTableBase* table,
+                        const FieldEntry& entry, uint32_t number);
+  bool WriteMessageField(const void* base, const FieldEntry& entry,
+                         uint32_t number);
+
+  GetTableFunc get_table_;
+  std::string* buffer_;
+  char* begin_;
+  char* ptr_;  // The output is [ptr_, end_).
+  char* end_;
+  bool too_large_ = false;
+};
+
+}  // namespace internal
+}  // namespace protobuf
+}  // namespace google
+
+#include "google/protobuf/port_undef.inc"
+
+#endif  // GOOGLE_PROTOBUF_GENERATED_MESSAGE_TCTABLE_REVERSE_H__
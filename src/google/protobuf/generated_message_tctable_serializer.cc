@@ -0,0 +1,440 @@
+// Protocol Buffers - Google's data interchange format
+// Copyright 2008 Google Inc.  All rights reserved.
+// https://developers.google.com/protocol-buffers/
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "google/protobuf/generated_message_tctable_serializer.h"
+
+#include <cstdint>
+#include <string>
+
+#include "google/protobuf/stubs/logging.h"
+#include "absl/numeric/bits.h"
+#include "absl/strings/string_view.h"
+#include "google/protobuf/arenastring.h"
+#include "google/protobuf/extension_set.h"
+#include "google/protobuf/generated_message_tctable_decl.h"
+#include "google/protobuf/generated_message_tctable_impl.h"
+#include "google/protobuf/inlined_string_field.h"
+#include "google/protobuf/io/coded_stream.h"
+#include "google/protobuf/message_lite.h"
+#include "google/protobuf/repeated_field.h"
+#include "google/protobuf/repeated_ptr_field.h"
+#include "google/protobuf/wire_format_lite.h"
+#include "utf8_validity.h"
+
+
+// clang-format off
+#include "google/protobuf/port_def.inc"
+// clang-format on
+
+namespace google {
+namespace protobuf {
+namespace internal {
+
+// Defined in wire_format_lite.cc
+void PrintUTF8ErrorLog(absl::string_view message_name,
+                       absl::string_view field_name, const char* operation_str,
+                       bool emit_stacktrace);
+
+namespace {
+
+namespace fl = field_layout;
+
+inline uint8_t* WriteTag(uint32_t number, WireFormatLite::WireType wire_type,
+                         uint8_t* target) {
+  return WireFormatLite::WriteTagToArray(static_cast<int>(number), wire_type,
+                                         target);
+}
+
+}  // namespace
+
+bool TcSerializer::ResolveEntry(const TcParseTableBase* table,
+                                FieldEntry& entry) {
+  if ((entry.type_card & fl::kFkMask) != fl::kFkNone) return true;
+  // Weak fields have no offset.
+  if (entry.offset == 0) return false;
+  entry.type_card = table->field_aux(&entry)->fallback_type_card;
+  GOOGLE_ABSL_DCHECK_NE(entry.type_card & fl::kFkMask, +fl::kFkNone);
+  return true;
+}
+
+bool TcSerializer::IsPresent(const MessageLite& msg, const FieldEntry& entry,
+                             uint32_t number) {
+  const uint16_t card = entry.type_card & fl::kFcMask;
+  if (card == fl::kFcOptional) {
+    // has_idx counts bits from the start of the message.
+    const uint32_t has_idx = static_cast<uint32_t>(entry.has_idx);
+    const uint32_t has_bits =
+        TcParser::RefAt<uint32_t>(&msg, has_idx / 32 * 4);
+    return (has_bits & (uint32_t{1} << (has_idx % 32))) != 0;
+  }
+  if (card == fl::kFcOneof) {
+    return TcParser::RefAt<uint32_t>(&msg, entry.has_idx) == number;
+  }
+  return true;
+}
+
+const void* TcSerializer::FieldBase(const MessageLite& msg,
+                                    const TcParseTableBase* table,
+                                    const FieldEntry& entry) {
+  if ((entry.type_card & fl::kSplitMask) == fl::kSplitTrue) {
+    return TcParser::RefAt<const void*>(
+        &msg, table->field_aux(kSplitOffsetAuxIdx)->offset);
+  }
+  return &msg;
+}
+
+uint64_t TcSerializer::LoadVarint(const void* p, uint16_t type_card) {
+  switch (type_card & fl::kRepMask) {
+    case fl::kRep8Bits:
+      return *static_cast<const uint8_t*>(p);
+    case fl::kRep32Bits: {
+      const uint32_t value = *static_cast<const uint32_t*>(p);
+      if ((type_card & fl::kTvMask) == fl::kTvZigZag) {
+        return WireFormatLite::ZigZagEncode32(static_cast<int32_t>(value));
+      }
+      const uint16_t format = type_card & fl::kFmtMask;
+      if (format == fl::kFmtSigned || format == fl::kFmtEnum) {
+        // Negative int32 and enum values are sign-extended to 10 bytes.
+        return static_cast<uint64_t>(static_cast<int32_t>(value));
+      }
+      return value;
+    }
+    default: {
+      const uint64_t value = *static_cast<const uint64_t*>(p);
+      if ((type_card & fl::kTvMask) == fl::kTvZigZag) {
+        return WireFormatLite::ZigZagEncode64(static_cast<int64_t>(value));
+      }
+      return value;
+    }
+  }
+}
+
+void TcSerializer::VerifyUtf8(const std::string& value,
+                              const TcParseTableBase* table,
+                              const FieldEntry& entry) {
+  const uint16_t xform_val = entry.type_card & fl::kTvMask;
+  bool verify = xform_val == fl::kTvUtf8;
+#ifndef NDEBUG
+  verify |= xform_val == fl::kTvUtf8Debug;
+#endif  // NDEBUG
+  if (verify && !utf8_range::IsStructurallyValid(value)) {
+    PrintUTF8ErrorLog(TcParser::MessageName(table),
+                      TcParser::FieldName(table, &entry), "serializing", false);
+  }
+}
+
+uint8_t* TcSerializer::SerializeFields(const MessageLite& msg,
+                                       const TcParseTableBase* table,
+                                       uint8_t* target,
+                                       io::EpsCopyOutputStream* stream) {
+  // Extensions are written before the first field above their range, like
+  // generated code does.
+  bool extensions_pending = table->extension_offset != 0;
+  const FieldEntry* entry = table->field_entries_begin();
+  uint32_t present = ~table->skipmap32;
+  while (present != 0) {
+    const int bit = absl::countr_zero(present);
+    present &= present - 1;
+    const uint32_t number = static_cast<uint32_t>(bit) + 1;
+    if (extensions_pending && number > table->extension_range_low) {
+      target = SerializeExtensions(msg, table, target, stream);
+      extensions_pending = false;
+    }
+    target = SerializeField(msg, table, *entry++, number, target, stream);
+  }
+  target = SerializeLookupBlockFields(msg, table, entry, extensions_pending,
+                                      target, stream);
+  GOOGLE_ABSL_DCHECK(entry ==
+                     table->field_entries_begin() + table->num_field_entries);
+  if (extensions_pending) {
+    target = SerializeExtensions(msg, table, target, stream);
+  }
+  return target;
+}
+
+uint8_t* TcSerializer::SerializeLookupBlockFields(
+    const MessageLite& msg, const TcParseTableBase* table,
+    const FieldEntry*& entry, bool& extensions_pending, uint8_t* target,
+    io::EpsCopyOutputStream* stream) {
+  // Each block is the first field number (32 bits), the number of skip
+  // entries, and for each group of 16 field numbers a 16-bit skipmap and a
+  // field entry offset.  The list ends with a first field number of
+  // 0xFFFFFFFF.
+  for (const uint16_t* lookup = table->field_lookup_begin();;) {
+    const uint32_t first_fnum =
+        lookup[0] | (static_cast<uint32_t>(lookup[1]) << 16);
+    if (first_fnum == 0xFFFFFFFF) return target;
+    const uint16_t num_skip_entries = lookup[2];
+    const uint16_t* skip_entries = lookup + 3;
+    for (uint16_t i = 0; i < num_skip_entries; ++i) {
+      uint32_t present = ~skip_entries[2 * i] & 0xFFFFu;
+      while (present != 0) {
+        const int bit = absl::countr_zero(present);
+        present &= present - 1;
+        const uint32_t number =
+            first_fnum + 16 * uint32_t{i} + static_cast<uint32_t>(bit);
+        if (extensions_pending && number > table->extension_range_low) {
+          target = SerializeExtensions(msg, table, target, stream);
+          extensions_pending = false;
+        }
+        target = SerializeField(msg, table, *entry++, number, target, stream);
+      }
+    }
+    lookup = skip_entries + 2 * num_skip_entries;
+  }
+}
+
+uint8_t* TcSerializer::SerializeExtensions(const MessageLite& msg,
+                                           const TcParseTableBase* table,
+                                           uint8_t* target,
+                                           io::EpsCopyOutputStream* stream) {
+  // Generated tables hold the end of the range, which is exclusive, in
+  // extension_range_high.  No extension can have that number, so treating
+  // it as inclusive like the parser does is harmless.
+  return TcParser::RefAt<ExtensionSet>(&msg, table->extension_offset)
+      ._InternalSerialize(table->default_instance,
+                          static_cast<int>(table->extension_range_low),
+                          static_cast<int>(table->extension_range_high) + 1,
+                          target, stream);
+}
+
+uint8_t* TcSerializer::SerializeField(const MessageLite& msg,
+                                      const TcParseTableBase* table,
+                                      FieldEntry entry, uint32_t number,
+                                      uint8_t* target,
+                                      io::EpsCopyOutputStream* stream) {
+  if (!ResolveEntry(table, entry)) {
+    GOOGLE_ABSL_LOG(DFATAL) << "Field " << number << " of "
+                            << TcParser::MessageName(table)
+                            << " cannot be serialized from its table.";
+    return target;
+  }
+  if (!IsPresent(msg, entry, number)) return target;
+  const void* base = FieldBase(msg, table, entry);
+  switch (entry.type_card & fl::kFkMask) {
+    case fl::kFkVarint:
+    case fl::kFkPackedVarint:
+      return SerializeVarintField(base, entry, number, target, stream);
+    case fl::kFkFixed:
+    case fl::kFkPackedFixed:
+      return SerializeFixedField(base, entry, number, target, stream);
+    case fl::kFkString:
+      return SerializeStringField(base, table, entry, number, target, stream);
+    case fl::kFkMessage:
+      return SerializeMessageField(base, entry, number, target, stream);
+    default:
+      GOOGLE_ABSL_LOG(DFATAL) << "Map field " << number << " of "
+                              << TcParser::MessageName(table)
+                              << " cannot be serialized from its table.";
+      return target;
+  }
+}
+
+uint8_t* TcSerializer::SerializeVarintField(const void* base,
+                                            const FieldEntry& entry,
+                                            uint32_t number, uint8_t* target,
+                                            io::EpsCopyOutputStream* stream) {
+  const uint16_t type_card = entry.type_card;
+  const uint16_t card = type_card & fl::kFcMask;
+  if (card != fl::kFcRepeated) {
+    const uint64_t value =
+        LoadVarint(static_cast<const char*>(base) + entry.offset, type_card);
+    // Without presence, only non-zero values are serialized.
+    if (card == fl::kFcSingular && value == 0) return target;
+    target = stream->EnsureSpace(target);
+    target = WriteTag(number, WireFormatLite::WIRETYPE_VARINT, target);
+    return io::CodedOutputStream::WriteVarint64ToArray(value, target);
+  }
+
+  const bool packed = (type_card & fl::kFkMask) == fl::kFkPackedVarint;
+  auto write_repeated = [&](const auto& field) {
+    if (field.empty()) return target;
+    const auto* data = field.data();
+    if (packed) {
+      // The generated code caches the packed size in the message, but the
+      // table does not say where, so it is computed here.
+      size_t size = 0;
+      for (int i = 0; i < field.size(); ++i) {
+        size += io::CodedOutputStream::VarintSize64(
+            LoadVarint(&data[i], type_card));
+      }
+      target = stream->EnsureSpace(target);
+      target =
+          WriteTag(number, WireFormatLite::WIRETYPE_LENGTH_DELIMITED, target);
+      target = io::CodedOutputStream::WriteVarint32ToArray(
+          static_cast<uint32_t>(size), target);
+      for (int i = 0; i < field.size(); ++i) {
+        target = stream->EnsureSpace(target);
+        target = io::CodedOutputStream::WriteVarint64ToArray(
+            LoadVarint(&data[i], type_card), target);
+      }
+    } else {
+      for (int i = 0; i < field.size(); ++i) {
+        target = stream->EnsureSpace(target);
+        target = WriteTag(number, WireFormatLite::WIRETYPE_VARINT, target);
+        target = io::CodedOutputStream::WriteVarint64ToArray(
+            LoadVarint(&data[i], type_card), target);
+      }
+    }
+    return target;
+  };
+  switch (type_card & fl::kRepMask) {
+    case fl::kRep8Bits:
+      return write_repeated(
+          TcParser::RefAt<RepeatedField<bool>>(base, entry.offset));
+    case fl::kRep32Bits:
+      return write_repeated(
+          TcParser::RefAt<RepeatedField<uint32_t>>(base, entry.offset));
+    default:
+      return write_repeated(
+          TcParser::RefAt<RepeatedField<uint64_t>>(base, entry.offset));
+  }
+}
+
+uint8_t* TcSerializer::SerializeFixedField(const void* base,
+                                           const FieldEntry& entry,
+                                           uint32_t number, uint8_t* target,
+                                           io::EpsCopyOutputStream* stream) {
+  const uint16_t type_card = entry.type_card;
+  const uint16_t card = type_card & fl::kFcMask;
+  const bool is_64 = (type_card & fl::kRepMask) == fl::kRep64Bits;
+  const WireFormatLite::WireType wire_type =
+      is_64 ? WireFormatLite::WIRETYPE_FIXED64
+            : WireFormatLite::WIRETYPE_FIXED32;
+  if (card != fl::kFcRepeated) {
+    const void* p = static_cast<const char*>(base) + entry.offset;
+    // Floating point values are compared by their bits, like the generated
+    // serializers do, so that -0.0 is serialized.
+    if (is_64) {
+      const uint64_t value = *static_cast<const uint64_t*>(p);
+      if (card == fl::kFcSingular && value == 0) return target;
+      target = stream->EnsureSpace(target);
+      target = WriteTag(number, wire_type, target);
+      return io::CodedOutputStream::WriteLittleEndian64ToArray(value, target);
+    }
+    const uint32_t value = *static_cast<const uint32_t*>(p);
+    if (card == fl::kFcSingular && value == 0) return target;
+    target = stream->EnsureSpace(target);
+    target = WriteTag(number, wire_type, target);
+    return io::CodedOutputStream::WriteLittleEndian32ToArray(value, target);
+  }
+
+  const bool packed = (type_card & fl::kFkMask) == fl::kFkPackedFixed;
+  auto write_repeated = [&](const auto& field) {
+    if (field.empty()) return target;
+    if (packed) {
+      return stream->WriteFixedPacked(static_cast<int>(number), field, target);
+    }
+    for (int i = 0; i < field.size(); ++i) {
+      target = stream->EnsureSpace(target);
+      target = WriteTag(number, wire_type, target);
+      if (is_64) {
+        target = io::CodedOutputStream::WriteLittleEndian64ToArray(
+            static_cast<uint64_t>(field.Get(i)), target);
+      } else {
+        target = io::CodedOutputStream::WriteLittleEndian32ToArray(
+            static_cast<uint32_t>(field.Get(i)), target);
+      }
+    }
+    return target;
+  };
+  if (is_64) {
+    return write_repeated(
+        TcParser::RefAt<RepeatedField<uint64_t>>(base, entry.offset));
+  }
+  return write_repeated(
+      TcParser::RefAt<RepeatedField<uint32_t>>(base, entry.offset));
+}
+
+uint8_t* TcSerializer::SerializeStringField(const void* base,
+                                            const TcParseTableBase* table,
+                                            const FieldEntry& entry,
+                                            uint32_t number, uint8_t* target,
+                                            io::EpsCopyOutputStream* stream) {
+  const uint16_t type_card = entry.type_card;
+  const uint16_t card = type_card & fl::kFcMask;
+  if (card == fl::kFcRepeated) {
+    GOOGLE_ABSL_DCHECK_EQ(type_card & fl::kRepMask, +fl::kRepSString);
+    const auto& field =
+        TcParser::RefAt<RepeatedPtrField<std::string>>(base, entry.offset);
+    for (int i = 0; i < field.size(); ++i) {
+      VerifyUtf8(field.Get(i), table, entry);
+      target = stream->WriteString(number, field.Get(i), target);
+    }
+    return target;
+  }
+
+  GOOGLE_ABSL_DCHECK_EQ(type_card & fl::kRepMask, +fl::kRepAString);
+  // Inlined strings are tagged as kRepAString but carry an aux entry with
+  // their donation state index.
+  const std::string& value =
+      entry.aux_idx == 0
+          ? TcParser::RefAt<ArenaStringPtr>(base, entry.offset).Get()
+          : TcParser::RefAt<InlinedStringField>(base, entry.offset).Get();
+  if (card == fl::kFcSingular && value.empty()) return target;
+  VerifyUtf8(value, table, entry);
+  return stream->WriteString(number, value, target);
+}
+
+uint8_t* TcSerializer::SerializeMessageField(const void* base,
+                                             const FieldEntry& entry,
+                                             uint32_t number, uint8_t* target,
+                                             io::EpsCopyOutputStream* stream) {
+  const uint16_t type_card = entry.type_card;
+  const uint16_t rep = type_card & fl::kRepMask;
+  const int field_number = static_cast<int>(number);
+  auto write = [&](const MessageLite& value) {
+    // Tables built by reflection describe lazy fields too; only empty ones
+    // can be serialized from the table.
+    GOOGLE_ABSL_DCHECK_NE(rep, +fl::kRepLazy);
+    if (rep == fl::kRepGroup) {
+      return WireFormatLite::InternalWriteGroup(field_number, value, target,
+                                                stream);
+    }
+    return WireFormatLite::InternalWriteMessage(
+        field_number, value, value.GetCachedSize(), target, stream);
+  };
+  if ((type_card & fl::kFcMask) == fl::kFcRepeated) {
+    const auto& field =
+        TcParser::RefAt<RepeatedPtrField<MessageLite>>(base, entry.offset);
+    for (int i = 0; i < field.size(); ++i) target = write(field.Get(i));
+    return target;
+  }
+  const MessageLite* value =
+      TcParser::RefAt<const MessageLite*>(base, entry.offset);
+  if (value == nullptr) return target;
+  return write(*value);
+}
+
+}  // namespace internal
+}  // namespace protobuf
+}  // namespace google
+
+#include "google/protobuf/port_undef.inc"
@@ -0,0 +1,139 @@
+// Protocol Buffers - Google's data interchange format
+// Copyright 2008 Google Inc.  All rights reserved.
+// https://developers.google.com/protocol-buffers/
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// This file contains the serializer counterpart of the table-driven parser:
+// it writes a message's fields by walking the same tables.
+
+#ifndef GOOGLE_PROTOBUF_GENERATED_MESSAGE_TCTABLE_SERIALIZER_H__
+#define GOOGLE_PROTOBUF_GENERATED_MESSAGE_TCTABLE_SERIALIZER_H__
+
+#include <cstdint>
+#include <string>
+
+#include "google/protobuf/generated_message_tctable_decl.h"
+#include "google/protobuf/message_lite.h"
+
+// Must come last:
+#include "google/protobuf/port_def.inc"
+
+namespace google {
+namespace protobuf {
+namespace io {
+class EpsCopyOutputStream;
+}  // namespace io
+namespace internal {
+
+// Serializes messages by walking the field entries of their TcParseTableBase
+// in field number order, rather than with per-message generated code.
+// Messages generated with experimental_table_driven_serialization implement
+// _InternalSerialize() with it, so a single copy of the serialization code is
+// shared by all of them.
+class PROTOBUF_EXPORT TcSerializer {
+ public:
+  // Writes the fields of `msg` described by `table`, along with the
+  // extensions in the range it describes, in the same order as generated
+  // _InternalSerialize() does.  Unknown fields are left to the caller.  Like
+  // _InternalSerialize(), this relies on the sizes cached by ByteSizeLong()
+  // for sub-messages.
+  //
+  // Every field in `table` must be one the generator allows table-driven
+  // serialization for: map, weak and lazy fields are not supported.
+  static uint8_t* SerializeFields(const MessageLite& msg,
+                                  const TcParseTableBase* table,
+                                  uint8_t* target,
+                                  io::EpsCopyOutputStream* stream);
+
+ private:
+  friend class TcReverseSerializer;
+  using FieldEntry = TcParseTableBase::FieldEntry;
+
+  // Tables built by reflection give enum fields that need a validator no
+  // kind; their type card is kept in FieldAux::fallback_type_card.  Returns
+  // false if `entry` describes no field that can be serialized from the table,
+  // like weak fields.
+  static bool ResolveEntry(const TcParseTableBase* table, FieldEntry& entry);
+  // Whether the field is set, for fields with a has-bit or in a oneof.
+  // Singular fields without presence are always "present" here, and are
+  // skipped later if they hold the default value.
+  static bool IsPresent(const MessageLite& msg, const FieldEntry& entry,
+                        uint32_t number);
+  // Returns the object the field's offset is relative to.
+  static const void* FieldBase(const MessageLite& msg,
+                               const TcParseTableBase* table,
+                               const FieldEntry& entry);
+  // Loads the value of a varint field stored with the representation given by
+  // `type_card`, converted to what goes on the wire.
+  static uint64_t LoadVarint(const void* p, uint16_t type_card);
+  static void VerifyUtf8(const std::string& value,
+                         const TcParseTableBase* table,
+                         const FieldEntry& entry);
+
+  static uint8_t* SerializeLookupBlockFields(const MessageLite& msg,
+                                             const TcParseTableBase* table,
+                                             const FieldEntry*& entry,
+                                             bool& extensions_pending,
+                                             uint8_t* target,
+                                             io::EpsCopyOutputStream* stream);
+  static uint8_t* SerializeExtensions(const MessageLite& msg,
+                                      const TcParseTableBase* table,
+                                      uint8_t* target,
+                                      io::EpsCopyOutputStream* stream);
+  static uint8_t* SerializeField(const MessageLite& msg,
+                                 const TcParseTableBase* table,
+                                 FieldEntry entry, uint32_t number,
+                                 uint8_t* target,
+                                 io::EpsCopyOutputStream* stream);
+
+  static uint8_t* SerializeVarintField(const void* base,
+                                       const FieldEntry& entry,
+                                       uint32_t number, uint8_t* target,
+                                       io::EpsCopyOutputStream* stream);
+  static uint8_t* SerializeFixedField(const void* base,
+                                      const FieldEntry& entry,
+                                      uint32_t number, uint8_t* target,
+                                      io::EpsCopyOutputStream* stream);
+  static uint8_t* SerializeStringField(const void* base,
+                                       const TcParseTableBase* table,
+                                       const FieldEntry& entry,
+                                       uint32_t number, uint8_t* target,
+                                       io::EpsCopyOutputStream* stream);
+  static uint8_t* SerializeMessageField(const void* base,
+                                        const FieldEntry& entry,
+                                        uint32_t number, uint8_t* target,
+                                        io::EpsCopyOutputStream* stream);
+};
+
+}  // namespace internal
+}  // namespace protobuf
+}  // namespace google
+
+#include "google/protobuf/port_undef.inc"
+
+#endif  // GOOGLE_PROTOBUF_GENERATED_MESSAGE_TCTABLE_SERIALIZER_H__
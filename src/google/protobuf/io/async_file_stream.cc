@@ -0,0 +1,719 @@
+// Protocol Buffers - Google's data interchange format
+// Copyright 2008 Google Inc.  All rights reserved.
+// https://developers.google.com/protocol-buffers/
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "google/protobuf/io/async_file_stream.h"
+
+#ifndef _MSC_VER
+#include <fcntl.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif
+#ifndef _WIN32
+#include <poll.h>
+#endif
+#include <errno.h>
+#include <string.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "google/protobuf/stubs/logging.h"
+#include "absl/synchronization/mutex.h"
+#include "google/protobuf/io/io_win32.h"
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#define HAVE_IO_URING 1
+#endif
+#endif
+#endif
+
+// Must be included last.
+#include "google/protobuf/port_def.inc"
+
+namespace google {
+namespace protobuf {
+namespace internal {
+
+// Performs the reads and writes of an async file stream.  Requests are
+// identified by an id below the capacity given at creation, and each id has at
+// most one request outstanding.  Writes always complete in full unless an
+// error occurs.
+class AsyncFileIo {
+ public:
+  enum Op { kRead, kWrite };
+
+  virtual ~AsyncFileIo() = default;
+
+  virtual bool is_io_uring() const { return false; }
+
+  // Starts transferring `size` bytes between `data` and the file at `offset`,
+  // or at the current file position if `offset` is -1.  `data` must stay
+  // valid until Wait(id) returns.
+  virtual void Submit(int id, Op op, char* data, size_t size,
+                      int64_t offset) = 0;
+
+  // Waits for the request `id` and returns the number of bytes transferred,
+  // or -errno on failure.
+  virtual int64_t Wait(int id) = 0;
+};
+
+}  // namespace internal
+
+namespace io {
+
+#ifdef _WIN32
+// DO NOT include <io.h>, instead create functions in io_win32.{h,cc} and import
+// them like we do below.
+using google::protobuf::io::win32::close;
+using google::protobuf::io::win32::read;
+using google::protobuf::io::win32::write;
+#endif
+
+namespace {
+
+using internal::AsyncFileIo;
+
+// EINTR sucks.
+int close_no_eintr(int fd) {
+  int result;
+  do {
+    result = close(fd);
+  } while (result < 0 && errno == EINTR);
+  return result;
+}
+
+// Returns the current offset of `fd`, or -1 if it should be accessed
+// sequentially.
+int64_t SeekableOffset(int fd, bool for_write) {
+#ifdef _WIN32
+  (void)fd;
+  (void)for_write;
+  return -1;
+#else
+  // Writes to O_APPEND descriptors ignore the offset.
+  if (for_write && (fcntl(fd, F_GETFL) & O_APPEND) != 0) return -1;
+  off_t offset = lseek(fd, 0, SEEK_CUR);
+  return offset == static_cast<off_t>(-1) ? -1 : offset;
+#endif
+}
+
+void SeekTo(int fd, int64_t offset) {
+#ifndef _WIN32
+  lseek(fd, static_cast<off_t>(offset), SEEK_SET);
+#endif
+}
+
+// Blocking read or write.  Writes are retried until all of `data` is written.
+int64_t Transfer(int fd, AsyncFileIo::Op op, char* data, size_t size,
+                 int64_t offset) {
+  size_t done = 0;
+  do {
+    int64_t result;
+    do {
+      if (op == AsyncFileIo::kRead) {
+#ifndef _WIN32
+        result = offset >= 0 ? pread(fd, data, size, offset)
+                             : read(fd, data, size);
+#else
+        result = read(fd, data, size);
+#endif
+      } else {
+#ifndef _WIN32
+        result = offset >= 0 ? pwrite(fd, data + done, size - done,
+                                      offset + static_cast<int64_t>(done))
+                             : write(fd, data + done, size - done);
+#else
+        result = write(fd, data + done, size - done);
+#endif
+      }
+    } while (result < 0 && errno == EINTR);
+#ifndef _WIN32
+    if (result < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+      // The descriptor is non-blocking.  Its flags belong to the caller, so
+      // wait for it to become ready instead of changing them.
+      pollfd ready = {
+          fd, static_cast<short>(op == AsyncFileIo::kRead ? POLLIN : POLLOUT),
+          0};
+      if (poll(&ready, 1, -1) < 0 && errno != EINTR) return -errno;
+      continue;
+    }
+#endif
+    if (result < 0) return -errno;
+    if (op == AsyncFileIo::kRead) return result;
+    done += static_cast<size_t>(result);
+  } while (done < size);
+  return static_cast<int64_t>(done);
+}
+
+// Performs each request when it is submitted.
+class BlockingFileIo final : public AsyncFileIo {
+ public:
+  BlockingFileIo(int fd, int capacity) : fd_(fd), results_(capacity) {}
+
+  void Submit(int id, Op op, char* data, size_t size,
+              int64_t offset) override {
+    results_[id] = Transfer(fd_, op, data, size, offset);
+  }
+
+  int64_t Wait(int id) override { return results_[id]; }
+
+ private:
+  const int fd_;
+  std::vector<int64_t> results_;
+};
+
+// Performs requests in submission order on a background thread, which is
+// started by the first request.
+class ThreadFileIo final : public AsyncFileIo {
+ public:
+  ThreadFileIo(int fd, int capacity) : fd_(fd), requests_(capacity) {}
+
+  ~ThreadFileIo() override {
+    {
+      absl::MutexLock lock(&mu_);
+      shutdown_ = true;
+    }
+    if (thread_.joinable()) thread_.join();
+  }
+
+  void Submit(int id, Op op, char* data, size_t size,
+              int64_t offset) override {
+    absl::MutexLock lock(&mu_);
+    requests_[id] = {op, data, size, offset, false, 0};
+    queue_.push_back(id);
+    if (!thread_.joinable()) thread_ = std::thread(&ThreadFileIo::Run, this);
+  }
+
+  int64_t Wait(int id) override {
+    absl::MutexLock lock(&mu_);
+    Request& request = requests_[id];
+    mu_.Await(absl::Condition(&request.complete));
+    return request.result;
+  }
+
+ private:
+  struct Request {
+    Op op;
+    char* data;
+    size_t size;
+    int64_t offset;
+    bool complete;
+    int64_t result;
+  };
+
+  bool HasWork() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+    return shutdown_ || !queue_.empty();
+  }
+
+  void Run() {
+    while (true) {
+      int id;
+      Request request;
+      {
+        absl::MutexLock lock(&mu_);
+        mu_.Await(absl::Condition(this, &ThreadFileIo::HasWork));
+        if (queue_.empty()) return;
+        id = queue_.front();
+        queue_.pop_front();
+        request = requests_[id];
+      }
+      int64_t result = Transfer(fd_, request.op, request.data, request.size,
+                                request.offset);
+      absl::MutexLock lock(&mu_);
+      requests_[id].result = result;
+      requests_[id].complete = true;
+    }
+  }
+
+  const int fd_;
+  absl::Mutex mu_;
+  std::vector<Request> requests_ ABSL_GUARDED_BY(mu_);
+  std::deque<int> queue_ ABSL_GUARDED_BY(mu_);
+  bool shutdown_ ABSL_GUARDED_BY(mu_) = false;
+  std::thread thread_;
+};
+
+#ifdef HAVE_IO_URING
+
+// Submits requests to an io_uring instance, using the raw system call
+// interface.  The stream is the only user of the ring, so submission and
+// completion need no locking.
+class IoUringFileIo final : public AsyncFileIo {
+ public:
+  // Returns nullptr if io_uring is not available.
+  static std::unique_ptr<IoUringFileIo> Create(int fd, int capacity) {
+    std::unique_ptr<IoUringFileIo> io(new IoUringFileIo(fd, capacity));
+    if (!io->Init(capacity)) return nullptr;
+    return io;
+  }
+
+  ~IoUringFileIo() override {
+    if (sqes_ != nullptr) munmap(sqes_, sqes_size_);
+    if (cq_ring_ != nullptr && cq_ring_ != sq_ring_) {
+      munmap(cq_ring_, cq_ring_size_);
+    }
+    if (sq_ring_ != nullptr) munmap(sq_ring_, sq_ring_size_);
+    if (ring_fd_ >= 0) close_no_eintr(ring_fd_);
+  }
+
+  bool is_io_uring() const override { return true; }
+
+  void Submit(int id, Op op, char* data, size_t size,
+              int64_t offset) override {
+    GOOGLE_ABSL_DCHECK_GE(offset, 0);
+    requests_[id] = {op, data, size, offset, 0, false, 0, {}};
+    Push(id);
+  }
+
+  int64_t Wait(int id) override {
+    while (!requests_[id].complete) {
+      unsigned head = *cq_head_;
+      if (head == __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE)) {
+        int result = Enter(0, 1, IORING_ENTER_GETEVENTS);
+        if (result < 0) return -errno;
+        continue;
+      }
+      const io_uring_cqe& cqe = cqes_[head & *cq_mask_];
+      Complete(static_cast<int>(cqe.user_data), cqe.res);
+      __atomic_store_n(cq_head_, head + 1, __ATOMIC_RELEASE);
+    }
+    return requests_[id].result;
+  }
+
+ private:
+  struct Request {
+    Op op;
+    char* data;
+    size_t size;
+    int64_t offset;
+    size_t done;
+    bool complete;
+    int64_t result;
+    iovec iov;
+  };
+
+  IoUringFileIo(int fd, int capacity) : fd_(fd), requests_(capacity) {}
+
+  bool Init(int capacity) {
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    ring_fd_ = static_cast<int>(
+        syscall(__NR_io_uring_setup, static_cast<unsigned>(capacity), &params));
+    if (ring_fd_ < 0) return false;
+
+    sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_ring_size_ =
+        params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool single_mmap = false;
+#ifdef IORING_FEAT_SINGLE_MMAP
+    single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+#endif
+    if (single_mmap) {
+      sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+    }
+    sq_ring_ = Map(sq_ring_size_, IORING_OFF_SQ_RING);
+    if (sq_ring_ == nullptr) return false;
+    cq_ring_ = single_mmap ? sq_ring_ : Map(cq_ring_size_, IORING_OFF_CQ_RING);
+    if (cq_ring_ == nullptr) return false;
+    sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+    sqes_ = static_cast<io_uring_sqe*>(Map(sqes_size_, IORING_OFF_SQES));
+    if (sqes_ == nullptr) return false;
+
+    char* sq = static_cast<char*>(sq_ring_);
+    sq_tail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+    sq_mask_ = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+    sq_array_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+    char* cq = static_cast<char*>(cq_ring_);
+    cq_head_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+    cq_tail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+    cq_mask_ = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+    return true;
+  }
+
+  void* Map(size_t size, off_t offset) {
+    void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                   MAP_SHARED | MAP_POPULATE, ring_fd_, offset);
+    return p == MAP_FAILED ? nullptr : p;
+  }
+
+  int Enter(unsigned to_submit, unsigned min_complete, unsigned flags) {
+    int result;
+    do {
+      result = static_cast<int>(syscall(__NR_io_uring_enter, ring_fd_,
+                                        to_submit, min_complete, flags,
+                                        nullptr, 0));
+    } while (result < 0 && errno == EINTR);
+    return result;
+  }
+
+  // Queues the untransferred part of request `id` and submits it.
+  void Push(int id) {
+    Request& request = requests_[id];
+    request.iov.iov_base = request.data + request.done;
+    request.iov.iov_len = request.size - request.done;
+
+    // Only one request per id is outstanding, so the ring never fills up.
+    unsigned tail = *sq_tail_;
+    unsigned index = tail & *sq_mask_;
+    io_uring_sqe* sqe = &sqes_[index];
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = request.op == kRead ? IORING_OP_READV : IORING_OP_WRITEV;
+    sqe->fd = fd_;
+    sqe->addr = reinterpret_cast<uint64_t>(&request.iov);
+    sqe->len = 1;
+    sqe->off = static_cast<uint64_t>(request.offset) + request.done;
+    sqe->user_data = static_cast<uint64_t>(id);
+    sq_array_[index] = index;
+    __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+
+    if (Enter(1, 0, 0) < 0) {
+      // The kernel did not take the entry; take it back and fail the request.
+      __atomic_store_n(sq_tail_, tail, __ATOMIC_RELEASE);
+      request.result = -errno;
+      request.complete = true;
+    }
+  }
+
+  void Complete(int id, int result) {
+    Request& request = requests_[id];
+    if (result < 0) {
+      request.result = result;
+    } else {
+      request.done += static_cast<size_t>(result);
+      if (request.op == kWrite && result > 0 && request.done < request.size) {
+        // Short write: submit the rest.
+        Push(id);
+        return;
+      }
+      request.result = static_cast<int64_t>(request.done);
+    }
+    request.complete = true;
+  }
+
+  const int fd_;
+  std::vector<Request> requests_;
+
+  int ring_fd_ = -1;
+  void* sq_ring_ = nullptr;
+  size_t sq_ring_size_ = 0;
+  void* cq_ring_ = nullptr;
+  size_t cq_ring_size_ = 0;
+  io_uring_sqe* sqes_ = nullptr;
+  size_t sqes_size_ = 0;
+
+  unsigned* sq_tail_ = nullptr;
+  unsigned* sq_mask_ = nullptr;
+  unsigned* sq_array_ = nullptr;
+  unsigned* cq_head_ = nullptr;
+  unsigned* cq_tail_ = nullptr;
+  unsigned* cq_mask_ = nullptr;
+  io_uring_cqe* cqes_ = nullptr;
+};
+
+#endif  // HAVE_IO_URING
+
+// Creates the I/O backend for `fd`.  io_uring requires explicit offsets, so it
+// is only used for seekable descriptors.  It may also complete requests on
+// non-blocking descriptors with -EAGAIN, so those use a thread.
+std::unique_ptr<AsyncFileIo> CreateAsyncFileIo(
+    int fd, int capacity, bool seekable, bool background,
+    const AsyncFileStreamOptions& options) {
+#ifdef HAVE_IO_URING
+  if (seekable && background && options.use_io_uring &&
+      (fcntl(fd, F_GETFL) & O_NONBLOCK) == 0) {
+    if (auto io = IoUringFileIo::Create(fd, capacity)) return io;
+  }
+#else
+  (void)seekable;
+  (void)options;
+#endif
+  if (background) return std::make_unique<ThreadFileIo>(fd, capacity);
+  return std::make_unique<BlockingFileIo>(fd, capacity);
+}
+
+int BufferSize(const AsyncFileStreamOptions& options) {
+  GOOGLE_ABSL_CHECK_GT(options.buffer_size, 0);
+  return options.buffer_size;
+}
+
+int BufferCount(const AsyncFileStreamOptions& options) {
+  GOOGLE_ABSL_CHECK_GT(options.buffer_count, 0);
+  return options.buffer_count;
+}
+
+}  // namespace
+
+// ===================================================================
+
+AsyncFileInputStream::AsyncFileInputStream(int file_descriptor)
+    : AsyncFileInputStream(file_descriptor, AsyncFileStreamOptions()) {}
+
+AsyncFileInputStream::AsyncFileInputStream(
+    int file_descriptor, const AsyncFileStreamOptions& options)
+    : file_(file_descriptor),
+      buffer_size_(BufferSize(options)),
+      buffer_count_(BufferCount(options)),
+      buffers_(new char[static_cast<size_t>(buffer_size_) * buffer_count_]) {
+  start_offset_ = submit_offset_ = SeekableOffset(file_, /*for_write=*/false);
+  // Reading ahead of the caller could block forever on pipes and sockets, so
+  // those are read one request at a time, when the caller asks for data.
+  const bool seekable = submit_offset_ >= 0;
+  io_ = CreateAsyncFileIo(file_, buffer_count_, seekable, seekable, options);
+}
+
+AsyncFileInputStream::~AsyncFileInputStream() {
+  if (is_closed_) return;
+  Finish();
+  if (close_on_delete_ && close_no_eintr(file_) != 0) {
+    GOOGLE_ABSL_LOG(ERROR) << "close() failed: " << strerror(errno);
+  }
+}
+
+bool AsyncFileInputStream::Close() {
+  GOOGLE_ABSL_CHECK(!is_closed_);
+  is_closed_ = true;
+  Finish();
+  if (close_no_eintr(file_) != 0) {
+    errno_ = errno;
+    return false;
+  }
+  return true;
+}
+
+bool AsyncFileInputStream::uses_io_uring() const { return io_->is_io_uring(); }
+
+char* AsyncFileInputStream::buffer(int64_t sequence) const {
+  return buffers_.get() +
+         static_cast<size_t>(sequence % buffer_count_) * buffer_size_;
+}
+
+bool AsyncFileInputStream::Next(const void** data, int* size) {
+  GOOGLE_ABSL_CHECK(!is_closed_);
+  if (current_backed_up_ > 0) {
+    *data = current_ + current_size_ - current_backed_up_;
+    *size = current_backed_up_;
+    current_backed_up_ = 0;
+    return true;
+  }
+
+  // The caller is done with the current buffer, so it can be refilled.
+  current_ = nullptr;
+  current_size_ = 0;
+  if (errno_ != 0 || eof_) return false;
+  FillPipeline();
+
+  const int64_t sequence = next_read_++;
+  const int64_t result =
+      io_->Wait(static_cast<int>(sequence % buffer_count_));
+  if (result <= 0) {
+    if (result < 0) errno_ = static_cast<int>(-result);
+    eof_ = true;
+    Drain();
+    return false;
+  }
+  if (result < buffer_size_ && submit_offset_ >= 0) {
+    // The reads after a short read were submitted past a gap: discard them
+    // and continue right after this one.
+    Drain();
+    submit_offset_ = start_offset_ + bytes_read_ + result;
+  }
+
+  bytes_read_ += result;
+  current_ = buffer(sequence);
+  current_size_ = static_cast<int>(result);
+  *data = current_;
+  *size = current_size_;
+  return true;
+}
+
+void AsyncFileInputStream::BackUp(int count) {
+  GOOGLE_ABSL_CHECK(current_ != nullptr)
+      << " BackUp() can only be called after Next().";
+  GOOGLE_ABSL_CHECK_GE(count, 0);
+  GOOGLE_ABSL_CHECK_LE(count, current_size_ - current_backed_up_)
+      << " Can't back up over more bytes than were returned by the last call"
+         " to Next().";
+  current_backed_up_ += count;
+}
+
+bool AsyncFileInputStream::Skip(int count) {
+  GOOGLE_ABSL_CHECK_GE(count, 0);
+  const void* data;
+  int size;
+  while (count > 0) {
+    if (!Next(&data, &size)) return false;
+    if (size > count) {
+      BackUp(size - count);
+      return true;
+    }
+    count -= size;
+  }
+  return true;
+}
+
+int64_t AsyncFileInputStream::ByteCount() const {
+  return bytes_read_ - current_backed_up_;
+}
+
+void AsyncFileInputStream::FillPipeline() {
+  const int64_t depth = submit_offset_ >= 0 ? buffer_count_ : 1;
+  while (next_submit_ - next_read_ < depth) {
+    io_->Submit(static_cast<int>(next_submit_ % buffer_count_),
+                AsyncFileIo::kRead, buffer(next_submit_), buffer_size_,
+                submit_offset_);
+    if (submit_offset_ >= 0) submit_offset_ += buffer_size_;
+    ++next_submit_;
+  }
+}
+
+void AsyncFileInputStream::Drain() {
+  for (; next_read_ < next_submit_; ++next_read_) {
+    io_->Wait(static_cast<int>(next_read_ % buffer_count_));
+  }
+}
+
+void AsyncFileInputStream::Finish() {
+  Drain();
+  if (start_offset_ >= 0) SeekTo(file_, start_offset_ + ByteCount());
+}
+
+// ===================================================================
+
+AsyncFileOutputStream::AsyncFileOutputStream(int file_descriptor)
+    : AsyncFileOutputStream(file_descriptor, AsyncFileStreamOptions()) {}
+
+AsyncFileOutputStream::AsyncFileOutputStream(
+    int file_descriptor, const AsyncFileStreamOptions& options)
+    : file_(file_descriptor),
+      buffer_size_(BufferSize(options)),
+      buffer_count_(BufferCount(options)),
+      buffers_(new char[static_cast<size_t>(buffer_size_) * buffer_count_]) {
+  submit_offset_ = SeekableOffset(file_, /*for_write=*/true);
+  io_ = CreateAsyncFileIo(file_, buffer_count_, submit_offset_ >= 0,
+                          /*background=*/true, options);
+}
+
+AsyncFileOutputStream::~AsyncFileOutputStream() {
+  if (is_closed_) return;
+  Flush();
+  if (close_on_delete_ && close_no_eintr(file_) != 0) {
+    GOOGLE_ABSL_LOG(ERROR) << "close() failed: " << strerror(errno);
+  }
+}
+
+bool AsyncFileOutputStream::Close() {
+  GOOGLE_ABSL_CHECK(!is_closed_);
+  bool flush_succeeded = Flush();
+  is_closed_ = true;
+  if (close_no_eintr(file_) != 0) {
+    errno_ = errno;
+    return false;
+  }
+  return flush_succeeded;
+}
+
+bool AsyncFileOutputStream::Flush() {
+  if (errno_ == 0) Submit();
+  while (next_complete_ < next_submit_) Complete();
+  if (submit_offset_ >= 0) SeekTo(file_, submit_offset_);
+  return errno_ == 0;
+}
+
+bool AsyncFileOutputStream::uses_io_uring() const {
+  return io_->is_io_uring();
+}
+
+char* AsyncFileOutputStream::buffer(int64_t sequence) const {
+  return buffers_.get() +
+         static_cast<size_t>(sequence % buffer_count_) * buffer_size_;
+}
+
+bool AsyncFileOutputStream::Next(void** data, int* size) {
+  GOOGLE_ABSL_CHECK(!is_closed_);
+  if (errno_ != 0) return false;
+  if (buffer_used_ == buffer_size_) {
+    Submit();
+    if (errno_ != 0) return false;
+  }
+  *data = buffer(next_submit_) + buffer_used_;
+  *size = buffer_size_ - buffer_used_;
+  buffer_used_ = buffer_size_;
+  return true;
+}
+
+void AsyncFileOutputStream::BackUp(int count) {
+  GOOGLE_ABSL_CHECK_GE(count, 0);
+  GOOGLE_ABSL_CHECK_LE(count, buffer_used_)
+      << " Can't back up over more bytes than were returned by the last call"
+         " to Next().";
+  buffer_used_ -= count;
+}
+
+int64_t AsyncFileOutputStream::ByteCount() const {
+  return bytes_submitted_ + buffer_used_;
+}
+
+void AsyncFileOutputStream::Submit() {
+  if (buffer_used_ == 0) return;
+  io_->Submit(static_cast<int>(next_submit_ % buffer_count_),
+              AsyncFileIo::kWrite, buffer(next_submit_), buffer_used_,
+              submit_offset_);
+  if (submit_offset_ >= 0) submit_offset_ += buffer_used_;
+  bytes_submitted_ += buffer_used_;
+  buffer_used_ = 0;
+  ++next_submit_;
+  // The next buffer to fill must not have a write in flight.
+  if (next_submit_ - next_complete_ == buffer_count_) Complete();
+}
+
+void AsyncFileOutputStream::Complete() {
+  const int64_t result =
+      io_->Wait(static_cast<int>(next_complete_ % buffer_count_));
+  ++next_complete_;
+  if (result < 0 && errno_ == 0) errno_ = static_cast<int>(-result);
+}
+
+}  // namespace io
+}  // namespace protobuf
+}  // namespace google
+
+#include "google/protobuf/port_undef.inc"
@@ -0,0 +1,246 @@
+// Protocol Buffers - Google's data interchange format
+// Copyright 2008 Google Inc.  All rights reserved.
+// https://developers.google.com/protocol-buffers/
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// This file contains AsyncFileInputStream and AsyncFileOutputStream, which
+// read and write a file descriptor like FileInputStream and FileOutputStream,
+// but keep several buffers in flight so that I/O overlaps with the caller's
+// processing of the data.
+//
+// On Linux, regular files are read and written through io_uring when the
+// kernel supports it.  Elsewhere, and for pipes and sockets, the I/O is done
+// by a background thread owned by the stream.
+
+#ifndef GOOGLE_PROTOBUF_IO_ASYNC_FILE_STREAM_H__
+#define GOOGLE_PROTOBUF_IO_ASYNC_FILE_STREAM_H__
+
+#include <cstdint>
+#include <memory>
+
+#include "google/protobuf/io/zero_copy_stream.h"
+
+// Must be included last.
+#include "google/protobuf/port_def.inc"
+
+namespace google {
+namespace protobuf {
+namespace internal {
+class AsyncFileIo;  // defined in async_file_stream.cc
+}  // namespace internal
+
+namespace io {
+
+// Options shared by AsyncFileInputStream and AsyncFileOutputStream.
+struct PROTOBUF_EXPORT AsyncFileStreamOptions {
+  // Size of each buffer returned by Next().  Defaults to 256kB.
+  int buffer_size = 256 << 10;
+
+  // Number of buffers.  Up to buffer_count - 1 reads or buffer_count writes
+  // are in flight while the caller works on the current buffer.  Defaults to
+  // 4.
+  int buffer_count = 4;
+
+  // If false, I/O is always done by a background thread, even where io_uring
+  // is available.
+  bool use_io_uring = true;
+};
+
+// A ZeroCopyInputStream which reads from a file descriptor, reading ahead
+// into the next buffers while the caller processes the current one.
+//
+// Reading starts at the current offset of the file descriptor.  When the
+// stream is closed or destroyed, the offset of a seekable descriptor is moved
+// past the bytes consumed from the stream; data read ahead is discarded.
+//
+// The flags of the descriptor are not changed.  If it is non-blocking, reads
+// that would block wait in poll() until data is available.
+class PROTOBUF_EXPORT AsyncFileInputStream PROTOBUF_FUTURE_FINAL
+    : public ZeroCopyInputStream {
+ public:
+  explicit AsyncFileInputStream(int file_descriptor);
+  AsyncFileInputStream(int file_descriptor,
+                       const AsyncFileStreamOptions& options);
+  AsyncFileInputStream(const AsyncFileInputStream&) = delete;
+  AsyncFileInputStream& operator=(const AsyncFileInputStream&) = delete;
+  ~AsyncFileInputStream() override;
+
+  // Waits for outstanding reads and closes the underlying file.  Returns false
+  // if an error occurs during the process; use GetErrno() to examine the
+  // error.  Even if an error occurs, the file descriptor is closed when this
+  // returns.
+  bool Close();
+
+  // By default, the file descriptor is not closed when the stream is
+  // destroyed.  Call SetCloseOnDelete(true) to change that.
+  void SetCloseOnDelete(bool value) { close_on_delete_ = value; }
+
+  // If an I/O error has occurred on this file descriptor, this is the
+  // errno from that error.  Otherwise, this is zero.  Once an error
+  // occurs, the stream is broken and all subsequent operations will
+  // fail.
+  int GetErrno() const { return errno_; }
+
+  // Returns true if reads are submitted through io_uring rather than a
+  // background thread.
+  bool uses_io_uring() const;
+
+  // implements ZeroCopyInputStream ----------------------------------
+  bool Next(const void** data, int* size) override;
+  void BackUp(int count) override;
+  bool Skip(int count) override;
+  int64_t ByteCount() const override;
+
+ private:
+  char* buffer(int64_t sequence) const;
+  // Submits reads until all buffers but the one held by the caller are busy.
+  void FillPipeline();
+  // Waits for and discards all outstanding reads.
+  void Drain();
+  void Finish();
+
+  const int file_;
+  const int buffer_size_;
+  const int buffer_count_;
+  bool close_on_delete_ = false;
+  bool is_closed_ = false;
+  bool eof_ = false;
+  int errno_ = 0;
+
+  std::unique_ptr<char[]> buffers_;
+  std::unique_ptr<internal::AsyncFileIo> io_;
+
+  // Reads are numbered in submission order; read N uses buffer N %
+  // buffer_count_.  Reads [next_read_, next_submit_) are in flight.
+  int64_t next_read_ = 0;
+  int64_t next_submit_ = 0;
+
+  // File offset of the next read to submit, or -1 if the descriptor is not
+  // seekable.
+  int64_t submit_offset_ = -1;
+  // File offset of the first byte returned by the stream.
+  int64_t start_offset_ = -1;
+
+  // The buffer last returned by Next().
+  const char* current_ = nullptr;
+  int current_size_ = 0;
+  int current_backed_up_ = 0;
+
+  // Bytes returned by completed reads.
+  int64_t bytes_read_ = 0;
+};
+
+// A ZeroCopyOutputStream which writes to a file descriptor.  Full buffers are
+// submitted for writing immediately, and Next() only blocks when all buffers
+// are waiting to be written.
+//
+// Writing starts at the current offset of the file descriptor.  Flush(),
+// Close() and the destructor wait for all writes to complete.  Like
+// AsyncFileInputStream, the stream waits in poll() on a non-blocking
+// descriptor that is not ready.
+class PROTOBUF_EXPORT AsyncFileOutputStream PROTOBUF_FUTURE_FINAL
+    : public ZeroCopyOutputStream {
+ public:
+  explicit AsyncFileOutputStream(int file_descriptor);
+  AsyncFileOutputStream(int file_descriptor,
+                        const AsyncFileStreamOptions& options);
+  AsyncFileOutputStream(const AsyncFileOutputStream&) = delete;
+  AsyncFileOutputStream& operator=(const AsyncFileOutputStream&) = delete;
+  ~AsyncFileOutputStream() override;
+
+  // Flushes any buffers and closes the underlying file.  Returns false if
+  // an error occurs during the process; use GetErrno() to examine the error.
+  // Even if an error occurs, the file descriptor is closed when this returns.
+  bool Close();
+
+  // Submits buffered data and waits until all of it has been written.  Returns
+  // false if an error occurred.
+  bool Flush();
+
+  // By default, the file descriptor is not closed when the stream is
+  // destroyed.  Call SetCloseOnDelete(true) to change that.  WARNING:
+  // This leaves no way for the caller to detect if close() fails.  If
+  // detecting close() errors is important to you, you should arrange
+  // to close the descriptor yourself.
+  void SetCloseOnDelete(bool value) { close_on_delete_ = value; }
+
+  // If an I/O error has occurred on this file descriptor, this is the
+  // errno from that error.  Otherwise, this is zero.  Once an error
+  // occurs, the stream is broken and all subsequent operations will
+  // fail.
+  int GetErrno() const { return errno_; }
+
+  // Returns true if writes are submitted through io_uring rather than a
+  // background thread.
+  bool uses_io_uring() const;
+
+  // implements ZeroCopyOutputStream ---------------------------------
+  bool Next(void** data, int* size) override;
+  void BackUp(int count) override;
+  int64_t ByteCount() const override;
+
+ private:
+  char* buffer(int64_t sequence) const;
+  // Submits the current buffer for writing.
+  void Submit();
+  // Waits for the oldest outstanding write.
+  void Complete();
+
+  const int file_;
+  const int buffer_size_;
+  const int buffer_count_;
+  bool close_on_delete_ = false;
+  bool is_closed_ = false;
+  int errno_ = 0;
+
+  std::unique_ptr<char[]> buffers_;
+  std::unique_ptr<internal::AsyncFileIo> io_;
+
+  // Writes are numbered in submission order; write N uses buffer N %
+  // buffer_count_.  Writes [next_complete_, next_submit_) are in flight, and
+  // buffer next_submit_ % buffer_count_ is being filled.
+  int64_t next_complete_ = 0;
+  int64_t next_submit_ = 0;
+
+  // File offset of the next write to submit, or -1 if the descriptor is not
+  // seekable.
+  int64_t submit_offset_ = -1;
+
+  // Bytes of the current buffer handed out by Next() and not backed up.
+  int buffer_used_ = 0;
+  // Bytes submitted for writing.
+  int64_t bytes_submitted_ = 0;
+};
+
+}  // namespace io
+}  // namespace protobuf
+}  // namespace google
+
+#include "google/protobuf/port_undef.inc"
+
+#endif  // GOOGLE_PROTOBUF_IO_ASYNC_FILE_STREAM_H__
@@ -796,8 +796,15 @@ class PROTOBUF_EXPORT EpsCopyOutputStream {
     constexpr auto element_size = sizeof(typename T::value_type);
     auto size = r.size() * element_size;
     ptr = WriteLengthDelim(num, size, ptr);
+#if defined(PROTOBUF_LITTLE_ENDIAN) && \
+    !defined(PROTOBUF_DISABLE_LITTLE_ENDIAN_OPT_FOR_TEST)
+    // The in-memory representation is the wire format, so large arrays can be
+    // handed to the underlying stream by reference, like bytes fields.
+    return WriteRawMaybeAliased(r.data(), static_cast<int>(size), ptr);
+#else
     return WriteRawLittleEndian<element_size>(r.data(), static_cast<int>(size),
                                               ptr);
+#endif
   }
 
   // Returns true if there was an underlying I/O error since this object was
@@ -829,6 +836,14 @@ class PROTOBUF_EXPORT EpsCopyOutputStream {
   // stream's overall position.
   int64_t ByteCount(uint8_t* ptr) const;
 
+  // Sub-message sizes recorded by MessageLite::FlatByteSizeLong(), in
+  // serialization order.  MessageLite::_InternalSerializeFlatSized() takes the
+  // length prefix of each sub-message from here instead of from its cached
+  // size; see WireFormatLite::InternalWriteMessageFlatSized().
+  void SetFlatSizes(const uint32_t* sizes) { flat_sizes_ = sizes; }
+  const uint32_t* flat_sizes() const { return flat_sizes_; }
+  uint32_t NextFlatSize() { return *flat_sizes_++; }
+
 
  private:
   uint8_t* end_;
@@ -839,6 +854,7 @@ class PROTOBUF_EXPORT EpsCopyOutputStream {
   bool aliasing_enabled_ = false;  // See EnableAliasing().
   bool is_serialization_deterministic_;
   bool skip_check_consistency = false;
+  const uint32_t* flat_sizes_ = nullptr;  // See SetFlatSizes().
 
   uint8_t* EnsureSpaceFallback(uint8_t* ptr);
   inline uint8_t* Next();
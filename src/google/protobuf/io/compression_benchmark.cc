@@ -0,0 +1,271 @@
+// Protocol Buffers - Google's data interchange format
+// Copyright 2008 Google Inc.  All rights reserved.
+// https://developers.google.com/protocol-buffers/
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Compares the compression streams on a stream of length-delimited
+// TestAllTypesProto3 messages: throughput and ratio for the whole stream, and
+// ratio when every message is compressed on its own with and without a
+// dictionary (as for RPC payloads or small records).
+//
+// Usage: compression_benchmark [num_messages]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "google/protobuf/test_messages_proto3.pb.h"
+#include "google/protobuf/stubs/logging.h"
+#include "google/protobuf/io/coded_stream.h"
+#include "google/protobuf/io/gzip_stream.h"
+#include "google/protobuf/io/zero_copy_stream_impl_lite.h"
+
+#if HAVE_ZSTD
+#include "google/protobuf/io/zstd_stream.h"
+#endif
+#if HAVE_LZ4
+#include "google/protobuf/io/lz4_stream.h"
+#endif
+
+namespace google {
+namespace protobuf {
+namespace io {
+namespace {
+
+using ::protobuf_test_messages::proto3::TestAllTypesProto3;
+
+using Compressor =
+    std::function<void(ZeroCopyOutputStream*, const std::string&)>;
+using Decompressor = std::function<void(ZeroCopyInputStream*, std::string*)>;
+
+struct Codec {
+  std::string name;
+  Compressor compress;
+  Decompressor decompress;
+};
+
+// Writes data through Next()/BackUp() as a serializer would.
+void WriteAll(ZeroCopyOutputStream* output, const std::string& data) {
+  CodedOutputStream coded_output(output);
+  coded_output.WriteRaw(data.data(), static_cast<int>(data.size()));
+}
+
+void ReadAll(ZeroCopyInputStream* input, std::string* data) {
+  const void* buffer;
+  int size;
+  while (input->Next(&buffer, &size)) {
+    data->append(static_cast<const char*>(buffer), size);
+  }
+}
+
+template <typename OutputStream, typename InputStream>
+Codec MakeCodec(std::string name, typename OutputStream::Options options,
+                typename InputStream::Options input_options) {
+  return {std::move(name),
+          [options](ZeroCopyOutputStream* sub_stream,
+                    const std::string& data) {
+            OutputStream output(sub_stream, options);
+            WriteAll(&output, data);
+          },
+          [input_options](ZeroCopyInputStream* sub_stream, std::string* data) {
+            InputStream input(sub_stream, input_options);
+            ReadAll(&input, data);
+          }};
+}
+
+std::vector<std::string> MakeMessages(int count) {
+  std::vector<std::string> messages;
+  uint32_t seed = 1;
+  auto next = [&seed] {
+    seed = seed * 1103515245 + 12345;
+    return seed >> 8;
+  };
+  static const char* const kWords[] = {"alpha", "beta",  "gamma", "delta",
+                                       "omega", "north", "south", "request",
+                                       "reply", "user",  "item",  "status"};
+  auto word = [&] { return std::string(kWords[next() % 12]); };
+  for (int i = 0; i < count; ++i) {
+    TestAllTypesProto3 message;
+    message.set_optional_int32(next() % 1000);
+    message.set_optional_int64(int64_t{next()} << 10);
+    message.set_optional_uint32(i);
+    message.set_optional_double(next() / 3.0);
+    message.set_optional_bool(next() % 2);
+    message.set_optional_string(word() + " " + word() + " " +
+                                std::to_string(next() % 100000));
+    message.set_optional_bytes(std::string(next() % 16, 'x'));
+    message.mutable_optional_nested_message()->set_a(next() % 50);
+    message.set_optional_nested_enum(TestAllTypesProto3::BAR);
+    for (int j = next() % 8; j > 0; --j) {
+      message.add_repeated_int32(next() % 200);
+      message.add_repeated_string(word());
+    }
+    (*message.mutable_map_string_string())[word()] = word() + word();
+    messages.push_back(message.SerializeAsString());
+  }
+  return messages;
+}
+
+double Seconds(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                       start)
+      .count();
+}
+
+void BenchmarkStream(const Codec& codec, const std::string& data) {
+  const int kIterations = 5;
+  std::string compressed;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kIterations; ++i) {
+    compressed.clear();
+    StringOutputStream output(&compressed);
+    codec.compress(&output, data);
+  }
+  double compress_seconds = Seconds(start) / kIterations;
+
+  std::string decompressed;
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kIterations; ++i) {
+    decompressed.clear();
+    ArrayInputStream input(compressed.data(), compressed.size());
+    codec.decompress(&input, &decompressed);
+  }
+  double decompress_seconds = Seconds(start) / kIterations;
+  GOOGLE_ABSL_CHECK(decompressed == data) << codec.name;
+
+  printf("%-24s %8.1f MB/s %8.1f MB/s %7.2fx\n", codec.name.c_str(),
+         data.size() / compress_seconds / 1e6,
+         data.size() / decompress_seconds / 1e6,
+         static_cast<double>(data.size()) / compressed.size());
+}
+
+void BenchmarkMessages(const Codec& codec,
+                       const std::vector<std::string>& messages) {
+  size_t total = 0;
+  size_t compressed_total = 0;
+  for (const std::string& message : messages) {
+    std::string compressed;
+    {
+      StringOutputStream output(&compressed);
+      codec.compress(&output, message);
+    }
+    std::string decompressed;
+    ArrayInputStream input(compressed.data(), compressed.size());
+    codec.decompress(&input, &decompressed);
+    GOOGLE_ABSL_CHECK(decompressed == message) << codec.name;
+    total += message.size();
+    compressed_total += compressed.size();
+  }
+  printf("%-24s %7.2fx\n", codec.name.c_str(),
+         static_cast<double>(total) / compressed_total);
+}
+
+int Run(int num_messages) {
+  std::vector<std::string> messages = MakeMessages(num_messages);
+  std::string stream;
+  {
+    StringOutputStream output(&stream);
+    CodedOutputStream coded_output(&output);
+    for (const std::string& message : messages) {
+      coded_output.WriteVarint32(static_cast<uint32_t>(message.size()));
+      coded_output.WriteString(message);
+    }
+  }
+
+  // Raw content dictionary: concatenated sample messages.  A dictionary
+  // trained with `zstd --train` on real traffic does better.
+  std::string dictionary;
+  for (size_t i = 0; i < messages.size() && dictionary.size() < 16384; ++i) {
+    dictionary += messages[messages.size() - 1 - i];
+  }
+
+  std::vector<Codec> codecs;
+  std::vector<Codec> dictionary_codecs;
+  {
+    GzipOutputStream::Options options;
+    codecs.push_back(MakeCodec<GzipOutputStream, GzipInputStream>(
+        "gzip", options, GzipInputStream::Options()));
+    options.compression_level = 1;
+    codecs.push_back(MakeCodec<GzipOutputStream, GzipInputStream>(
+        "gzip -1", options, GzipInputStream::Options()));
+  }
+#if HAVE_ZSTD
+  for (int level : {1, 3, 9}) {
+    ZstdOutputStream::Options options;
+    options.compression_level = level;
+    codecs.push_back(MakeCodec<ZstdOutputStream, ZstdInputStream>(
+        "zstd -" + std::to_string(level), options, ZstdInputStream::Options()));
+    if (level != 3) continue;
+    ZstdInputStream::Options input_options;
+    dictionary_codecs.push_back(codecs.back());
+    options.dictionary = input_options.dictionary = dictionary;
+    dictionary_codecs.push_back(MakeCodec<ZstdOutputStream, ZstdInputStream>(
+        "zstd -3 (dictionary)", options, input_options));
+  }
+#endif
+#if HAVE_LZ4
+  for (int level : {0, 9}) {
+    Lz4OutputStream::Options options;
+    options.compression_level = level;
+    codecs.push_back(MakeCodec<Lz4OutputStream, Lz4InputStream>(
+        "lz4 -" + std::to_string(level), options, Lz4InputStream::Options()));
+    if (level != 0) continue;
+    Lz4InputStream::Options input_options;
+    dictionary_codecs.push_back(codecs.back());
+    options.dictionary = input_options.dictionary = dictionary;
+    dictionary_codecs.push_back(MakeCodec<Lz4OutputStream, Lz4InputStream>(
+        "lz4 -0 (dictionary)", options, input_options));
+  }
+#endif
+
+  printf("%zu messages, %zu bytes\n\n", messages.size(), stream.size());
+  printf("%-24s %13s %13s %8s\n", "stream", "compress", "decompress",
+         "ratio");
+  for (const Codec& codec : codecs) BenchmarkStream(codec, stream);
+
+  printf("\n%-24s %8s\n", "single message", "ratio");
+  BenchmarkMessages(codecs[0], messages);
+  for (const Codec& codec : dictionary_codecs) {
+    BenchmarkMessages(codec, messages);
+  }
+  return 0;
+}
+
+}  // namespace
+}  // namespace io
+}  // namespace protobuf
+}  // namespace google
+
+int main(int argc, char* argv[]) {
+  int num_messages = argc > 1 ? atoi(argv[1]) : 100000;
+  return google::protobuf::io::Run(num_messages);
+}
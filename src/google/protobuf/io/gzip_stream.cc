@@ -37,9 +37,19 @@
 #if HAVE_ZLIB
 #include "google/protobuf/io/gzip_stream.h"
 
+#include <string.h>
+
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include "google/protobuf/stubs/common.h"
 #include "google/protobuf/stubs/logging.h"
 #include "google/protobuf/stubs/logging.h"
+#include "absl/synchronization/mutex.h"
 #include "google/protobuf/port.h"
 
 namespace google {
@@ -48,6 +58,140 @@ namespace io {
 
 static const int kDefaultBufferSize = 65536;
 
+// =========================================================================
+
+// Runs GzipInputStream::InflateNext() on a background thread, handing each
+// chunk of output to the reader through a small pool of output buffers.
+// Since zlib keeps its own window, output buffers can be recycled as soon as
+// the reader is done with them.
+class GzipInputStream::ReadAhead {
+ public:
+  ReadAhead(GzipInputStream* stream, int buffer_count)
+      : stream_(stream), original_buffer_(stream->output_buffer_) {
+    free_.push_back(original_buffer_);
+    for (int i = 1; i < buffer_count; ++i) {
+      free_.push_back(operator new(stream->output_buffer_length_));
+    }
+  }
+
+  ~ReadAhead() {
+    {
+      absl::MutexLock lock(&mu_);
+      stopping_ = true;
+    }
+    if (thread_.joinable()) thread_.join();
+    for (void* buffer : free_) {
+      if (buffer != original_buffer_) {
+        internal::SizedDelete(buffer, stream_->output_buffer_length_);
+      }
+    }
+    for (const Chunk& chunk : ready_) {
+      if (chunk.buffer != original_buffer_) {
+        internal::SizedDelete(chunk.buffer, stream_->output_buffer_length_);
+      }
+    }
+    if (current_.buffer != nullptr && current_.buffer != original_buffer_) {
+      internal::SizedDelete(current_.buffer, stream_->output_buffer_length_);
+    }
+    stream_->output_buffer_ = original_buffer_;
+  }
+
+  bool Next(const void** data, int* size) {
+    if (backed_up_ > 0) {
+      *data = static_cast<const char*>(current_.data) + current_.size -
+              backed_up_;
+      *size = backed_up_;
+      byte_count_ += backed_up_;
+      backed_up_ = 0;
+      return true;
+    }
+
+    absl::MutexLock lock(&mu_);
+    if (!thread_.joinable()) {
+      thread_ = std::thread([this] { Run(); });
+    }
+    if (current_.buffer != nullptr) {
+      free_.push_back(current_.buffer);
+      current_ = Chunk();
+    }
+    mu_.Await(absl::Condition(this, &ReadAhead::ReadyOrFinished));
+    if (ready_.empty()) return false;
+
+    current_ = ready_.front();
+    ready_.pop_front();
+    *data = current_.data;
+    *size = current_.size;
+    byte_count_ += current_.size;
+    return true;
+  }
+
+  void BackUp(int count) {
+    GOOGLE_ABSL_CHECK_GE(count, 0);
+    GOOGLE_ABSL_CHECK_LE(count + backed_up_, current_.size);
+    backed_up_ += count;
+    byte_count_ -= count;
+  }
+
+  int64_t ByteCount() const { return byte_count_; }
+
+ private:
+  struct Chunk {
+    void* buffer = nullptr;
+    const void* data = nullptr;
+    int size = 0;
+  };
+
+  bool ReadyOrFinished() const { return !ready_.empty() || finished_; }
+  bool FreeOrStopping() const { return !free_.empty() || stopping_; }
+
+  void Run() {
+    for (;;) {
+      void* buffer;
+      {
+        absl::MutexLock lock(&mu_);
+        mu_.Await(absl::Condition(this, &ReadAhead::FreeOrStopping));
+        if (stopping_) break;
+        buffer = free_.back();
+        free_.pop_back();
+      }
+
+      // The stream state is only touched by this thread while it runs.
+      stream_->output_buffer_ = buffer;
+      Chunk chunk;
+      chunk.buffer = buffer;
+      bool ok = stream_->InflateNext(&chunk.data, &chunk.size);
+
+      absl::MutexLock lock(&mu_);
+      if (!ok) {
+        free_.push_back(buffer);
+        break;
+      }
+      ready_.push_back(chunk);
+    }
+    absl::MutexLock lock(&mu_);
+    finished_ = true;
+  }
+
+  GzipInputStream* const stream_;
+  // Owned by stream_; all other buffers are owned by this object.
+  void* const original_buffer_;
+  std::thread thread_;
+
+  // Reader state.
+  Chunk current_;
+  int backed_up_ = 0;
+  int64_t byte_count_ = 0;
+
+  absl::Mutex mu_;
+  std::vector<void*> free_ ABSL_GUARDED_BY(mu_);
+  std::deque<Chunk> ready_ ABSL_GUARDED_BY(mu_);
+  bool finished_ ABSL_GUARDED_BY(mu_) = false;
+  bool stopping_ ABSL_GUARDED_BY(mu_) = false;
+};
+
+GzipInputStream::Options::Options()
+    : format(AUTO), buffer_size(kDefaultBufferSize), read_ahead_buffers(0) {}
+
 GzipInputStream::GzipInputStream(ZeroCopyInputStream* sub_stream, Format format,
                                  int buffer_size)
     : format_(format), sub_stream_(sub_stream), zerror_(Z_OK), byte_count_(0) {
@@ -71,7 +215,19 @@ GzipInputStream::GzipInputStream(ZeroCopyInputStream* sub_stream, Format format,
   zcontext_.avail_out = output_buffer_length_;
   output_position_ = output_buffer_;
 }
+
+GzipInputStream::GzipInputStream(ZeroCopyInputStream* sub_stream,
+                                 const Options& options)
+    : GzipInputStream(sub_stream, options.format, options.buffer_size) {
+  if (options.read_ahead_buffers > 0) {
+    // One more buffer than requested, for the one held by the reader.
+    read_ahead_.reset(new ReadAhead(this, options.read_ahead_buffers + 1));
+  }
+}
+
 GzipInputStream::~GzipInputStream() {
+  // Stops the background thread and gives back output_buffer_.
+  read_ahead_.reset();
   internal::SizedDelete(output_buffer_, output_buffer_length_);
   zerror_ = inflateEnd(&zcontext_);
 }
@@ -128,8 +284,7 @@ void GzipInputStream::DoNextOutput(const void** data, int* size) {
   output_position_ = zcontext_.next_out;
 }
 
-// implements ZeroCopyInputStream ----------------------------------
-bool GzipInputStream::Next(const void** data, int* size) {
+bool GzipInputStream::InflateNext(const void** data, int* size) {
   bool ok = (zerror_ == Z_OK) || (zerror_ == Z_STREAM_END) ||
             (zerror_ == Z_BUF_ERROR);
   if ((!ok) || (zcontext_.next_out == NULL)) {
@@ -170,7 +325,17 @@ bool GzipInputStream::Next(const void** data, int* size) {
   DoNextOutput(data, size);
   return true;
 }
+
+// implements ZeroCopyInputStream ----------------------------------
+bool GzipInputStream::Next(const void** data, int* size) {
+  if (read_ahead_ != nullptr) return read_ahead_->Next(data, size);
+  return InflateNext(data, size);
+}
 void GzipInputStream::BackUp(int count) {
+  if (read_ahead_ != nullptr) {
+    read_ahead_->BackUp(count);
+    return;
+  }
   output_position_ = reinterpret_cast<void*>(
       reinterpret_cast<uintptr_t>(output_position_) - count);
 }
@@ -188,6 +353,7 @@ bool GzipInputStream::Skip(int count) {
   return ok;
 }
 int64_t GzipInputStream::ByteCount() const {
+  if (read_ahead_ != nullptr) return read_ahead_->ByteCount();
   int64_t ret = byte_count_ + zcontext_.total_out;
   if (zcontext_.next_out != NULL && output_position_ != NULL) {
     ret += reinterpret_cast<uintptr_t>(zcontext_.next_out) -
@@ -198,11 +364,287 @@ int64_t GzipInputStream::ByteCount() const {
 
 // =========================================================================
 
+// Compresses the input in independent blocks on a pool of worker threads.
+//
+// Every block is a raw deflate stream primed with the last 32kB of the input
+// preceding it.  All blocks but the last end in a sync flush, which leaves
+// them byte aligned and not marked final, so they can simply be concatenated
+// between a gzip or zlib header and trailer.  The check values of the blocks
+// are computed by the workers too and combined in order by the writer.
+class GzipOutputStream::ParallelDeflate {
+ public:
+  ParallelDeflate(GzipOutputStream* stream, const Options& options)
+      : stream_(stream),
+        format_(options.format),
+        level_(options.compression_level),
+        strategy_(options.compression_strategy),
+        block_size_(options.buffer_size),
+        max_in_flight_(2 * options.num_threads),
+        check_(format_ == ZLIB ? adler32(0, Z_NULL, 0) : crc32(0, Z_NULL, 0)) {
+    workers_.reserve(options.num_threads);
+    for (int i = 0; i < options.num_threads; ++i) {
+      workers_.emplace_back([this] { Run(); });
+    }
+  }
+
+  ~ParallelDeflate() {
+    {
+      absl::MutexLock lock(&mu_);
+      stopping_ = true;
+    }
+    for (std::thread& worker : workers_) worker.join();
+  }
+
+  bool Next(void** data, int* size) {
+    if (input_used_ == block_size_ && !Submit(/*last=*/false)) return false;
+    if (input_ == nullptr) input_.reset(new char[block_size_]);
+    *data = input_.get() + input_used_;
+    *size = block_size_ - input_used_;
+    input_used_ = block_size_;
+    return true;
+  }
+
+  void BackUp(int count) {
+    GOOGLE_ABSL_CHECK_GE(count, 0);
+    GOOGLE_ABSL_CHECK_LE(count, input_used_);
+    input_used_ -= count;
+  }
+
+  int64_t ByteCount() const { return total_in_ + input_used_; }
+
+  // Compresses everything written so far and writes it to the sub stream.
+  bool Flush() {
+    if (input_used_ > 0 && !Submit(/*last=*/false)) return false;
+    return WriteBlocks(/*wait_all=*/true);
+  }
+
+  // Compresses the remaining input and writes it with the trailer.
+  bool Close() {
+    if (!Submit(/*last=*/true) || !WriteBlocks(/*wait_all=*/true)) {
+      return false;
+    }
+    uint8_t trailer[8];
+    int trailer_size;
+    if (format_ == ZLIB) {
+      for (int i = 0; i < 4; ++i) {
+        trailer[i] = static_cast<uint8_t>(check_ >> (24 - 8 * i));
+      }
+      trailer_size = 4;
+    } else {
+      for (int i = 0; i < 4; ++i) {
+        trailer[i] = static_cast<uint8_t>(check_ >> (8 * i));
+        trailer[4 + i] = static_cast<uint8_t>(total_in_ >> (8 * i));
+      }
+      trailer_size = 8;
+    }
+    return Write(trailer, trailer_size);
+  }
+
+ private:
+  static constexpr size_t kWindowSize = 32768;
+
+  struct Block {
+    std::unique_ptr<char[]> input;
+    size_t input_size = 0;
+    std::string dictionary;
+    bool last = false;
+
+    // Set by the worker.
+    std::string output;
+    uLong check = 0;
+    int error = Z_OK;
+    bool done = false;
+  };
+
+  // Hands the current input to the workers.
+  bool Submit(bool last) {
+    auto block = std::unique_ptr<Block>(new Block);
+    block->input = std::move(input_);
+    block->input_size = input_used_;
+    block->dictionary = dictionary_;
+    block->last = last;
+
+    // The next block is primed with the last 32kB of input.
+    dictionary_.append(block->input.get(), block->input_size);
+    if (dictionary_.size() > kWindowSize) {
+      dictionary_.erase(0, dictionary_.size() - kWindowSize);
+    }
+    total_in_ += input_used_;
+    input_used_ = 0;
+
+    Block* raw = block.get();
+    blocks_.push_back(std::move(block));
+    {
+      absl::MutexLock lock(&mu_);
+      queue_.push_back(raw);
+    }
+    return WriteBlocks(/*wait_all=*/false);
+  }
+
+  // Writes out finished blocks in order.  Waits for blocks to finish if
+  // wait_all is set or too many are in flight.
+  bool WriteBlocks(bool wait_all) {
+    while (!blocks_.empty()) {
+      Block* block = blocks_.front().get();
+      {
+        absl::MutexLock lock(&mu_);
+        if (wait_all || blocks_.size() > max_in_flight_) {
+          mu_.Await(absl::Condition(&block->done));
+        } else if (!block->done) {
+          break;
+        }
+      }
+      if (block->error != Z_OK) {
+        stream_->zerror_ = block->error;
+        return false;
+      }
+      check_ = format_ == ZLIB
+                   ? adler32_combine(check_, block->check, block->input_size)
+                   : crc32_combine(check_, block->check, block->input_size);
+      if (!Write(block->output.data(), block->output.size())) return false;
+      blocks_.pop_front();
+    }
+    return true;
+  }
+
+  // Copies data to the sub stream, preceded by the header the first time.
+  bool Write(const void* data, size_t size) {
+    if (!header_written_) {
+      header_written_ = true;
+      uint8_t header[10];
+      int header_size;
+      if (format_ == ZLIB) {
+        // Deflate with a 32kB window and a level hint as zlib computes it.
+        int level_flags = 2;
+        if (strategy_ >= Z_HUFFMAN_ONLY || (level_ >= 0 && level_ < 2)) {
+          level_flags = 0;
+        } else if (level_ >= 0 && level_ < 6) {
+          level_flags = 1;
+        } else if (level_ > 6) {
+          level_flags = 3;
+        }
+        uint16_t value = (0x78 << 8) | (level_flags << 6);
+        value += 31 - value % 31;
+        header[0] = static_cast<uint8_t>(value >> 8);
+        header[1] = static_cast<uint8_t>(value);
+        header_size = 2;
+      } else {
+        // Deflate, no flags, no modification time, unknown OS.
+        const uint8_t kGzipHeader[] = {0x1f, 0x8b, 8, 0, 0, 0, 0, 0, 0, 0xff};
+        memcpy(header, kGzipHeader, sizeof(kGzipHeader));
+        header_size = sizeof(kGzipHeader);
+      }
+      if (!Write(header, header_size)) return false;
+    }
+
+    const char* in = static_cast<const char*>(data);
+    while (size > 0) {
+      void* out;
+      int out_size;
+      if (!stream_->sub_stream_->Next(&out, &out_size)) {
+        stream_->zerror_ = Z_ERRNO;
+        return false;
+      }
+      size_t n = std::min(size, static_cast<size_t>(out_size));
+      memcpy(out, in, n);
+      stream_->sub_stream_->BackUp(out_size - static_cast<int>(n));
+      in += n;
+      size -= n;
+    }
+    return true;
+  }
+
+  bool HasWorkOrStopping() const { return !queue_.empty() || stopping_; }
+
+  void Run() {
+    for (;;) {
+      Block* block;
+      {
+        absl::MutexLock lock(&mu_);
+        mu_.Await(absl::Condition(this, &ParallelDeflate::HasWorkOrStopping));
+        if (queue_.empty()) break;
+        block = queue_.front();
+        queue_.pop_front();
+      }
+      Compress(block);
+      absl::MutexLock lock(&mu_);
+      block->done = true;
+    }
+  }
+
+  void Compress(Block* block) const {
+    const Bytef* input = reinterpret_cast<const Bytef*>(block->input.get());
+    uInt input_size = static_cast<uInt>(block->input_size);
+    block->check = format_ == ZLIB
+                       ? adler32(adler32(0, Z_NULL, 0), input, input_size)
+                       : crc32(crc32(0, Z_NULL, 0), input, input_size);
+
+    z_stream zcontext;
+    memset(&zcontext, 0, sizeof(zcontext));
+    int error = deflateInit2(&zcontext, level_, Z_DEFLATED,
+                             /* windowBits (raw deflate) */ -15,
+                             /* memLevel (default) */ 8, strategy_);
+    if (error != Z_OK) {
+      block->error = error;
+      return;
+    }
+    if (!block->dictionary.empty()) {
+      error = deflateSetDictionary(
+          &zcontext, reinterpret_cast<const Bytef*>(block->dictionary.data()),
+          static_cast<uInt>(block->dictionary.size()));
+    }
+    zcontext.next_in = const_cast<Bytef*>(input);
+    zcontext.avail_in = input_size;
+    const int flush = block->last ? Z_FINISH : Z_SYNC_FLUSH;
+    // Room for the compressed data plus the sync flush marker; grown if
+    // that is not enough.
+    size_t chunk = deflateBound(&zcontext, input_size) + 16;
+    while (error == Z_OK) {
+      block->output.resize(zcontext.total_out + chunk);
+      zcontext.next_out =
+          reinterpret_cast<Bytef*>(&block->output[zcontext.total_out]);
+      zcontext.avail_out = static_cast<uInt>(chunk);
+      error = deflate(&zcontext, flush);
+      if (error == Z_STREAM_END ||
+          (error == Z_OK && !block->last && zcontext.avail_out != 0)) {
+        error = Z_OK;
+        break;
+      }
+      chunk = kWindowSize;
+    }
+    block->output.resize(zcontext.total_out);
+    block->error = error;
+    deflateEnd(&zcontext);
+  }
+
+  GzipOutputStream* const stream_;
+  const Format format_;
+  const int level_;
+  const int strategy_;
+  const int block_size_;
+  const size_t max_in_flight_;
+  std::vector<std::thread> workers_;
+
+  // Writer state.
+  std::unique_ptr<char[]> input_;
+  int input_used_ = 0;
+  int64_t total_in_ = 0;
+  std::string dictionary_;
+  std::deque<std::unique_ptr<Block>> blocks_;
+  uLong check_;
+  bool header_written_ = false;
+
+  absl::Mutex mu_;
+  std::deque<Block*> queue_ ABSL_GUARDED_BY(mu_);
+  bool stopping_ ABSL_GUARDED_BY(mu_) = false;
+};
+
 GzipOutputStream::Options::Options()
     : format(GZIP),
       buffer_size(kDefaultBufferSize),
       compression_level(Z_DEFAULT_COMPRESSION),
-      compression_strategy(Z_DEFAULT_STRATEGY) {}
+      compression_strategy(Z_DEFAULT_STRATEGY),
+      num_threads(1) {}
 
 GzipOutputStream::GzipOutputStream(ZeroCopyOutputStream* sub_stream) {
   Init(sub_stream, Options());
@@ -219,6 +661,15 @@ void GzipOutputStream::Init(ZeroCopyOutputStream* sub_stream,
   sub_data_ = NULL;
   sub_data_size_ = 0;
 
+  zcontext_.msg = NULL;
+  if (options.num_threads > 1) {
+    zerror_ = Z_OK;
+    input_buffer_ = NULL;
+    input_buffer_length_ = 0;
+    parallel_.reset(new ParallelDeflate(this, options));
+    return;
+  }
+
   input_buffer_length_ = options.buffer_size;
   input_buffer_ = operator new(input_buffer_length_);
   GOOGLE_ABSL_CHECK(input_buffer_ != NULL);
@@ -281,6 +732,7 @@ bool GzipOutputStream::Next(void** data, int* size) {
   if ((zerror_ != Z_OK) && (zerror_ != Z_BUF_ERROR)) {
     return false;
   }
+  if (parallel_ != nullptr) return parallel_->Next(data, size);
   if (zcontext_.avail_in != 0) {
     zerror_ = Deflate(Z_NO_FLUSH);
     if (zerror_ != Z_OK) {
@@ -300,14 +752,22 @@ bool GzipOutputStream::Next(void** data, int* size) {
   return true;
 }
 void GzipOutputStream::BackUp(int count) {
+  if (parallel_ != nullptr) {
+    parallel_->BackUp(count);
+    return;
+  }
   GOOGLE_ABSL_CHECK_GE(zcontext_.avail_in, static_cast<uInt>(count));
   zcontext_.avail_in -= count;
 }
 int64_t GzipOutputStream::ByteCount() const {
+  if (parallel_ != nullptr) return parallel_->ByteCount();
   return zcontext_.total_in + zcontext_.avail_in;
 }
 
 bool GzipOutputStream::Flush() {
+  if (parallel_ != nullptr) {
+    return zerror_ == Z_OK && parallel_->Flush();
+  }
   zerror_ = Deflate(Z_FULL_FLUSH);
   // Return true if the flush succeeded or if it was a no-op.
   return (zerror_ == Z_OK) ||
@@ -319,6 +779,11 @@ bool GzipOutputStream::Close() {
   if ((zerror_ != Z_OK) && (zerror_ != Z_BUF_ERROR)) {
     return false;
   }
+  if (parallel_ != nullptr) {
+    bool ok = parallel_->Close();
+    zerror_ = Z_STREAM_END;
+    return ok;
+  }
   do {
     zerror_ = Deflate(Z_FINISH);
   } while (zerror_ == Z_OK);
@@ -39,10 +39,17 @@
 //
 // GzipOutputStream is an ZeroCopyOutputStream that compresses data to
 // an underlying ZeroCopyOutputStream.
+//
+// Both can optionally move the work off the calling thread: GzipOutputStream
+// can compress independent blocks on a pool of worker threads (like pigz)
+// while still producing a single standard stream, and GzipInputStream can
+// decompress ahead of the reader on a background thread.
 
 #ifndef GOOGLE_PROTOBUF_IO_GZIP_STREAM_H__
 #define GOOGLE_PROTOBUF_IO_GZIP_STREAM_H__
 
+#include <memory>
+
 #include "google/protobuf/stubs/common.h"
 #include "google/protobuf/io/zero_copy_stream.h"
 #include "google/protobuf/port.h"
@@ -71,14 +78,36 @@ class PROTOBUF_EXPORT GzipInputStream PROTOBUF_FUTURE_FINAL
     ZLIB = 2,
   };
 
+  struct PROTOBUF_EXPORT Options {
+    // Defaults to AUTO.
+    Format format;
+
+    // Size of the buffers decompressed data is returned in.  Defaults to
+    // 64kB.
+    int buffer_size;
+
+    // If greater than zero, decompression runs on a background thread which
+    // stays up to this many buffers ahead of the reader, overlapping inflate
+    // with whatever the reader does with the data (e.g. parsing).  The
+    // underlying stream is then read from that thread and must not be used
+    // by anyone else until the GzipInputStream is destroyed.  Defaults to 0,
+    // which decompresses on the calling thread.
+    int read_ahead_buffers;
+
+    Options();  // Initializes with default values.
+  };
+
   // buffer_size and format may be -1 for default of 64kB and GZIP format
   explicit GzipInputStream(ZeroCopyInputStream* sub_stream,
                            Format format = AUTO, int buffer_size = -1);
+  GzipInputStream(ZeroCopyInputStream* sub_stream, const Options& options);
   GzipInputStream(const GzipInputStream&) = delete;
   GzipInputStream& operator=(const GzipInputStream&) = delete;
   ~GzipInputStream() override;
 
   // Return last error message or NULL if no error.
+  // With read-ahead enabled these are only meaningful once Next() returned
+  // false.
   inline const char* ZlibErrorMessage() const { return zcontext_.msg; }
   inline int ZlibErrorCode() const { return zerror_; }
 
@@ -89,6 +118,8 @@ class PROTOBUF_EXPORT GzipInputStream PROTOBUF_FUTURE_FINAL
   int64_t ByteCount() const override;
 
  private:
+  class ReadAhead;
+
   Format format_;
 
   ZeroCopyInputStream* sub_stream_;
@@ -101,8 +132,13 @@ class PROTOBUF_EXPORT GzipInputStream PROTOBUF_FUTURE_FINAL
   size_t output_buffer_length_;
   int64_t byte_count_;
 
+  // Set if decompression runs on a background thread.
+  std::unique_ptr<ReadAhead> read_ahead_;
+
   int Inflate(int flush);
   void DoNextOutput(const void** data, int* size);
+  // Decompresses the next chunk on the current thread.
+  bool InflateNext(const void** data, int* size);
 };
 
 class PROTOBUF_EXPORT GzipOutputStream PROTOBUF_FUTURE_FINAL
@@ -133,6 +169,16 @@ class PROTOBUF_EXPORT GzipOutputStream PROTOBUF_FUTURE_FINAL
     // zlib.h for definitions of these constants.
     int compression_strategy;
 
+    // Number of threads to compress with.  If greater than 1, the input is
+    // cut into blocks of buffer_size bytes which are deflated independently
+    // on a pool of this many worker threads, each primed with the last 32kB
+    // of the preceding input, and written out in order as a single stream
+    // that any gzip/zlib reader accepts.  This trades a slightly worse
+    // compression ratio and extra memory (up to two blocks per thread in
+    // flight) for throughput.  Defaults to 1, which compresses on the calling
+    // thread.
+    int num_threads;
+
     Options();  // Initializes with default values.
   };
 
@@ -176,6 +222,8 @@ class PROTOBUF_EXPORT GzipOutputStream PROTOBUF_FUTURE_FINAL
   int64_t ByteCount() const override;
 
  private:
+  class ParallelDeflate;
+
   ZeroCopyOutputStream* sub_stream_;
   // Result from calling Next() on sub_stream_
   void* sub_data_;
@@ -186,6 +234,10 @@ class PROTOBUF_EXPORT GzipOutputStream PROTOBUF_FUTURE_FINAL
   void* input_buffer_;
   size_t input_buffer_length_;
 
+  // Set if compression runs on worker threads.  zcontext_ and input_buffer_
+  // are unused then.
+  std::unique_ptr<ParallelDeflate> parallel_;
+
   // Shared constructor code.
   void Init(ZeroCopyOutputStream* sub_stream, const Options& options);
 
@@ -0,0 +1,296 @@
+// Protocol Buffers - Google's data interchange format
+// Copyright 2008 Google Inc.  All rights reserved.
+// https://developers.google.com/protocol-buffers/
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// This file contains the implementation of classes Lz4InputStream and
+// Lz4OutputStream.
+
+#include "google/protobuf/io/lz4_stream.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+#include "google/protobuf/stubs/logging.h"
+#include "google/protobuf/port.h"
+
+// The dictionary API of lz4frame.h.
+#define LZ4F_STATIC_LINKING_ONLY
+#include "lz4frame.h"
+
+// Must be included last.
+#include "google/protobuf/port_def.inc"
+
+namespace google {
+namespace protobuf {
+namespace io {
+
+static const int kDefaultBufferSize = 65536;
+
+Lz4InputStream::Options::Options() : buffer_size(kDefaultBufferSize) {}
+
+Lz4InputStream::Lz4InputStream(ZeroCopyInputStream* sub_stream)
+    : Lz4InputStream(sub_stream, Options()) {}
+
+Lz4InputStream::Lz4InputStream(ZeroCopyInputStream* sub_stream,
+                               const Options& options)
+    : sub_stream_(sub_stream),
+      dctx_(nullptr),
+      dictionary_(options.dictionary),
+      error_message_(nullptr),
+      input_(nullptr),
+      input_size_(0),
+      frame_remaining_(0),
+      output_full_(false),
+      output_buffer_length_(options.buffer_size > 0 ? options.buffer_size
+                                                    : kDefaultBufferSize),
+      byte_count_(0) {
+  size_t ret = LZ4F_createDecompressionContext(&dctx_, LZ4F_VERSION);
+  if (LZ4F_isError(ret)) error_message_ = LZ4F_getErrorName(ret);
+  output_buffer_ = static_cast<char*>(operator new(output_buffer_length_));
+  output_position_ = output_end_ = output_buffer_;
+}
+
+Lz4InputStream::~Lz4InputStream() {
+  // Give back compressed input that was not needed, e.g. data following the
+  // last frame.
+  if (input_size_ > 0) sub_stream_->BackUp(static_cast<int>(input_size_));
+  internal::SizedDelete(output_buffer_, output_buffer_length_);
+  LZ4F_freeDecompressionContext(dctx_);
+}
+
+// implements ZeroCopyInputStream ----------------------------------
+bool Lz4InputStream::Next(const void** data, int* size) {
+  if (output_position_ == output_end_) {
+    if (error_message_ != nullptr) return false;
+
+    size_t output_size = 0;
+    while (output_size == 0) {
+      if (input_size_ == 0 && !output_full_) {
+        const void* in;
+        int in_size;
+        if (!sub_stream_->Next(&in, &in_size)) {
+          if (frame_remaining_ != 0) {
+            error_message_ = "Truncated lz4 frame";
+          }
+          return false;
+        }
+        input_ = static_cast<const char*>(in);
+        input_size_ = in_size;
+      }
+      size_t consumed = input_size_;
+      output_size = output_buffer_length_;
+      size_t ret = LZ4F_decompress_usingDict(
+          dctx_, output_buffer_, &output_size, input_, &consumed,
+          dictionary_.data(), dictionary_.size(), nullptr);
+      if (LZ4F_isError(ret)) {
+        error_message_ = LZ4F_getErrorName(ret);
+        return false;
+      }
+      input_ += consumed;
+      input_size_ -= consumed;
+      frame_remaining_ = ret;
+      // Zero means the frame is done and all of it was output.
+      output_full_ = ret != 0 && output_size == output_buffer_length_;
+    }
+    output_position_ = output_buffer_;
+    output_end_ = output_buffer_ + output_size;
+  }
+
+  *data = output_position_;
+  *size = static_cast<int>(output_end_ - output_position_);
+  byte_count_ += *size;
+  output_position_ = output_end_;
+  return true;
+}
+
+void Lz4InputStream::BackUp(int count) {
+  GOOGLE_ABSL_CHECK_GE(count, 0);
+  GOOGLE_ABSL_CHECK_LE(count, output_position_ - output_buffer_);
+  output_position_ -= count;
+  byte_count_ -= count;
+}
+
+bool Lz4InputStream::Skip(int count) {
+  const void* data;
+  int size = 0;
+  bool ok = Next(&data, &size);
+  while (ok && (size < count)) {
+    count -= size;
+    ok = Next(&data, &size);
+  }
+  if (size > count) {
+    BackUp(size - count);
+  }
+  return ok;
+}
+
+int64_t Lz4InputStream::ByteCount() const { return byte_count_; }
+
+// =========================================================================
+
+Lz4OutputStream::Options::Options()
+    : buffer_size(kDefaultBufferSize), compression_level(0), checksum(true) {}
+
+Lz4OutputStream::Lz4OutputStream(ZeroCopyOutputStream* sub_stream)
+    : Lz4OutputStream(sub_stream, Options()) {}
+
+Lz4OutputStream::Lz4OutputStream(ZeroCopyOutputStream* sub_stream,
+                                 const Options& options)
+    : sub_stream_(sub_stream),
+      cctx_(nullptr),
+      cdict_(nullptr),
+      error_message_(nullptr),
+      started_(false),
+      closed_(false),
+      input_buffer_length_(options.buffer_size > 0 ? options.buffer_size
+                                                   : kDefaultBufferSize),
+      input_used_(0),
+      total_in_(0) {
+  memset(&preferences_, 0, sizeof(preferences_));
+  preferences_.compressionLevel = options.compression_level;
+  preferences_.frameInfo.contentChecksumFlag =
+      options.checksum ? LZ4F_contentChecksumEnabled : LZ4F_noContentChecksum;
+
+  size_t ret = LZ4F_createCompressionContext(&cctx_, LZ4F_VERSION);
+  if (LZ4F_isError(ret)) error_message_ = LZ4F_getErrorName(ret);
+  if (!options.dictionary.empty()) {
+    cdict_ = LZ4F_createCDict(options.dictionary.data(),
+                              options.dictionary.size());
+    if (cdict_ == nullptr) error_message_ = "Invalid lz4 dictionary";
+  }
+
+  input_buffer_ = static_cast<char*>(operator new(input_buffer_length_));
+  output_buffer_length_ =
+      std::max<size_t>(LZ4F_compressBound(input_buffer_length_, &preferences_),
+                       LZ4F_HEADER_SIZE_MAX);
+  output_buffer_ = static_cast<char*>(operator new(output_buffer_length_));
+}
+
+Lz4OutputStream::~Lz4OutputStream() {
+  if (!closed_) Close();
+  internal::SizedDelete(input_buffer_, input_buffer_length_);
+  internal::SizedDelete(output_buffer_, output_buffer_length_);
+  LZ4F_freeCDict(cdict_);
+  LZ4F_freeCompressionContext(cctx_);
+}
+
+// private
+bool Lz4OutputStream::WriteOutput(size_t result) {
+  if (LZ4F_isError(result)) {
+    error_message_ = LZ4F_getErrorName(result);
+    return false;
+  }
+  const char* in = output_buffer_;
+  while (result > 0) {
+    void* out;
+    int out_size;
+    if (!sub_stream_->Next(&out, &out_size)) {
+      error_message_ = "Error writing to underlying stream";
+      return false;
+    }
+    size_t n = std::min(result, static_cast<size_t>(out_size));
+    memcpy(out, in, n);
+    sub_stream_->BackUp(out_size - static_cast<int>(n));
+    in += n;
+    result -= n;
+  }
+  return true;
+}
+
+bool Lz4OutputStream::Compress(FlushMode mode) {
+  if (error_message_ != nullptr) return false;
+
+  if (!started_) {
+    started_ = true;
+    if (!WriteOutput(LZ4F_compressBegin_usingCDict(
+            cctx_, output_buffer_, output_buffer_length_, cdict_,
+            &preferences_))) {
+      return false;
+    }
+  }
+  if (input_used_ > 0) {
+    size_t input_size = input_used_;
+    total_in_ += input_used_;
+    input_used_ = 0;
+    if (!WriteOutput(LZ4F_compressUpdate(cctx_, output_buffer_,
+                                         output_buffer_length_, input_buffer_,
+                                         input_size, nullptr))) {
+      return false;
+    }
+  }
+  switch (mode) {
+    case kNoFlush:
+      return true;
+    case kFlush:
+      return WriteOutput(
+          LZ4F_flush(cctx_, output_buffer_, output_buffer_length_, nullptr));
+    case kEnd:
+      return WriteOutput(LZ4F_compressEnd(cctx_, output_buffer_,
+                                          output_buffer_length_, nullptr));
+  }
+  return false;
+}
+
+// implements ZeroCopyOutputStream ---------------------------------
+bool Lz4OutputStream::Next(void** data, int* size) {
+  if (closed_ || error_message_ != nullptr) return false;
+  if (input_used_ == input_buffer_length_ && !Compress(kNoFlush)) {
+    return false;
+  }
+  *data = input_buffer_ + input_used_;
+  *size = static_cast<int>(input_buffer_length_ - input_used_);
+  input_used_ = input_buffer_length_;
+  return true;
+}
+
+void Lz4OutputStream::BackUp(int count) {
+  GOOGLE_ABSL_CHECK_GE(count, 0);
+  GOOGLE_ABSL_CHECK_LE(static_cast<size_t>(count), input_used_);
+  input_used_ -= count;
+}
+
+int64_t Lz4OutputStream::ByteCount() const { return total_in_ + input_used_; }
+
+bool Lz4OutputStream::Flush() {
+  if (closed_) return false;
+  return Compress(kFlush);
+}
+
+bool Lz4OutputStream::Close() {
+  if (closed_) return false;
+  closed_ = true;
+  return Compress(kEnd);
+}
+
+}  // namespace io
+}  // namespace protobuf
+}  // namespace google
+
+#include "google/protobuf/port_undef.inc"
@@ -0,0 +1,212 @@
+// Protocol Buffers - Google's data interchange format
+// Copyright 2008 Google Inc.  All rights reserved.
+// https://developers.google.com/protocol-buffers/
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// This file contains the definition for classes Lz4InputStream and
+// Lz4OutputStream.
+//
+// Lz4InputStream decompresses LZ4 frames from an underlying
+// ZeroCopyInputStream and provides the decompressed data as a
+// ZeroCopyInputStream.
+//
+// Lz4OutputStream is a ZeroCopyOutputStream that compresses data to an
+// underlying ZeroCopyOutputStream.
+//
+// LZ4 compresses less than zlib or zstd but is fast enough to be worthwhile
+// even on local network links and fast disks.  The streams read and write
+// the standard LZ4 frame format, so the `lz4` tool can handle the data.
+// Both accept a dictionary, which makes small, similar payloads such as
+// single serialized messages compress well.
+
+#ifndef GOOGLE_PROTOBUF_IO_LZ4_STREAM_H__
+#define GOOGLE_PROTOBUF_IO_LZ4_STREAM_H__
+
+#include <cstddef>
+#include <cstdint>
+
+#include "google/protobuf/io/zero_copy_stream.h"
+#include "absl/strings/string_view.h"
+#include "lz4frame.h"
+
+// Must be included last.
+#include "google/protobuf/port_def.inc"
+
+// Dictionary support is only declared with LZ4F_STATIC_LINKING_ONLY.
+struct LZ4F_CDict_s;
+
+namespace google {
+namespace protobuf {
+namespace io {
+
+// A ZeroCopyInputStream that reads compressed data through lz4.
+//
+// Concatenated frames are decompressed as one stream.
+class PROTOBUF_EXPORT Lz4InputStream PROTOBUF_FUTURE_FINAL
+    : public ZeroCopyInputStream {
+ public:
+  struct PROTOBUF_EXPORT Options {
+    // Size of the buffers decompressed data is returned in.  Defaults to
+    // 64kB.
+    int buffer_size;
+
+    // Dictionary the data was compressed with, or empty for none.  Must stay
+    // alive as long as the stream.
+    absl::string_view dictionary;
+
+    Options();  // Initializes with default values.
+  };
+
+  explicit Lz4InputStream(ZeroCopyInputStream* sub_stream);
+  Lz4InputStream(ZeroCopyInputStream* sub_stream, const Options& options);
+  Lz4InputStream(const Lz4InputStream&) = delete;
+  Lz4InputStream& operator=(const Lz4InputStream&) = delete;
+  ~Lz4InputStream() override;
+
+  // Return last error message or NULL if no error.
+  inline const char* Lz4ErrorMessage() const { return error_message_; }
+
+  // implements ZeroCopyInputStream ----------------------------------
+  bool Next(const void** data, int* size) override;
+  void BackUp(int count) override;
+  bool Skip(int count) override;
+  int64_t ByteCount() const override;
+
+ private:
+  ZeroCopyInputStream* sub_stream_;
+  LZ4F_dctx* dctx_;
+  absl::string_view dictionary_;
+  const char* error_message_;
+
+  // Compressed input not yet consumed, from sub_stream_->Next().
+  const char* input_;
+  size_t input_size_;
+  // Hint returned by the last LZ4F_decompress() call; zero at the end of a
+  // frame.
+  size_t frame_remaining_;
+  // Set if the last call filled the output buffer, in which case lz4 may
+  // have more output without needing more input.
+  bool output_full_;
+
+  char* output_buffer_;
+  size_t output_buffer_length_;
+  // Decompressed bytes in output_buffer_ not yet returned by Next().
+  char* output_position_;
+  char* output_end_;
+  int64_t byte_count_;
+};
+
+class PROTOBUF_EXPORT Lz4OutputStream PROTOBUF_FUTURE_FINAL
+    : public ZeroCopyOutputStream {
+ public:
+  struct PROTOBUF_EXPORT Options {
+    // What size buffer to use internally.  Defaults to 64kB.
+    int buffer_size;
+
+    // 0 (the default) uses the fast compressor; values from 3 up to
+    // LZ4HC_CLEVEL_MAX (12) use the slower high compression one.
+    int compression_level;
+
+    // Dictionary to compress with, or empty for none.  The reader must use
+    // the same one.
+    absl::string_view dictionary;
+
+    // Whether to append a checksum of the uncompressed data to each frame.
+    // Defaults to true.
+    bool checksum;
+
+    Options();  // Initializes with default values.
+  };
+
+  // Create a Lz4OutputStream with default options.
+  explicit Lz4OutputStream(ZeroCopyOutputStream* sub_stream);
+
+  // Create a Lz4OutputStream with the given options.
+  Lz4OutputStream(ZeroCopyOutputStream* sub_stream, const Options& options);
+  Lz4OutputStream(const Lz4OutputStream&) = delete;
+  Lz4OutputStream& operator=(const Lz4OutputStream&) = delete;
+
+  ~Lz4OutputStream() override;
+
+  // Return last error message or NULL if no error.
+  inline const char* Lz4ErrorMessage() const { return error_message_; }
+
+  // Flushes data written so far to compressed data in the underlying stream,
+  // so that a reader can decompress all of it.  It is the caller's
+  // responsibility to flush the underlying stream if necessary.
+  // Returns true if no error.
+  bool Flush();
+
+  // Writes out all data and ends the lz4 frame.
+  // It is the caller's responsibility to close the underlying stream if
+  // necessary.
+  // Returns true if no error.
+  bool Close();
+
+  // implements ZeroCopyOutputStream ---------------------------------
+  bool Next(void** data, int* size) override;
+  void BackUp(int count) override;
+  int64_t ByteCount() const override;
+
+ private:
+  ZeroCopyOutputStream* sub_stream_;
+  LZ4F_cctx* cctx_;
+  LZ4F_CDict_s* cdict_;
+  LZ4F_preferences_t preferences_;
+  const char* error_message_;
+  bool started_;
+  bool closed_;
+
+  char* input_buffer_;
+  size_t input_buffer_length_;
+  size_t input_used_;
+  int64_t total_in_;
+
+  // LZ4F needs room for the worst case output of every call, so compressed
+  // data is staged here before being copied to sub_stream_.
+  char* output_buffer_;
+  size_t output_buffer_length_;
+
+  // Whether to finish the current block or the frame after compressing the
+  // buffered input.
+  enum FlushMode { kNoFlush, kFlush, kEnd };
+
+  // Compresses input_buffer_ into sub_stream_.
+  // Returns false on error.
+  bool Compress(FlushMode mode);
+  // Checks the result of an LZ4F call and writes the output it produced.
+  bool WriteOutput(size_t result);
+};
+
+}  // namespace io
+}  // namespace protobuf
+}  // namespace google
+
+#include "google/protobuf/port_undef.inc"
+
+#endif  // GOOGLE_PROTOBUF_IO_LZ4_STREAM_H__
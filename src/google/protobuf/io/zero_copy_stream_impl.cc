@@ -38,9 +38,15 @@
 #include <sys/types.h>
 #include <unistd.h>
 #endif
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/uio.h>
+#endif
 #include <errno.h>
 
 #include <algorithm>
+#include <climits>
+#include <cstring>
 #include <iostream>
 
 #include "google/protobuf/stubs/common.h"
@@ -78,6 +84,20 @@ int close_no_eintr(int fd) {
   return result;
 }
 
+int64_t PageSize() {
+#ifdef _WIN32
+  return 4096;
+#else
+  static const int64_t page_size = sysconf(_SC_PAGESIZE);
+  return page_size;
+#endif
+}
+
+int64_t RoundUpToPageSize(int64_t n) {
+  const int64_t page_size = PageSize();
+  return std::max(page_size, (n + page_size - 1) / page_size * page_size);
+}
+
 }  // namespace
 
 // ===================================================================
@@ -170,6 +190,160 @@ int FileInputStream::CopyingFileInputStream::Skip(int count) {
 
 // ===================================================================
 
+MmapInputStream::Options::Options()
+    : window_size(sizeof(void*) >= 8 ? int64_t{1} << 30 : int64_t{64} << 20),
+      min_mapped_size(int64_t{64} << 10) {}
+
+MmapInputStream::MmapInputStream(int file_descriptor)
+    : MmapInputStream(file_descriptor, Options()) {}
+
+MmapInputStream::MmapInputStream(int file_descriptor, const Options& options)
+    : file_(file_descriptor),
+      window_size_(RoundUpToPageSize(options.window_size)),
+      fallback_(file_descriptor) {
+#ifndef _WIN32
+  struct stat info;
+  if (fstat(file_, &info) != 0 || !S_ISREG(info.st_mode)) return;
+  off_t start = lseek(file_, 0, SEEK_CUR);
+  if (start == (off_t)-1) return;
+  if (info.st_size - start < options.min_mapped_size) return;
+
+  mapped_ = true;
+  start_ = position_ = start;
+  file_size_ = info.st_size;
+#endif
+}
+
+MmapInputStream::~MmapInputStream() {
+  if (mapped_ && !is_closed_) {
+    Unmap();
+    SyncFileOffset();
+  }
+}
+
+bool MmapInputStream::Close() {
+  if (mapped_) {
+    GOOGLE_ABSL_CHECK(!is_closed_);
+    is_closed_ = true;
+    Unmap();
+    SyncFileOffset();
+  }
+  return fallback_.Close();
+}
+
+bool MmapInputStream::Next(const void** data, int* size) {
+  if (!mapped_) return fallback_.Next(data, size);
+  GOOGLE_ABSL_CHECK(!is_closed_);
+
+  if (errno_ != 0) return false;
+  if (map_base_ == nullptr || position_ >= map_offset_ + map_size_) {
+    Unmap();
+    UpdateFileSize();
+    if (position_ >= file_size_) return false;
+    if (!MapWindow(position_)) {
+      // Some regular files can't be mapped after all, e.g. on file systems
+      // without mmap() support.  Read the rest of the file instead.
+      return FallBackToRead() && fallback_.Next(data, size);
+    }
+  }
+
+  const int64_t available = map_offset_ + map_size_ - position_;
+  *data = map_base_ + (position_ - map_offset_);
+  *size = static_cast<int>(std::min<int64_t>(available, INT_MAX));
+  position_ += *size;
+  return true;
+}
+
+void MmapInputStream::BackUp(int count) {
+  if (!mapped_) return fallback_.BackUp(count);
+  GOOGLE_ABSL_CHECK(map_base_ != nullptr)
+      << " BackUp() can only be called after Next().";
+  GOOGLE_ABSL_CHECK_GE(count, 0);
+  GOOGLE_ABSL_CHECK_LE(count, position_ - map_offset_)
+      << " Can't back up over more bytes than were returned by the last call"
+         " to Next().";
+  position_ -= count;
+}
+
+bool MmapInputStream::Skip(int count) {
+  if (!mapped_) return fallback_.Skip(count);
+  GOOGLE_ABSL_CHECK_GE(count, 0);
+
+  if (errno_ != 0) return false;
+  if (count > file_size_ - position_) {
+    position_ = file_size_;
+    return false;
+  }
+  position_ += count;
+  return true;
+}
+
+int64_t MmapInputStream::ByteCount() const {
+  return mapped_ ? position_ - start_
+                 : fallback_offset_ + fallback_.ByteCount();
+}
+
+void MmapInputStream::UpdateFileSize() {
+#ifndef _WIN32
+  // Pages past the end of a file that shrank can't be touched, and a file that
+  // grew is read to its new end like read() would.
+  struct stat info;
+  if (fstat(file_, &info) == 0) file_size_ = info.st_size;
+#endif
+}
+
+bool MmapInputStream::FallBackToRead() {
+  if (lseek(file_, static_cast<off_t>(position_), SEEK_SET) == (off_t)-1) {
+    errno_ = errno;
+    return false;
+  }
+  fallback_offset_ = position_ - start_;
+  mapped_ = false;
+  return true;
+}
+
+bool MmapInputStream::MapWindow(int64_t position) {
+#ifdef _WIN32
+  (void)position;
+  return false;
+#else
+  const int64_t offset = position - position % PageSize();
+  const int64_t size = std::min(window_size_, file_size_ - offset);
+  void* base = mmap(nullptr, static_cast<size_t>(size), PROT_READ, MAP_PRIVATE,
+                    file_, static_cast<off_t>(offset));
+  if (base == MAP_FAILED) return false;
+  // The window is read front to back: ask for aggressive read-ahead of all of
+  // it, and for pages behind the read position to be dropped early.
+#ifdef MADV_SEQUENTIAL
+  madvise(base, static_cast<size_t>(size), MADV_SEQUENTIAL);
+#endif
+#ifdef MADV_WILLNEED
+  madvise(base, static_cast<size_t>(size), MADV_WILLNEED);
+#endif
+  map_base_ = static_cast<char*>(base);
+  map_offset_ = offset;
+  map_size_ = size;
+  return true;
+#endif
+}
+
+void MmapInputStream::Unmap() {
+#ifndef _WIN32
+  if (map_base_ != nullptr) {
+    munmap(map_base_, static_cast<size_t>(map_size_));
+  }
+#endif
+  map_base_ = nullptr;
+  map_offset_ = 0;
+  map_size_ = 0;
+}
+
+void MmapInputStream::SyncFileOffset() {
+  lseek(file_, static_cast<off_t>(position_), SEEK_SET);
+}
+
+// ===================================================================
+
 FileOutputStream::FileOutputStream(int file_descriptor, int block_size)
     : CopyingOutputStreamAdaptor(&copying_output_, block_size),
       copying_output_(file_descriptor) {}
@@ -248,6 +422,152 @@ bool FileOutputStream::CopyingFileOutputStream::Write(const void* buffer,
 
 // ===================================================================
 
+namespace {
+
+constexpr int kDefaultVectoredBlockSize = 64 << 10;
+constexpr int kDefaultMinAliasedSize = 4 << 10;
+// Slices passed to a single writev() call.
+constexpr int kMaxIovecs = 64;
+// Pending slices after which aliased writes trigger a flush.
+constexpr size_t kMaxPendingSlices = 1024;
+
+}  // namespace
+
+VectoredFileOutputStream::VectoredFileOutputStream(int file_descriptor,
+                                                   int block_size,
+                                                   int min_aliased_size)
+    : file_(file_descriptor),
+      block_size_(block_size > 0 ? block_size : kDefaultVectoredBlockSize),
+      min_aliased_size_(min_aliased_size >= 0 ? min_aliased_size
+                                              : kDefaultMinAliasedSize) {}
+
+VectoredFileOutputStream::~VectoredFileOutputStream() {
+  if (is_closed_) return;
+  Flush();
+  if (close_on_delete_ && close_no_eintr(file_) != 0) {
+    GOOGLE_ABSL_LOG(ERROR) << "close() failed: " << strerror(errno);
+  }
+}
+
+bool VectoredFileOutputStream::Close() {
+  GOOGLE_ABSL_CHECK(!is_closed_);
+  bool flush_succeeded = Flush();
+  is_closed_ = true;
+  if (close_no_eintr(file_) != 0) {
+    errno_ = errno;
+    return false;
+  }
+  return flush_succeeded;
+}
+
+bool VectoredFileOutputStream::Flush() {
+  GOOGLE_ABSL_CHECK(!is_closed_);
+  AddBufferSlice();
+
+  bool ok = errno_ == 0;
+  size_t first = 0;
+  while (ok && first < slices_.size()) {
+    int64_t bytes;
+#ifndef _WIN32
+    iovec iov[kMaxIovecs];
+    int count = 0;
+    for (size_t i = first; i < slices_.size() && count < kMaxIovecs; ++i) {
+      iov[count].iov_base = const_cast<char*>(slices_[i].data);
+      iov[count].iov_len = slices_[i].size;
+      ++count;
+    }
+    do {
+      bytes = writev(file_, iov, count);
+    } while (bytes < 0 && errno == EINTR);
+#else
+    do {
+      bytes = write(file_, slices_[first].data, slices_[first].size);
+    } while (bytes < 0 && errno == EINTR);
+#endif
+    if (bytes <= 0) {
+      // See CopyingFileOutputStream::Write() for why zero is an error.
+      if (bytes < 0) errno_ = errno;
+      ok = false;
+      break;
+    }
+
+    // Skip what was written; writev() may stop in the middle of a slice.
+    size_t written = static_cast<size_t>(bytes);
+    while (written > 0) {
+      Slice& slice = slices_[first];
+      if (written < slice.size) {
+        slice.data += written;
+        slice.size -= written;
+        break;
+      }
+      written -= slice.size;
+      ++first;
+    }
+  }
+
+  slices_.clear();
+  buffer_used_ = 0;
+  buffer_slice_start_ = 0;
+  return ok;
+}
+
+bool VectoredFileOutputStream::Next(void** data, int* size) {
+  if (errno_ != 0) return false;
+  if (buffer_used_ == block_size_ && !Flush()) return false;
+  if (buffer_ == nullptr) buffer_.reset(new char[block_size_]);
+
+  *data = buffer_.get() + buffer_used_;
+  *size = block_size_ - buffer_used_;
+  buffer_used_ = block_size_;
+  return true;
+}
+
+void VectoredFileOutputStream::BackUp(int count) {
+  GOOGLE_ABSL_CHECK_GE(count, 0);
+  GOOGLE_ABSL_CHECK_LE(count, buffer_used_ - buffer_slice_start_)
+      << " Can't back up over more bytes than were returned by the last call"
+         " to Next().";
+  buffer_used_ -= count;
+}
+
+int64_t VectoredFileOutputStream::ByteCount() const {
+  return position_ + buffer_used_ - buffer_slice_start_;
+}
+
+bool VectoredFileOutputStream::WriteAliasedRaw(const void* data, int size) {
+  if (errno_ != 0) return false;
+  if (size < min_aliased_size_) {
+    // Not worth a slice of its own: copy it.
+    const char* in = static_cast<const char*>(data);
+    while (size > 0) {
+      void* out;
+      int out_size;
+      if (!Next(&out, &out_size)) return false;
+      int n = std::min(size, out_size);
+      memcpy(out, in, n);
+      BackUp(out_size - n);
+      in += n;
+      size -= n;
+    }
+    return true;
+  }
+
+  AddBufferSlice();
+  slices_.push_back({static_cast<const char*>(data), static_cast<size_t>(size)});
+  position_ += size;
+  return slices_.size() < kMaxPendingSlices || Flush();
+}
+
+void VectoredFileOutputStream::AddBufferSlice() {
+  if (buffer_used_ == buffer_slice_start_) return;
+  slices_.push_back({buffer_.get() + buffer_slice_start_,
+                     static_cast<size_t>(buffer_used_ - buffer_slice_start_)});
+  position_ += buffer_used_ - buffer_slice_start_;
+  buffer_slice_start_ = buffer_used_;
+}
+
+// ===================================================================
+
 IstreamInputStream::IstreamInputStream(std::istream* input, int block_size)
     : copying_input_(input), impl_(&copying_input_, block_size) {}
 
@@ -40,8 +40,11 @@
 #ifndef GOOGLE_PROTOBUF_IO_ZERO_COPY_STREAM_IMPL_H__
 #define GOOGLE_PROTOBUF_IO_ZERO_COPY_STREAM_IMPL_H__
 
+#include <cstdint>
 #include <iosfwd>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "google/protobuf/stubs/common.h"
 #include "google/protobuf/io/zero_copy_stream.h"
@@ -134,6 +137,117 @@ class PROTOBUF_EXPORT FileInputStream PROTOBUF_FUTURE_FINAL
 
 // ===================================================================
 
+// A ZeroCopyInputStream which reads a file descriptor by memory mapping it.
+//
+// Next() returns the mapped file contents directly, so data is never copied
+// out of the page cache.  Files are mapped in windows of at most
+// Options::window_size bytes, each of which is returned by a single call to
+// Next() (or a few, if the window exceeds INT_MAX).  Only one window is
+// mapped at a time, which bounds the address space used for large files.
+//
+// Like FileInputStream, reading starts at the current offset of the file
+// descriptor.  When the stream is destroyed or closed, the offset is moved
+// past the bytes consumed from the stream.
+//
+// Only regular files are mapped.  For anything else (e.g. a pipe or socket, or
+// a platform without mmap()), or for files too small for mapping to pay off,
+// the stream reads like FileInputStream.  It also switches to read() for the
+// rest of the file if mapping a window fails.
+//
+// The size of the file is checked again before each window is mapped, so a
+// file that shrinks ends at its new size.  A file truncated within the window
+// that is being read can't be handled, though: on POSIX systems, touching the
+// pages past its new end raises SIGBUS.  Only use this stream for files that
+// are not truncated concurrently.  MessageLite::ParseFromFileDescriptor()
+// uses FileInputStream; pass an MmapInputStream to
+// MessageLite::ParseFromZeroCopyStream() to parse from a mapped file.
+//
+// Buffers returned by Next() are only valid until the next call to Next(),
+// Skip() or Close(), or until the stream is destroyed.
+class PROTOBUF_EXPORT MmapInputStream PROTOBUF_FUTURE_FINAL
+    : public ZeroCopyInputStream {
+ public:
+  struct PROTOBUF_EXPORT Options {
+    // Maximum number of bytes mapped at once.  Rounded up to a multiple of the
+    // page size.  Defaults to 1GB on 64-bit platforms and 64MB otherwise.
+    int64_t window_size;
+
+    // Files with fewer bytes than this left to read are read with read()
+    // instead, as mapping them costs more than copying.  Defaults to 64kB.
+    int64_t min_mapped_size;
+
+    Options();  // Initializes with default values.
+  };
+
+  // Creates a stream that reads from the given Unix file descriptor.
+  explicit MmapInputStream(int file_descriptor);
+  MmapInputStream(int file_descriptor, const Options& options);
+  MmapInputStream(const MmapInputStream&) = delete;
+  MmapInputStream& operator=(const MmapInputStream&) = delete;
+  ~MmapInputStream() override;
+
+  // Unmaps the file and closes it.  Returns false if an error occurs during
+  // the process; use GetErrno() to examine the error.  Even if an error
+  // occurs, the file descriptor is closed when this returns.
+  bool Close();
+
+  // By default, the file descriptor is not closed when the stream is
+  // destroyed.  Call SetCloseOnDelete(true) to change that.
+  void SetCloseOnDelete(bool value) { fallback_.SetCloseOnDelete(value); }
+
+  // If an I/O error has occurred on this file descriptor, this is the
+  // errno from that error.  Otherwise, this is zero.  Once an error
+  // occurs, the stream is broken and all subsequent operations will
+  // fail.
+  int GetErrno() const { return errno_ != 0 ? errno_ : fallback_.GetErrno(); }
+
+  // Returns true if the file is read through memory mappings, false if the
+  // stream fell back to read().
+  bool is_mapped() const { return mapped_; }
+
+  // implements ZeroCopyInputStream ----------------------------------
+  bool Next(const void** data, int* size) override;
+  void BackUp(int count) override;
+  bool Skip(int count) override;
+  int64_t ByteCount() const override;
+
+ private:
+  // Re-reads the size of the file before a new window is mapped.
+  void UpdateFileSize();
+  // Continues with read() from position_ after a mapping failed.
+  bool FallBackToRead();
+  // Maps the window containing file offset `position`.
+  bool MapWindow(int64_t position);
+  void Unmap();
+  // Moves the file offset to position_, as if the consumed bytes were read.
+  void SyncFileOffset();
+
+  const int file_;
+  const int64_t window_size_;
+  bool mapped_ = false;
+  bool is_closed_ = false;
+  int errno_ = 0;
+
+  // File offsets of the first byte to read, the next byte to return from
+  // Next() and the end of the file.
+  int64_t start_ = 0;
+  int64_t position_ = 0;
+  int64_t file_size_ = 0;
+
+  // The current mapping, covering file offsets [map_offset_, map_offset_ +
+  // map_size_).
+  char* map_base_ = nullptr;
+  int64_t map_offset_ = 0;
+  int64_t map_size_ = 0;
+
+  // Used when the file is not mapped.  fallback_offset_ is the number of bytes
+  // consumed from the mappings before falling back.
+  FileInputStream fallback_;
+  int64_t fallback_offset_ = 0;
+};
+
+// ===================================================================
+
 // A ZeroCopyOutputStream which writes to a file descriptor.
 //
 // FileOutputStream is preferred over using an ofstream with
@@ -203,6 +317,97 @@ class PROTOBUF_EXPORT FileOutputStream PROTOBUF_FUTURE_FINAL
 
 // ===================================================================
 
+// A ZeroCopyOutputStream which writes to a file descriptor with writev(),
+// referencing large aliased buffers instead of copying them.
+//
+// The stream allows aliasing: with a CodedOutputStream on top of it and
+// EnableAliasing(true), large string and bytes fields are recorded as
+// (pointer, length) slices and written straight from the message, in the
+// same writev() call as the encoded data around them.  Aliased data must stay
+// alive and unchanged until the next Flush(), Close() or the destruction of
+// the stream.
+//
+//   VectoredFileOutputStream output(socket_fd);
+//   {
+//     CodedOutputStream coded_output(&output);
+//     coded_output.EnableAliasing(true);
+//     message.SerializeToCodedStream(&coded_output);
+//   }
+//   output.Flush();
+//
+// Without aliasing, this behaves like FileOutputStream.
+class PROTOBUF_EXPORT VectoredFileOutputStream PROTOBUF_FUTURE_FINAL
+    : public ZeroCopyOutputStream {
+ public:
+  // Creates a stream that writes to the given Unix file descriptor.
+  // If a block_size is given, it specifies the size of the buffers
+  // that should be returned by Next().  Otherwise, a reasonable default
+  // is used.  Aliased writes smaller than min_aliased_size are copied.
+  explicit VectoredFileOutputStream(int file_descriptor, int block_size = -1,
+                                    int min_aliased_size = -1);
+  VectoredFileOutputStream(const VectoredFileOutputStream&) = delete;
+  VectoredFileOutputStream& operator=(const VectoredFileOutputStream&) =
+      delete;
+  ~VectoredFileOutputStream() override;
+
+  // Flushes any buffers and closes the underlying file.  Returns false if
+  // an error occurs during the process; use GetErrno() to examine the error.
+  // Even if an error occurs, the file descriptor is closed when this returns.
+  bool Close();
+
+  // Writes all buffered and aliased data.  Returns false if an error
+  // occurred.
+  bool Flush();
+
+  // By default, the file descriptor is not closed when the stream is
+  // destroyed.  Call SetCloseOnDelete(true) to change that.  WARNING:
+  // This leaves no way for the caller to detect if close() fails.  If
+  // detecting close() errors is important to you, you should arrange
+  // to close the descriptor yourself.
+  void SetCloseOnDelete(bool value) { close_on_delete_ = value; }
+
+  // If an I/O error has occurred on this file descriptor, this is the
+  // errno from that error.  Otherwise, this is zero.  Once an error
+  // occurs, the stream is broken and all subsequent operations will
+  // fail.
+  int GetErrno() const { return errno_; }
+
+  // implements ZeroCopyOutputStream ---------------------------------
+  bool Next(void** data, int* size) override;
+  void BackUp(int count) override;
+  int64_t ByteCount() const override;
+  bool WriteAliasedRaw(const void* data, int size) override;
+  bool AllowsAliasing() const override { return true; }
+
+ private:
+  struct Slice {
+    const char* data;
+    size_t size;
+  };
+
+  // Appends the part of buffer_ filled since the last slice to slices_.
+  void AddBufferSlice();
+
+  const int file_;
+  const int block_size_;
+  const int min_aliased_size_;
+  bool close_on_delete_ = false;
+  bool is_closed_ = false;
+  int errno_ = 0;
+
+  std::unique_ptr<char[]> buffer_;
+  // Bytes of buffer_ handed out by Next() and not backed up.
+  int buffer_used_ = 0;
+  // Start of the part of buffer_ not yet in slices_.
+  int buffer_slice_start_ = 0;
+  // Data to write with the next writev(), in order.
+  std::vector<Slice> slices_;
+  // Bytes written or recorded in slices_, excluding the tail of buffer_.
+  int64_t position_ = 0;
+};
+
+// ===================================================================
+
 // A ZeroCopyInputStream which reads from a C++ istream.
 //
 // Note that for reading files (or anything represented by a file descriptor),
@@ -70,6 +70,7 @@
 #include "absl/strings/cord.h"
 #include "absl/strings/cord_buffer.h"
 #include "absl/strings/string_view.h"
+#include "google/protobuf/io/async_file_stream.h"
 #include "google/protobuf/io/coded_stream.h"
 #include "google/protobuf/io/io_win32.h"
 #include "google/protobuf/io/zero_copy_stream_impl.h"
@@ -79,6 +80,14 @@
 #include "google/protobuf/io/gzip_stream.h"
 #endif
 
+#if HAVE_ZSTD
+#include "google/protobuf/io/zstd_stream.h"
+#endif
+
+#if HAVE_LZ4
+#include "google/protobuf/io/lz4_stream.h"
+#endif
+
 #include "google/protobuf/stubs/common.h"
 #include "google/protobuf/testing/file.h"
 #include "google/protobuf/testing/googletest.h"
@@ -491,6 +500,114 @@ TEST_F(IoTest, GzipIoReadAfterFlush) {
   delete[] buffer;
 }
 
+TEST_F(IoTest, GzipIoParallel) {
+  const int kBufferSize = 16 * 1024;
+  uint8* buffer = new uint8[kBufferSize];
+  for (GzipOutputStream::Format format :
+       {GzipOutputStream::GZIP, GzipOutputStream::ZLIB}) {
+    for (int i = 0; i < kBlockSizeCount; i++) {
+      for (int z = 0; z < kBlockSizeCount; z++) {
+        int gzip_buffer_size = kBlockSizes[z];
+        int size;
+        {
+          ArrayOutputStream output(buffer, kBufferSize, kBlockSizes[i]);
+          GzipOutputStream::Options options;
+          options.format = format;
+          options.num_threads = 4;
+          if (gzip_buffer_size != -1) {
+            options.buffer_size = gzip_buffer_size;
+          }
+          GzipOutputStream gzout(&output, options);
+          WriteStuff(&gzout);
+          if (i % 2 == 0) EXPECT_TRUE(gzout.Flush());
+          EXPECT_TRUE(gzout.Close());
+          size = output.ByteCount();
+        }
+        {
+          ArrayInputStream input(buffer, size, kBlockSizes[i]);
+          GzipInputStream gzin(&input, format == GzipOutputStream::GZIP
+                                           ? GzipInputStream::GZIP
+                                           : GzipInputStream::ZLIB);
+          ReadStuff(&gzin);
+        }
+      }
+    }
+  }
+  delete[] buffer;
+}
+
+TEST_F(IoTest, GzipIoParallelLarge) {
+  GzipOutputStream::Options options;
+  options.buffer_size = 4096;
+  options.num_threads = 4;
+  std::string parallel;
+  {
+    StringOutputStream output(&parallel);
+    GzipOutputStream gzout(&output, options);
+    WriteStuffLarge(&gzout);
+    EXPECT_EQ(gzout.ByteCount(), 200055);
+    EXPECT_TRUE(gzout.Close());
+  }
+
+  ArrayInputStream input(parallel.data(), parallel.size());
+  GzipInputStream gzin(&input);
+  ReadStuffLarge(&gzin);
+  EXPECT_EQ(gzin.ZlibErrorCode(), Z_STREAM_END);
+}
+
+TEST_F(IoTest, GzipIoReadAhead) {
+  const int kBufferSize = 2 * 1024;
+  uint8* buffer = new uint8[kBufferSize];
+  for (int i = 0; i < kBlockSizeCount; i++) {
+    for (int j = 0; j < kBlockSizeCount; j++) {
+      int size;
+      {
+        ArrayOutputStream output(buffer, kBufferSize, kBlockSizes[i]);
+        GzipOutputStream gzout(&output);
+        WriteStuff(&gzout);
+        gzout.Close();
+        size = output.ByteCount();
+      }
+      {
+        ArrayInputStream input(buffer, size, kBlockSizes[i]);
+        GzipInputStream::Options options;
+        options.read_ahead_buffers = 2;
+        if (kBlockSizes[j] != -1) {
+          options.buffer_size = kBlockSizes[j];
+        }
+        GzipInputStream gzin(&input, options);
+        ReadStuff(&gzin);
+      }
+    }
+  }
+  delete[] buffer;
+}
+
+TEST_F(IoTest, GzipIoReadAheadLarge) {
+  std::string compressed;
+  {
+    StringOutputStream output(&compressed);
+    GzipOutputStream gzout(&output);
+    WriteStuffLarge(&gzout);
+    EXPECT_TRUE(gzout.Close());
+  }
+  // Stop reading half way, with decompression still under way.
+  for (int read_all = 0; read_all < 2; read_all++) {
+    ArrayInputStream input(compressed.data(), compressed.size(), 1000);
+    GzipInputStream::Options options;
+    options.buffer_size = 4096;
+    options.read_ahead_buffers = 4;
+    GzipInputStream gzin(&input, options);
+    if (read_all) {
+      ReadStuffLarge(&gzin);
+      EXPECT_EQ(gzin.ZlibErrorCode(), Z_STREAM_END);
+    } else {
+      ReadString(&gzin, "Hello world!\nSome text.  ");
+      EXPECT_EQ(gzin.ByteCount(), 25);
+    }
+  }
+}
+
 TEST_F(IoTest, ZlibIo) {
   const int kBufferSize = 2 * 1024;
   uint8* buffer = new uint8[kBufferSize];
@@ -718,6 +835,250 @@ TEST_F(IoTest, GzipInputByteCountAfterClosedConcatenatedStreams) {
 }
 #endif
 
+#if HAVE_ZSTD
+TEST_F(IoTest, ZstdIo) {
+  const int kBufferSize = 2 * 1024;
+  uint8* buffer = new uint8[kBufferSize];
+  for (int i = 0; i < kBlockSizeCount; i++) {
+    for (int j = 0; j < kBlockSizeCount; j++) {
+      for (int z = 0; z < kBlockSizeCount; z++) {
+        int size;
+        {
+          ArrayOutputStream output(buffer, kBufferSize, kBlockSizes[i]);
+          ZstdOutputStream::Options options;
+          if (kBlockSizes[z] != -1) {
+            options.buffer_size = kBlockSizes[z];
+          }
+          ZstdOutputStream zout(&output, options);
+          WriteStuff(&zout);
+          if (z % 2 == 0) EXPECT_TRUE(zout.Flush());
+          EXPECT_TRUE(zout.Close());
+          size = output.ByteCount();
+        }
+        {
+          ArrayInputStream input(buffer, size, kBlockSizes[j]);
+          ZstdInputStream::Options options;
+          if (kBlockSizes[z] != -1) {
+            options.buffer_size = kBlockSizes[z];
+          }
+          ZstdInputStream zin(&input, options);
+          ReadStuff(&zin);
+          EXPECT_EQ(zin.ZstdErrorMessage(), nullptr);
+        }
+      }
+    }
+  }
+  delete[] buffer;
+}
+
+TEST_F(IoTest, ZstdIoLarge) {
+  std::string compressed;
+  {
+    StringOutputStream output(&compressed);
+    ZstdOutputStream zout(&output);
+    WriteStuffLarge(&zout);
+    EXPECT_EQ(zout.ByteCount(), 200055);
+  }
+  EXPECT_LT(compressed.size(), 1000);
+
+  ArrayInputStream input(compressed.data(), compressed.size(), 100);
+  ZstdInputStream zin(&input);
+  ReadStuffLarge(&zin);
+  EXPECT_EQ(zin.ZstdErrorMessage(), nullptr);
+}
+
+TEST_F(IoTest, ZstdIoConcatenatedAndTruncated) {
+  std::string compressed;
+  {
+    StringOutputStream output(&compressed);
+    ZstdOutputStream zout(&output);
+    WriteString(&zout, "Hello world!\n");
+  }
+  {
+    StringOutputStream output(&compressed);
+    ZstdOutputStream zout(&output);
+    WriteString(&zout, "Some text.");
+  }
+  {
+    ArrayInputStream input(compressed.data(), compressed.size(), 5);
+    ZstdInputStream zin(&input);
+    ReadString(&zin, "Hello world!\nSome text.");
+    uint8 byte;
+    EXPECT_EQ(ReadFromInput(&zin, &byte, 1), 0);
+    EXPECT_EQ(zin.ZstdErrorMessage(), nullptr);
+  }
+  {
+    ArrayInputStream input(compressed.data(), compressed.size() - 1);
+    ZstdInputStream zin(&input);
+    ReadString(&zin, "Hello world!\n");
+    char buffer[20];
+    ReadFromInput(&zin, buffer, sizeof(buffer));
+    EXPECT_NE(zin.ZstdErrorMessage(), nullptr);
+  }
+}
+
+TEST_F(IoTest, ZstdIoDictionary) {
+  const std::string dictionary =
+      "optional_int32: 101 optional_string: \"hello world\" "
+      "repeated_string: \"the quick brown fox jumps over the lazy dog\"";
+  const std::string message =
+      "optional_int32: 102 optional_string: \"hello world!\" "
+      "repeated_string: \"the quick brown fox jumps over the lazy cat\"";
+
+  ZstdOutputStream::Options options;
+  std::string plain;
+  {
+    StringOutputStream output(&plain);
+    ZstdOutputStream zout(&output, options);
+    WriteString(&zout, message);
+  }
+  options.dictionary = dictionary;
+  std::string with_dictionary;
+  {
+    StringOutputStream output(&with_dictionary);
+    ZstdOutputStream zout(&output, options);
+    WriteString(&zout, message);
+  }
+  EXPECT_LT(with_dictionary.size(), plain.size() / 2);
+
+  {
+    ArrayInputStream input(with_dictionary.data(), with_dictionary.size());
+    ZstdInputStream::Options input_options;
+    input_options.dictionary = dictionary;
+    ZstdInputStream zin(&input, input_options);
+    ReadString(&zin, message);
+    EXPECT_EQ(zin.ZstdErrorMessage(), nullptr);
+  }
+  {
+    ArrayInputStream input(with_dictionary.data(), with_dictionary.size());
+    ZstdInputStream zin(&input);
+    const void* data;
+    int size;
+    EXPECT_FALSE(zin.Next(&data, &size));
+    EXPECT_NE(zin.ZstdErrorMessage(), nullptr);
+  }
+}
+#endif  // HAVE_ZSTD
+
+#if HAVE_LZ4
+TEST_F(IoTest, Lz4Io) {
+  const int kBufferSize = 4 * 1024;
+  uint8* buffer = new uint8[kBufferSize];
+  for (int i = 0; i < kBlockSizeCount; i++) {
+    for (int j = 0; j < kBlockSizeCount; j++) {
+      for (int z = 0; z < kBlockSizeCount; z++) {
+        int size;
+        {
+          ArrayOutputStream output(buffer, kBufferSize, kBlockSizes[i]);
+          Lz4OutputStream::Options options;
+          if (kBlockSizes[z] != -1) {
+            options.buffer_size = kBlockSizes[z];
+          }
+          Lz4OutputStream lzout(&output, options);
+          WriteStuff(&lzout);
+          if (z % 2 == 0) EXPECT_TRUE(lzout.Flush());
+          EXPECT_TRUE(lzout.Close());
+          size = output.ByteCount();
+        }
+        {
+          ArrayInputStream input(buffer, size, kBlockSizes[j]);
+          Lz4InputStream::Options options;
+          if (kBlockSizes[z] != -1) {
+            options.buffer_size = kBlockSizes[z];
+          }
+          Lz4InputStream lzin(&input, options);
+          ReadStuff(&lzin);
+          EXPECT_EQ(lzin.Lz4ErrorMessage(), nullptr);
+        }
+      }
+    }
+  }
+  delete[] buffer;
+}
+
+TEST_F(IoTest, Lz4IoLarge) {
+  for (int level : {0, 9}) {
+    std::string compressed;
+    {
+      StringOutputStream output(&compressed);
+      Lz4OutputStream::Options options;
+      options.compression_level = level;
+      Lz4OutputStream lzout(&output, options);
+      WriteStuffLarge(&lzout);
+      EXPECT_EQ(lzout.ByteCount(), 200055);
+    }
+    EXPECT_LT(compressed.size(), 10000);
+
+    ArrayInputStream input(compressed.data(), compressed.size(), 100);
+    Lz4InputStream lzin(&input);
+    ReadStuffLarge(&lzin);
+    EXPECT_EQ(lzin.Lz4ErrorMessage(), nullptr);
+  }
+}
+
+TEST_F(IoTest, Lz4IoConcatenatedAndTruncated) {
+  std::string compressed;
+  {
+    StringOutputStream output(&compressed);
+    Lz4OutputStream lzout(&output);
+    WriteString(&lzout, "Hello world!\n");
+  }
+  {
+    StringOutputStream output(&compressed);
+    Lz4OutputStream lzout(&output);
+    WriteString(&lzout, "Some text.");
+  }
+  {
+    ArrayInputStream input(compressed.data(), compressed.size(), 5);
+    Lz4InputStream lzin(&input);
+    ReadString(&lzin, "Hello world!\nSome text.");
+    uint8 byte;
+    EXPECT_EQ(ReadFromInput(&lzin, &byte, 1), 0);
+    EXPECT_EQ(lzin.Lz4ErrorMessage(), nullptr);
+  }
+  {
+    ArrayInputStream input(compressed.data(), compressed.size() - 1);
+    Lz4InputStream lzin(&input);
+    ReadString(&lzin, "Hello world!\n");
+    char buffer[20];
+    ReadFromInput(&lzin, buffer, sizeof(buffer));
+    EXPECT_NE(lzin.Lz4ErrorMessage(), nullptr);
+  }
+}
+
+TEST_F(IoTest, Lz4IoDictionary) {
+  const std::string dictionary =
+      "optional_int32: 101 optional_string: \"hello world\" "
+      "repeated_string: \"the quick brown fox jumps over the lazy dog\"";
+  const std::string message =
+      "optional_int32: 102 optional_string: \"hello world!\" "
+      "repeated_string: \"the quick brown fox jumps over the lazy cat\"";
+
+  Lz4OutputStream::Options options;
+  std::string plain;
+  {
+    StringOutputStream output(&plain);
+    Lz4OutputStream lzout(&output, options);
+    WriteString(&lzout, message);
+  }
+  options.dictionary = dictionary;
+  std::string with_dictionary;
+  {
+    StringOutputStream output(&with_dictionary);
+    Lz4OutputStream lzout(&output, options);
+    WriteString(&lzout, message);
+  }
+  EXPECT_LT(with_dictionary.size(), plain.size() / 2);
+
+  ArrayInputStream input(with_dictionary.data(), with_dictionary.size());
+  Lz4InputStream::Options input_options;
+  input_options.dictionary = dictionary;
+  Lz4InputStream lzin(&input, input_options);
+  ReadString(&lzin, message);
+  EXPECT_EQ(lzin.Lz4ErrorMessage(), nullptr);
+}
+#endif  // HAVE_LZ4
+
 // There is no string input, only string output.  Also, it doesn't support
 // explicit block sizes.  So, we'll only run one test and we'll use
 // ArrayInput to read back the results.
@@ -1476,6 +1837,230 @@ TEST_F(IoTest, FileIo) {
   }
 }
 
+TEST_F(IoTest, VectoredFileIo) {
+  std::string filename = TestTempDir() + "/zero_copy_stream_test_file";
+
+  for (int i = 0; i < kBlockSizeCount; i++) {
+    int file =
+        open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_BINARY, 0777);
+    ASSERT_GE(file, 0);
+    {
+      VectoredFileOutputStream output(file, kBlockSizes[i]);
+      WriteStuffLarge(&output);
+      EXPECT_TRUE(output.Flush());
+      EXPECT_EQ(0, output.GetErrno());
+    }
+    ASSERT_NE(lseek(file, 0, SEEK_SET), (off_t)-1);
+    {
+      FileInputStream input(file);
+      ReadStuffLarge(&input);
+    }
+    close(file);
+  }
+}
+
+TEST_F(IoTest, VectoredFileIoAliasesLargeWrites) {
+  std::string filename = TestTempDir() + "/zero_copy_stream_test_file";
+  int file =
+      open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_BINARY, 0777);
+  ASSERT_GE(file, 0);
+
+  std::string large(100000, 'x');
+  std::string small(100, 'y');
+  {
+    VectoredFileOutputStream output(file, 1024, 1000);
+    {
+      CodedOutputStream coded_output(&output);
+      coded_output.EnableAliasing(true);
+      coded_output.WriteString("Hello world!\n");
+      coded_output.WriteRawMaybeAliased(large.data(), large.size());
+      coded_output.WriteRawMaybeAliased(small.data(), small.size());
+      coded_output.WriteString("01234567890123456789");
+    }
+    EXPECT_EQ(output.ByteCount(), 100133);
+
+    // Large writes are referenced until the stream is flushed; small ones
+    // were copied.
+    large[0] = 'z';
+    small[0] = 'z';
+    EXPECT_TRUE(output.Flush());
+  }
+
+  std::string contents;
+  GOOGLE_ABSL_CHECK_OK(File::GetContents(filename, &contents, true));
+  EXPECT_EQ(contents, absl::StrCat("Hello world!\n", "z",
+                                   std::string(99999, 'x'),
+                                   std::string(100, 'y'),
+                                   "01234567890123456789"));
+  close(file);
+}
+
+TEST_F(IoTest, MmapFileIo) {
+  std::string filename = TestTempDir() + "/zero_copy_stream_test_file";
+  // Tiny windows are rounded up to a page, so the file spans many of them.
+  const int64_t kWindowSizes[] = {1, 3 * 4096 + 1,
+                                  MmapInputStream::Options().window_size};
+
+  for (int64_t window_size : kWindowSizes) {
+    int file =
+        open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_BINARY, 0777);
+    ASSERT_GE(file, 0);
+    {
+      FileOutputStream output(file);
+      WriteStuffLarge(&output);
+      EXPECT_EQ(0, output.GetErrno());
+    }
+    ASSERT_NE(lseek(file, 0, SEEK_SET), (off_t)-1);
+
+    {
+      MmapInputStream::Options options;
+      options.window_size = window_size;
+      MmapInputStream input(file, options);
+#ifndef _WIN32
+      EXPECT_TRUE(input.is_mapped());
+#endif
+      ReadStuffLarge(&input);
+      EXPECT_EQ(0, input.GetErrno());
+    }
+    // The file offset was moved past the consumed bytes.
+    EXPECT_EQ(lseek(file, 0, SEEK_CUR), 200055);
+
+    close(file);
+  }
+}
+
+TEST_F(IoTest, MmapFileIoStartsAtFileOffset) {
+  std::string filename = TestTempDir() + "/zero_copy_stream_test_file";
+  int file =
+      open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_BINARY, 0777);
+  ASSERT_GE(file, 0);
+  {
+    FileOutputStream output(file);
+    WriteStuffLarge(&output);
+  }
+  ASSERT_NE(lseek(file, 13, SEEK_SET), (off_t)-1);
+
+  {
+    MmapInputStream::Options options;
+    options.window_size = 4096;
+    MmapInputStream input(file, options);
+    ReadString(&input, "Some text.  Blah blah.");
+    EXPECT_TRUE(input.Skip(200000));
+    ReadString(&input, "01234567890123456789");
+    EXPECT_FALSE(input.Skip(1));
+    EXPECT_EQ(input.ByteCount(), 200055 - 13);
+  }
+  EXPECT_EQ(lseek(file, 0, SEEK_CUR), 200055);
+
+  close(file);
+}
+
+TEST_F(IoTest, MmapFileIoSmallFile) {
+  std::string filename = TestTempDir() + "/zero_copy_stream_test_file";
+  int file =
+      open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_BINARY, 0777);
+  ASSERT_GE(file, 0);
+  {
+    FileOutputStream output(file);
+    WriteStuff(&output);
+  }
+  ASSERT_NE(lseek(file, 0, SEEK_SET), (off_t)-1);
+
+  {
+    // Too small to be worth mapping: read like FileInputStream.
+    MmapInputStream input(file);
+    EXPECT_FALSE(input.is_mapped());
+    ReadStuff(&input);
+    EXPECT_EQ(0, input.GetErrno());
+  }
+
+  close(file);
+}
+
+TEST_F(IoTest, AsyncFileIo) {
+  std::string filename = TestTempDir() + "/zero_copy_stream_test_file";
+  const int kBufferSizes[] = {1000, 4096, 1 << 20};
+  const int kBufferCounts[] = {1, 2, 4};
+
+  for (bool use_io_uring : {true, false}) {
+    for (int buffer_size : kBufferSizes) {
+      for (int buffer_count : kBufferCounts) {
+        AsyncFileStreamOptions options;
+        options.buffer_size = buffer_size;
+        options.buffer_count = buffer_count;
+        options.use_io_uring = use_io_uring;
+
+        int file =
+            open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_BINARY, 0777);
+        ASSERT_GE(file, 0);
+        {
+          AsyncFileOutputStream output(file, options);
+          WriteStuffLarge(&output);
+          EXPECT_TRUE(output.Flush());
+          EXPECT_EQ(0, output.GetErrno());
+        }
+        EXPECT_EQ(lseek(file, 0, SEEK_CUR), 200055);
+
+        ASSERT_NE(lseek(file, 0, SEEK_SET), (off_t)-1);
+        {
+          AsyncFileInputStream input(file, options);
+          ReadStuffLarge(&input);
+          EXPECT_EQ(0, input.GetErrno());
+        }
+        EXPECT_EQ(lseek(file, 0, SEEK_CUR), 200055);
+
+        close(file);
+      }
+    }
+  }
+}
+
+TEST_F(IoTest, AsyncFileIoSmallBuffers) {
+  std::string filename = TestTempDir() + "/zero_copy_stream_test_file";
+
+  for (int i = 1; i < kBlockSizeCount; i++) {
+    AsyncFileStreamOptions options;
+    options.buffer_size = kBlockSizes[i];
+    int file =
+        open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_BINARY, 0777);
+    ASSERT_GE(file, 0);
+    {
+      AsyncFileOutputStream output(file, options);
+      WriteStuff(&output);
+    }
+    ASSERT_NE(lseek(file, 0, SEEK_SET), (off_t)-1);
+    {
+      AsyncFileInputStream input(file, options);
+      ReadStuff(&input);
+      EXPECT_EQ(0, input.GetErrno());
+    }
+    close(file);
+  }
+}
+
+TEST_F(IoTest, AsyncFileIoStopsAtConsumedBytes) {
+  std::string filename = TestTempDir() + "/zero_copy_stream_test_file";
+  int file =
+      open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_BINARY, 0777);
+  ASSERT_GE(file, 0);
+  {
+    FileOutputStream output(file);
+    WriteStuffLarge(&output);
+  }
+  ASSERT_NE(lseek(file, 13, SEEK_SET), (off_t)-1);
+
+  AsyncFileStreamOptions options;
+  options.buffer_size = 4096;
+  {
+    AsyncFileInputStream input(file, options);
+    ReadString(&input, "Some text.  Blah blah.");
+  }
+  // Read-ahead is discarded: the offset only moved past the consumed bytes.
+  EXPECT_EQ(lseek(file, 0, SEEK_CUR), 13 + 22);
+
+  close(file);
+}
+
 #ifndef _WIN32
 // This tests the FileInputStream with a non blocking file. It opens a pipe in
 // non blocking mode, then starts reading it. The writing thread starts writing
@@ -1525,6 +2110,109 @@ TEST_F(IoTest, NonBlockingFileIo) {
   }
 }
 
+TEST_F(IoTest, MmapFileIoPipe) {
+  int fd[2];
+  ASSERT_EQ(pipe(fd), 0);
+  {
+    FileOutputStream output(fd[1]);
+    WriteStuff(&output);
+  }
+  close(fd[1]);
+
+  MmapInputStream::Options options;
+  options.min_mapped_size = 0;
+  MmapInputStream input(fd[0], options);
+  EXPECT_FALSE(input.is_mapped());
+  ReadStuff(&input);
+  EXPECT_EQ(0, input.GetErrno());
+  close(fd[0]);
+}
+
+TEST_F(IoTest, MmapFileIoTruncated) {
+  std::string filename = TestTempDir() + "/zero_copy_stream_test_file";
+  int file =
+      open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_BINARY, 0777);
+  ASSERT_GE(file, 0);
+  const int page_size = static_cast<int>(sysconf(_SC_PAGESIZE));
+  const std::string contents(4 * page_size, 'x');
+  ASSERT_EQ(write(file, contents.data(), contents.size()),
+            static_cast<ssize_t>(contents.size()));
+  ASSERT_NE(lseek(file, 0, SEEK_SET), (off_t)-1);
+
+  {
+    MmapInputStream::Options options;
+    options.window_size = page_size;
+    options.min_mapped_size = 0;
+    MmapInputStream input(file, options);
+    ASSERT_TRUE(input.is_mapped());
+    const void* data;
+    int size;
+    ASSERT_TRUE(input.Next(&data, &size));
+    EXPECT_EQ(size, page_size);
+
+    // The next window ends at the new end of the file.
+    ASSERT_EQ(ftruncate(file, page_size + 100), 0);
+    ASSERT_TRUE(input.Next(&data, &size));
+    EXPECT_EQ(size, 100);
+    EXPECT_EQ(std::string(static_cast<const char*>(data), size),
+              std::string(100, 'x'));
+    EXPECT_FALSE(input.Next(&data, &size));
+    EXPECT_EQ(0, input.GetErrno());
+    EXPECT_EQ(input.ByteCount(), page_size + 100);
+  }
+
+  close(file);
+}
+
+TEST_F(IoTest, AsyncFileIoPipe) {
+  int fd[2];
+  ASSERT_EQ(pipe(fd), 0);
+
+  AsyncFileStreamOptions options;
+  options.buffer_size = 1000;
+  std::thread write_thread([this, fd, &options]() {
+    AsyncFileOutputStream output(fd[1], options);
+    EXPECT_FALSE(output.uses_io_uring());
+    WriteStuffLarge(&output);
+    EXPECT_TRUE(output.Close());
+  });
+
+  AsyncFileInputStream input(fd[0], options);
+  EXPECT_FALSE(input.uses_io_uring());
+  ReadStuffLarge(&input);
+  EXPECT_EQ(0, input.GetErrno());
+  write_thread.join();
+  close(fd[0]);
+}
+
+// The async streams wait for a non-blocking pipe to become ready, and leave
+// it non-blocking.
+TEST_F(IoTest, AsyncFileIoNonBlockingPipe) {
+  int fd[2];
+  ASSERT_EQ(pipe(fd), 0);
+  ASSERT_EQ(fcntl(fd[0], F_SETFL, O_NONBLOCK), 0);
+  ASSERT_EQ(fcntl(fd[1], F_SETFL, O_NONBLOCK), 0);
+
+  AsyncFileStreamOptions options;
+  options.buffer_size = 1000;
+  std::thread write_thread([this, fd, &options]() {
+    // Start late, so that the reader finds the pipe empty.
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    AsyncFileOutputStream output(fd[1], options);
+    WriteStuffLarge(&output);
+    EXPECT_TRUE(output.Close());
+  });
+
+  {
+    AsyncFileInputStream input(fd[0], options);
+    ReadStuffLarge(&input);
+    EXPECT_EQ(0, input.GetErrno());
+  }
+  write_thread.join();
+  EXPECT_NE(fcntl(fd[0], F_GETFL) & O_NONBLOCK, 0);
+  close(fd[0]);
+}
+
 TEST_F(IoTest, BlockingFileIoWithTimeout) {
   int fd[2];
 
@@ -0,0 +1,262 @@
+// Protocol Buffers - Google's data interchange format
+// Copyright 2008 Google Inc.  All rights reserved.
+// https://developers.google.com/protocol-buffers/
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// This file contains the implementation of classes ZstdInputStream and
+// ZstdOutputStream.
+
+#include "google/protobuf/io/zstd_stream.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+#include "google/protobuf/stubs/logging.h"
+#include "google/protobuf/port.h"
+
+// Must be included last.
+#include "google/protobuf/port_def.inc"
+
+namespace google {
+namespace protobuf {
+namespace io {
+
+ZstdInputStream::Options::Options()
+    : buffer_size(static_cast<int>(ZSTD_DStreamOutSize())) {}
+
+ZstdInputStream::ZstdInputStream(ZeroCopyInputStream* sub_stream)
+    : ZstdInputStream(sub_stream, Options()) {}
+
+ZstdInputStream::ZstdInputStream(ZeroCopyInputStream* sub_stream,
+                                 const Options& options)
+    : sub_stream_(sub_stream),
+      dctx_(ZSTD_createDCtx()),
+      error_message_(nullptr),
+      input_{nullptr, 0, 0},
+      frame_remaining_(0),
+      output_full_(false),
+      output_buffer_length_(options.buffer_size > 0 ? options.buffer_size
+                                                    : ZSTD_DStreamOutSize()),
+      byte_count_(0) {
+  GOOGLE_ABSL_CHECK(dctx_ != nullptr);
+  output_buffer_ = static_cast<char*>(operator new(output_buffer_length_));
+  output_position_ = output_end_ = output_buffer_;
+  if (!options.dictionary.empty()) {
+    size_t ret = ZSTD_DCtx_loadDictionary(
+        dctx_, options.dictionary.data(), options.dictionary.size());
+    if (ZSTD_isError(ret)) error_message_ = ZSTD_getErrorName(ret);
+  }
+}
+
+ZstdInputStream::~ZstdInputStream() {
+  // Give back compressed input that was not needed, e.g. data following the
+  // last frame.
+  if (input_.pos < input_.size) {
+    sub_stream_->BackUp(static_cast<int>(input_.size - input_.pos));
+  }
+  internal::SizedDelete(output_buffer_, output_buffer_length_);
+  ZSTD_freeDCtx(dctx_);
+}
+
+// implements ZeroCopyInputStream ----------------------------------
+bool ZstdInputStream::Next(const void** data, int* size) {
+  if (output_position_ == output_end_) {
+    if (error_message_ != nullptr) return false;
+
+    ZSTD_outBuffer output = {output_buffer_, output_buffer_length_, 0};
+    while (output.pos == 0) {
+      if (input_.pos == input_.size && !output_full_) {
+        const void* in;
+        int in_size;
+        if (!sub_stream_->Next(&in, &in_size)) {
+          input_ = {nullptr, 0, 0};
+          if (frame_remaining_ != 0) {
+            error_message_ = "Truncated zstd frame";
+          }
+          return false;
+        }
+        input_ = {in, static_cast<size_t>(in_size), 0};
+      }
+      size_t ret = ZSTD_decompressStream(dctx_, &output, &input_);
+      if (ZSTD_isError(ret)) {
+        error_message_ = ZSTD_getErrorName(ret);
+        return false;
+      }
+      frame_remaining_ = ret;
+      // Zero means the frame is done and all of it was output.
+      output_full_ = ret != 0 && output.pos == output.size;
+    }
+    output_position_ = output_buffer_;
+    output_end_ = output_buffer_ + output.pos;
+  }
+
+  *data = output_position_;
+  *size = static_cast<int>(output_end_ - output_position_);
+  byte_count_ += *size;
+  output_position_ = output_end_;
+  return true;
+}
+
+void ZstdInputStream::BackUp(int count) {
+  GOOGLE_ABSL_CHECK_GE(count, 0);
+  GOOGLE_ABSL_CHECK_LE(count, output_position_ - output_buffer_);
+  output_position_ -= count;
+  byte_count_ -= count;
+}
+
+bool ZstdInputStream::Skip(int count) {
+  const void* data;
+  int size = 0;
+  bool ok = Next(&data, &size);
+  while (ok && (size < count)) {
+    count -= size;
+    ok = Next(&data, &size);
+  }
+  if (size > count) {
+    BackUp(size - count);
+  }
+  return ok;
+}
+
+int64_t ZstdInputStream::ByteCount() const { return byte_count_; }
+
+// =========================================================================
+
+ZstdOutputStream::Options::Options()
+    : buffer_size(static_cast<int>(ZSTD_CStreamInSize())),
+      compression_level(ZSTD_CLEVEL_DEFAULT),
+      checksum(true) {}
+
+ZstdOutputStream::ZstdOutputStream(ZeroCopyOutputStream* sub_stream)
+    : ZstdOutputStream(sub_stream, Options()) {}
+
+ZstdOutputStream::ZstdOutputStream(ZeroCopyOutputStream* sub_stream,
+                                   const Options& options)
+    : sub_stream_(sub_stream),
+      cctx_(ZSTD_createCCtx()),
+      error_message_(nullptr),
+      closed_(false),
+      input_buffer_length_(options.buffer_size > 0 ? options.buffer_size
+                                                   : ZSTD_CStreamInSize()),
+      input_used_(0),
+      total_in_(0) {
+  GOOGLE_ABSL_CHECK(cctx_ != nullptr);
+  input_buffer_ = static_cast<char*>(operator new(input_buffer_length_));
+
+  size_t ret = ZSTD_CCtx_setParameter(cctx_, ZSTD_c_compressionLevel,
+                                      options.compression_level);
+  if (!ZSTD_isError(ret)) {
+    ret = ZSTD_CCtx_setParameter(cctx_, ZSTD_c_checksumFlag,
+                                 options.checksum ? 1 : 0);
+  }
+  if (!ZSTD_isError(ret) && !options.dictionary.empty()) {
+    ret = ZSTD_CCtx_loadDictionary(cctx_, options.dictionary.data(),
+                                   options.dictionary.size());
+  }
+  if (ZSTD_isError(ret)) error_message_ = ZSTD_getErrorName(ret);
+}
+
+ZstdOutputStream::~ZstdOutputStream() {
+  if (!closed_) Close();
+  internal::SizedDelete(input_buffer_, input_buffer_length_);
+  ZSTD_freeCCtx(cctx_);
+}
+
+// private
+bool ZstdOutputStream::Compress(ZSTD_EndDirective directive) {
+  if (error_message_ != nullptr) return false;
+
+  ZSTD_inBuffer input = {input_buffer_, input_used_, 0};
+  ZSTD_outBuffer output = {nullptr, 0, 0};
+  bool done = false;
+  while (!done) {
+    if (output.pos == output.size) {
+      void* out;
+      int out_size;
+      if (!sub_stream_->Next(&out, &out_size)) {
+        error_message_ = "Error writing to underlying stream";
+        return false;
+      }
+      output = {out, static_cast<size_t>(out_size), 0};
+    }
+    size_t remaining = ZSTD_compressStream2(cctx_, &output, &input, directive);
+    if (ZSTD_isError(remaining)) {
+      error_message_ = ZSTD_getErrorName(remaining);
+      break;
+    }
+    // With ZSTD_e_continue zstd only has to take all of the input; flushes
+    // are complete once nothing remains buffered.
+    done = directive == ZSTD_e_continue ? input.pos == input.size
+                                        : remaining == 0;
+  }
+  if (output.dst != nullptr) {
+    sub_stream_->BackUp(static_cast<int>(output.size - output.pos));
+  }
+
+  total_in_ += input_used_;
+  input_used_ = 0;
+  return error_message_ == nullptr;
+}
+
+// implements ZeroCopyOutputStream ---------------------------------
+bool ZstdOutputStream::Next(void** data, int* size) {
+  if (closed_ || error_message_ != nullptr) return false;
+  if (input_used_ == input_buffer_length_ && !Compress(ZSTD_e_continue)) {
+    return false;
+  }
+  *data = input_buffer_ + input_used_;
+  *size = static_cast<int>(input_buffer_length_ - input_used_);
+  input_used_ = input_buffer_length_;
+  return true;
+}
+
+void ZstdOutputStream::BackUp(int count) {
+  GOOGLE_ABSL_CHECK_GE(count, 0);
+  GOOGLE_ABSL_CHECK_LE(static_cast<size_t>(count), input_used_);
+  input_used_ -= count;
+}
+
+int64_t ZstdOutputStream::ByteCount() const { return total_in_ + input_used_; }
+
+bool ZstdOutputStream::Flush() {
+  if (closed_) return false;
+  return Compress(ZSTD_e_flush);
+}
+
+bool ZstdOutputStream::Close() {
+  if (closed_) return false;
+  closed_ = true;
+  return Compress(ZSTD_e_end);
+}
+
+}  // namespace io
+}  // namespace protobuf
+}  // namespace google
+
+#include "google/protobuf/port_undef.inc"
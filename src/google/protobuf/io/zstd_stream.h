@@ -0,0 +1,193 @@
+// Protocol Buffers - Google's data interchange format
+// Copyright 2008 Google Inc.  All rights reserved.
+// https://developers.google.com/protocol-buffers/
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// This file contains the definition for classes ZstdInputStream and
+// ZstdOutputStream.
+//
+// ZstdInputStream decompresses Zstandard frames from an underlying
+// ZeroCopyInputStream and provides the decompressed data as a
+// ZeroCopyInputStream.
+//
+// ZstdOutputStream is a ZeroCopyOutputStream that compresses data to an
+// underlying ZeroCopyOutputStream.
+//
+// Zstandard compresses several times faster than zlib at a similar ratio and
+// decompresses faster still.  Both streams accept a dictionary (e.g. one
+// trained with `zstd --train` on sample messages), which makes small,
+// similar payloads such as single serialized messages compress well.
+
+#ifndef GOOGLE_PROTOBUF_IO_ZSTD_STREAM_H__
+#define GOOGLE_PROTOBUF_IO_ZSTD_STREAM_H__
+
+#include <cstddef>
+#include <cstdint>
+
+#include "google/protobuf/io/zero_copy_stream.h"
+#include "absl/strings/string_view.h"
+#include "zstd.h"
+
+// Must be included last.
+#include "google/protobuf/port_def.inc"
+
+namespace google {
+namespace protobuf {
+namespace io {
+
+// A ZeroCopyInputStream that reads compressed data through zstd.
+//
+// Concatenated frames are decompressed as one stream.
+class PROTOBUF_EXPORT ZstdInputStream PROTOBUF_FUTURE_FINAL
+    : public ZeroCopyInputStream {
+ public:
+  struct PROTOBUF_EXPORT Options {
+    // Size of the buffers decompressed data is returned in.  Defaults to
+    // ZSTD_DStreamOutSize(), which fits a whole zstd block.
+    int buffer_size;
+
+    // Dictionary the data was compressed with, or empty for none.
+    absl::string_view dictionary;
+
+    Options();  // Initializes with default values.
+  };
+
+  explicit ZstdInputStream(ZeroCopyInputStream* sub_stream);
+  ZstdInputStream(ZeroCopyInputStream* sub_stream, const Options& options);
+  ZstdInputStream(const ZstdInputStream&) = delete;
+  ZstdInputStream& operator=(const ZstdInputStream&) = delete;
+  ~ZstdInputStream() override;
+
+  // Return last error message or NULL if no error.
+  inline const char* ZstdErrorMessage() const { return error_message_; }
+
+  // implements ZeroCopyInputStream ----------------------------------
+  bool Next(const void** data, int* size) override;
+  void BackUp(int count) override;
+  bool Skip(int count) override;
+  int64_t ByteCount() const override;
+
+ private:
+  ZeroCopyInputStream* sub_stream_;
+  ZSTD_DCtx* dctx_;
+  const char* error_message_;
+
+  // Compressed input not yet consumed, from sub_stream_->Next().
+  ZSTD_inBuffer input_;
+  // Hint returned by the last ZSTD_decompressStream() call; zero at the end
+  // of a frame.
+  size_t frame_remaining_;
+  // Set if the last call filled the output buffer, in which case zstd may
+  // have more output without needing more input.
+  bool output_full_;
+
+  char* output_buffer_;
+  size_t output_buffer_length_;
+  // Decompressed bytes in output_buffer_ not yet returned by Next().
+  char* output_position_;
+  char* output_end_;
+  int64_t byte_count_;
+};
+
+class PROTOBUF_EXPORT ZstdOutputStream PROTOBUF_FUTURE_FINAL
+    : public ZeroCopyOutputStream {
+ public:
+  struct PROTOBUF_EXPORT Options {
+    // What size buffer to use internally.  Defaults to ZSTD_CStreamInSize(),
+    // which fits a whole zstd block.
+    int buffer_size;
+
+    // A number between ZSTD_minCLevel() and ZSTD_maxCLevel(), where higher is
+    // slower with better compression.  Defaults to ZSTD_CLEVEL_DEFAULT.
+    int compression_level;
+
+    // Dictionary to compress with, or empty for none.  The reader must use
+    // the same one.
+    absl::string_view dictionary;
+
+    // Whether to append a checksum of the uncompressed data to each frame.
+    // Defaults to true.
+    bool checksum;
+
+    Options();  // Initializes with default values.
+  };
+
+  // Create a ZstdOutputStream with default options.
+  explicit ZstdOutputStream(ZeroCopyOutputStream* sub_stream);
+
+  // Create a ZstdOutputStream with the given options.
+  ZstdOutputStream(ZeroCopyOutputStream* sub_stream, const Options& options);
+  ZstdOutputStream(const ZstdOutputStream&) = delete;
+  ZstdOutputStream& operator=(const ZstdOutputStream&) = delete;
+
+  ~ZstdOutputStream() override;
+
+  // Return last error message or NULL if no error.
+  inline const char* ZstdErrorMessage() const { return error_message_; }
+
+  // Flushes data written so far to compressed data in the underlying stream,
+  // so that a reader can decompress all of it.  It is the caller's
+  // responsibility to flush the underlying stream if necessary.
+  // Returns true if no error.
+  bool Flush();
+
+  // Writes out all data and ends the zstd frame.
+  // It is the caller's responsibility to close the underlying stream if
+  // necessary.
+  // Returns true if no error.
+  bool Close();
+
+  // implements ZeroCopyOutputStream ---------------------------------
+  bool Next(void** data, int* size) override;
+  void BackUp(int count) override;
+  int64_t ByteCount() const override;
+
+ private:
+  ZeroCopyOutputStream* sub_stream_;
+  ZSTD_CCtx* cctx_;
+  const char* error_message_;
+  bool closed_;
+
+  char* input_buffer_;
+  size_t input_buffer_length_;
+  size_t input_used_;
+  int64_t total_in_;
+
+  // Compresses input_buffer_ into sub_stream_.
+  // Takes a zstd end directive.
+  // Returns false on error.
+  bool Compress(ZSTD_EndDirective directive);
+};
+
+}  // namespace io
+}  // namespace protobuf
+}  // namespace google
+
+#include "google/protobuf/port_undef.inc"
+
+#endif  // GOOGLE_PROTOBUF_IO_ZSTD_STREAM_H__
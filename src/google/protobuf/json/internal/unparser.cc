@@ -337,30 +337,26 @@ absl::Status WriteMap(JsonWriter& writer, const Msg<Traits>& msg,
   writer.Write("{");
   writer.Push();
 
-  size_t count = Traits::GetSize(field, msg);
   bool first = true;
-  for (size_t i = 0; i < count; ++i) {
-    absl::StatusOr<const Msg<Traits>*> entry =
-        Traits::GetMessage(field, msg, i);
-    RETURN_IF_ERROR(entry.status());
-    const Desc<Traits>& type = Traits::GetDesc(**entry);
-
-    auto is_empty = IsEmptyValue<Traits>(**entry, Traits::ValueField(type));
-    RETURN_IF_ERROR(is_empty.status());
-    if (*is_empty) {
-      // Empty google.protobuf.Values are silently discarded.
-      continue;
-    }
+  RETURN_IF_ERROR(Traits::WithMapEntries(
+      field, msg, [&](const Msg<Traits>& entry) -> absl::Status {
+        const Desc<Traits>& type = Traits::GetDesc(entry);
+
+        auto is_empty = IsEmptyValue<Traits>(entry, Traits::ValueField(type));
+        RETURN_IF_ERROR(is_empty.status());
+        if (*is_empty) {
+          // Empty google.protobuf.Values are silently discarded.
+          return absl::OkStatus();
+        }
 
-    writer.WriteComma(first);
-    writer.NewLine();
-    RETURN_IF_ERROR(
-        WriteMapKey<Traits>(writer, **entry, Traits::KeyField(type)));
-    writer.Write(":");
-    writer.Whitespace(" ");
-    RETURN_IF_ERROR(
-        WriteSingular<Traits>(writer, Traits::ValueField(type), **entry));
-  }
+        writer.WriteComma(first);
+        writer.NewLine();
+        RETURN_IF_ERROR(
+            WriteMapKey<Traits>(writer, entry, Traits::KeyField(type)));
+        writer.Write(":");
+        writer.Whitespace(" ");
+        return WriteSingular<Traits>(writer, Traits::ValueField(type), entry);
+      }));
 
   writer.Pop();
   if (!first) {
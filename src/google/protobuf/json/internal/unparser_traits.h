@@ -44,6 +44,7 @@
 #include "google/protobuf/type.pb.h"
 #include "google/protobuf/descriptor.h"
 #include "google/protobuf/dynamic_message.h"
+#include "google/protobuf/map_field.h"
 #include "google/protobuf/message.h"
 #include "absl/container/flat_hash_map.h"
 #include "absl/status/status.h"
@@ -237,6 +238,30 @@ struct UnparseProto2Descriptor : Proto2Descriptor {
     return &msg.GetReflection()->GetRepeatedMessage(msg, f, idx);
   }
 
+  // Calls `body` with each entry of the map field `f`, which it must not keep.
+  // Unless the repeated field representation of the map is up to date, the
+  // entries are read from the map itself through a single entry message, so
+  // that writing a map does not build that representation.
+  template <typename F>
+  static absl::Status WithMapEntries(Field f, const Msg& msg, F body) {
+    const Reflection* reflection = msg.GetReflection();
+    if (reflection->GetMapData(msg, f)->IsRepeatedFieldValid()) {
+      int count = reflection->FieldSize(msg, f);
+      for (int i = 0; i < count; ++i) {
+        RETURN_IF_ERROR(body(reflection->GetRepeatedMessage(msg, f, i)));
+      }
+      return absl::OkStatus();
+    }
+    Msg* mutable_msg = const_cast<Msg*>(&msg);
+    internal::MapEntryView entry(msg, f);
+    for (MapIterator it = reflection->MapBegin(mutable_msg, f),
+                     end = reflection->MapEnd(mutable_msg, f);
+         it != end; ++it) {
+      RETURN_IF_ERROR(body(entry.Set(it.GetKey(), it.GetValueRef())));
+    }
+    return absl::OkStatus();
+  }
+
   template <typename F>
   static absl::Status WithDecodedMessage(const Desc& desc,
                                          absl::string_view data, F body) {
@@ -421,6 +446,18 @@ struct UnparseProto3Type : Proto3Type {
     return &msg.Get<Msg>(f->proto().number())[idx];
   }
 
+  // Calls `body` with each entry of the map field `f`.
+  template <typename F>
+  static absl::Status WithMapEntries(Field f, const Msg& msg, F body) {
+    size_t count = GetSize(f, msg);
+    for (size_t i = 0; i < count; ++i) {
+      absl::StatusOr<const Msg*> entry = GetMessage(f, msg, i);
+      RETURN_IF_ERROR(entry.status());
+      RETURN_IF_ERROR(body(**entry));
+    }
+    return absl::OkStatus();
+  }
+
   template <typename F>
   static absl::Status WithDecodedMessage(const Desc& desc,
                                          absl::string_view data, F body) {
@@ -71,6 +71,7 @@ using ::proto3::TestAny;
 using ::proto3::TestEnumValue;
 using ::proto3::TestMap;
 using ::proto3::TestMessage;
+using ::proto3::TestNestedMap;
 using ::proto3::TestOneof;
 using ::proto3::TestWrapper;
 using ::testing::ElementsAre;
@@ -542,6 +543,25 @@ TEST_P(JsonTest, ParseMap) {
   EXPECT_EQ(other->DebugString(), message.DebugString());
 }
 
+TEST_P(JsonTest, PrintMapWithoutRepeatedField) {
+  TestNestedMap message;
+  for (int i = 0; i < 10; ++i) {
+    (*message.mutable_int32_map())[i] = i;
+    TestNestedMap& value = (*message.mutable_map_map())[absl::StrCat("k", i)];
+    (*value.mutable_string_map())["inner"] = i;
+  }
+  // The maps are printed from the maps themselves, without building their
+  // repeated field representation.
+  size_t space_used = message.SpaceUsedLong();
+  auto printed = ToJson(message);
+  ASSERT_OK(printed);
+  EXPECT_EQ(message.SpaceUsedLong(), space_used);
+
+  auto other = ToProto<TestNestedMap>(*printed);
+  ASSERT_OK(other);
+  EXPECT_EQ(other->DebugString(), message.DebugString());
+}
+
 TEST_P(JsonTest, RepeatedMapKey) {
   EXPECT_THAT(ToProto<TestMap>(R"json({
     "string_map": {
@@ -0,0 +1,233 @@
+// Protocol Buffers - Google's data interchange format
+// Copyright 2008 Google Inc.  All rights reserved.
+// https://developers.google.com/protocol-buffers/
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "google/protobuf/lazy_field.h"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+#include "google/protobuf/stubs/logging.h"
+#include "google/protobuf/wire_format_lite.h"
+
+// Must be included last.
+#include "google/protobuf/port_def.inc"
+
+namespace google {
+namespace protobuf {
+namespace internal {
+namespace {
+
+// Merges the serialized message `data` into `message`, with `depth` levels of
+// nesting allowed below it.
+bool MergeBytes(absl::string_view data, int depth, MessageLite* message) {
+  const char* ptr;
+  ParseContext ctx(depth, false, &ptr, data);
+  ptr = message->_InternalParse(ptr, &ctx);
+  return ptr != nullptr && ctx.EndedAtLimit();
+}
+
+}  // namespace
+
+const MessageLite& LazyField::GetMessage(const MessageLite& prototype,
+                                         Arena* arena) const {
+  MessageLite* message = message_.load(std::memory_order_acquire);
+  if (message != nullptr) return *message;
+  if (unparsed_.empty()) return prototype;
+  return *Materialize(prototype, arena);
+}
+
+MessageLite* LazyField::MutableMessage(const MessageLite& prototype,
+                                       Arena* arena) {
+  MessageLite* message = message_.load(std::memory_order_acquire);
+  if (message == nullptr) {
+    if (unparsed_.empty()) {
+      message = prototype.New(arena);
+      message_.store(message, std::memory_order_release);
+    } else {
+      message = Materialize(prototype, arena);
+    }
+  }
+  if (!dirty_) {
+    dirty_ = true;
+    unparsed_ = absl::string_view();
+    if (owned_ != nullptr) owned_->clear();
+  }
+  return message;
+}
+
+MessageLite* LazyField::Materialize(const MessageLite& prototype,
+                                    Arena* arena) const {
+  MessageLite* parsed = prototype.New(arena);
+  if (!MergeBytes(unparsed_, depth_, parsed)) parsed->Clear();
+  MessageLite* expected = nullptr;
+  if (!message_.compare_exchange_strong(expected, parsed,
+                                        std::memory_order_acq_rel)) {
+    // Another thread won the race. On an arena our copy stays allocated until
+    // the arena is destroyed.
+    if (arena == nullptr) delete parsed;
+    return expected;
+  }
+  return parsed;
+}
+
+void LazyField::Clear() {
+  unparsed_ = absl::string_view();
+  if (owned_ != nullptr) owned_->clear();
+  dirty_ = false;
+  MessageLite* message = message_.load(std::memory_order_relaxed);
+  if (message != nullptr) message->Clear();
+}
+
+MessageLite* LazyField::UnsafeArenaRelease(const MessageLite& prototype,
+                                           Arena* arena) {
+  if (IsEmpty() && !IsMaterialized()) return nullptr;
+  MessageLite* message = MutableMessage(prototype, arena);
+  message_.store(nullptr, std::memory_order_relaxed);
+  dirty_ = false;
+  return message;
+}
+
+void LazyField::UnsafeArenaSetAllocated(MessageLite* message, Arena* arena) {
+  unparsed_ = absl::string_view();
+  if (owned_ != nullptr) owned_->clear();
+  if (arena == nullptr) delete message_.load(std::memory_order_relaxed);
+  message_.store(message, std::memory_order_relaxed);
+  dirty_ = message != nullptr;
+}
+
+std::string* LazyField::MutableOwnedBytes(Arena* arena) {
+  if (owned_ == nullptr) owned_ = Arena::Create<std::string>(arena);
+  if (unparsed_.data() != owned_->data()) {
+    owned_->assign(unparsed_.data(), unparsed_.size());
+  }
+  return owned_;
+}
+
+void LazyField::MergeFrom(const MessageLite& prototype, const LazyField& other,
+                          Arena* arena) {
+  GOOGLE_ABSL_DCHECK_NE(&other, this);
+  if (other.IsEmpty()) return;
+  if (!other.dirty_ && !IsMaterialized()) {
+    depth_ = unparsed_.empty() ? other.depth_ : std::min(depth_, other.depth_);
+    std::string* bytes = MutableOwnedBytes(arena);
+    bytes->append(other.unparsed_.data(), other.unparsed_.size());
+    unparsed_ = *bytes;
+    return;
+  }
+  MessageLite* message = MutableMessage(prototype, arena);
+  if (other.dirty_) {
+    message->CheckTypeAndMergeFrom(
+        *other.message_.load(std::memory_order_acquire));
+  } else {
+    MergeBytes(other.unparsed_, other.depth_, message);
+  }
+}
+
+size_t LazyField::ByteSizeLong() const {
+  if (dirty_) return message_.load(std::memory_order_relaxed)->ByteSizeLong();
+  return unparsed_.size();
+}
+
+uint8_t* LazyField::InternalWrite(int field_number, uint8_t* target,
+                                  io::EpsCopyOutputStream* stream) const {
+  if (dirty_) {
+    const MessageLite* message = message_.load(std::memory_order_relaxed);
+    return WireFormatLite::InternalWriteMessage(
+        field_number, *message, message->GetCachedSize(), target, stream);
+  }
+  target = stream->EnsureSpace(target);
+  target = WireFormatLite::WriteTagToArray(
+      field_number, WireFormatLite::WIRETYPE_LENGTH_DELIMITED, target);
+  target = io::CodedOutputStream::WriteVarint32ToArray(
+      static_cast<uint32_t>(unparsed_.size()), target);
+  return stream->WriteRawMaybeAliased(
+      unparsed_.data(), static_cast<int>(unparsed_.size()), target);
+}
+
+const char* LazyField::_InternalParse(const MessageLite& prototype,
+                                      Arena* arena, const char* ptr,
+                                      ParseContext* ctx) {
+  if (IsMaterialized()) {
+    return ctx->ParseMessage(MutableMessage(prototype, arena), ptr);
+  }
+  int size = ReadSize(&ptr);
+  if (ptr == nullptr) return nullptr;
+  // The message gets the recursion budget it would have had if it had been
+  // parsed eagerly, so parsing it later fails exactly when that would have.
+  const int depth = ctx->depth() - 1;
+  if (depth < 0) return nullptr;
+  if (size == 0) {
+    // Nothing to defer, but the field must still read as present.
+    if (IsEmpty()) MutableMessage(prototype, arena);
+    return ptr;
+  }
+  if (unparsed_.empty()) {
+    const char* data = ctx->AliasedData(ptr, size);
+    if (data != nullptr) {
+      if (size > ctx->BytesUntilLimit(ptr)) return nullptr;
+      unparsed_ = absl::string_view(data, size);
+      depth_ = depth;
+      return ptr + size;
+    }
+  }
+  // The field occurs more than once or the input can't be aliased.
+  depth_ = unparsed_.empty() ? depth : std::min(depth_, depth);
+  std::string* bytes = MutableOwnedBytes(arena);
+  ptr = ctx->AppendString(ptr, size, bytes);
+  unparsed_ = *bytes;
+  return ptr;
+}
+
+void LazyField::InternalSwap(LazyField* other) {
+  std::swap(unparsed_, other->unparsed_);
+  std::swap(owned_, other->owned_);
+  std::swap(dirty_, other->dirty_);
+  std::swap(depth_, other->depth_);
+  MessageLite* message = message_.load(std::memory_order_relaxed);
+  message_.store(other->message_.load(std::memory_order_relaxed),
+                 std::memory_order_relaxed);
+  other->message_.store(message, std::memory_order_relaxed);
+}
+
+size_t LazyField::SpaceUsedExcludingSelfLong() const {
+  return owned_ == nullptr ? 0 : sizeof(std::string) + owned_->capacity();
+}
+
+void LazyField::Destroy() {
+  delete owned_;
+  delete message_.load(std::memory_order_relaxed);
+}
+
+}  // namespace internal
+}  // namespace protobuf
+}  // namespace google
+
+#include "google/protobuf/port_undef.inc"
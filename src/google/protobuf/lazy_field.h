@@ -0,0 +1,185 @@
+// Protocol Buffers - Google's data interchange format
+// Copyright 2008 Google Inc.  All rights reserved.
+// https://developers.google.com/protocol-buffers/
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef GOOGLE_PROTOBUF_LAZY_FIELD_H__
+#define GOOGLE_PROTOBUF_LAZY_FIELD_H__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "google/protobuf/arena.h"
+#include "google/protobuf/io/coded_stream.h"
+#include "google/protobuf/message_lite.h"
+#include "google/protobuf/parse_context.h"
+
+#ifdef SWIG
+#error "You cannot SWIG proto headers"
+#endif
+
+// Must be included last.
+#include "google/protobuf/port_def.inc"
+
+// This file is logically internal-only and should only be used by protobuf
+// generated code.
+
+namespace google {
+namespace protobuf {
+namespace internal {
+
+// LazyField holds a singular message field whose parsing is deferred until the
+// message is first accessed. Parsing only records the field's serialized
+// bytes: they point straight into the input when the parse allows aliasing
+// and are copied otherwise. The message is materialized on the first call to
+// GetMessage() or MutableMessage(). Until MutableMessage() is called the
+// recorded bytes remain authoritative and are serialized unchanged, so a
+// message that only forwards the field never parses or re-encodes it.
+//
+// Generated code and reflection use it for singular message fields annotated
+// with [lazy = true] or [unverified_lazy = true] that are not in a oneof, and
+// mark such fields in the low bit of their offset in the reflection schema.
+// Required fields of [lazy = true] fields are checked by parsing them on
+// IsInitialized(); those of [unverified_lazy = true] fields are not.
+//
+// Payloads are not verified when they are recorded. A payload that fails to
+// parse on first access reads as an empty message, but is still serialized
+// as-is until the field is mutated. The recursion budget left when the bytes
+// were recorded applies to that later parse, so a message nested too deeply
+// fails there rather than in the enclosing parse.
+//
+// As with ArenaStringPtr, the owning message passes its arena to the methods
+// that may allocate, and must call Destroy() when it is not on an arena.
+//
+// GetMessage() may be called concurrently from several threads, like any
+// other const accessor. Once a message has been materialized, later parses of
+// the same field are merged into it directly.
+class PROTOBUF_EXPORT LazyField {
+ public:
+  constexpr LazyField() {}
+  LazyField(const LazyField&) = delete;
+  LazyField& operator=(const LazyField&) = delete;
+
+  // Returns the message, parsing it from the recorded bytes if needed. If the
+  // field holds nothing, returns `prototype`.
+  const MessageLite& GetMessage(const MessageLite& prototype,
+                                Arena* arena) const;
+
+  // Returns the message for modification. From then on the message, not the
+  // recorded bytes, is serialized.
+  MessageLite* MutableMessage(const MessageLite& prototype, Arena* arena);
+
+  // Returns true if the field holds neither bytes nor a message.
+  bool IsEmpty() const { return !dirty_ && unparsed_.empty(); }
+
+  // Returns true if the message has been parsed or created.
+  bool IsMaterialized() const {
+    return message_.load(std::memory_order_acquire) != nullptr;
+  }
+
+  // Clears the field. A materialized message is kept for reuse.
+  void Clear();
+
+  // Removes the message from the field and returns it, parsing it from the
+  // recorded bytes if needed. The message is on `arena`, like the field.
+  // Returns nullptr if the field holds neither bytes nor a message.
+  MessageLite* UnsafeArenaRelease(const MessageLite& prototype, Arena* arena);
+
+  // Makes `message`, which must be on `arena` or null, the field's message and
+  // drops whatever the field held before.
+  void UnsafeArenaSetAllocated(MessageLite* message, Arena* arena);
+
+  // Merges `other` into this field. If neither side has materialized its
+  // message the bytes are concatenated, which is equivalent to merging.
+  void MergeFrom(const MessageLite& prototype, const LazyField& other,
+                 Arena* arena);
+
+  // Parses the field's bytes into the message (if not done already) and
+  // checks its required fields.
+  bool IsInitialized(const MessageLite& prototype, Arena* arena) const {
+    return GetMessage(prototype, arena).IsInitialized();
+  }
+
+  // Size of the serialized message, without tag and length. Like
+  // MessageLite::ByteSizeLong(), this updates the cached size that
+  // InternalWrite() relies on.
+  size_t ByteSizeLong() const;
+
+  // Writes the field as a length-delimited field with the given number.
+  // ByteSizeLong() must have been called since the last modification.
+  uint8_t* InternalWrite(int field_number, uint8_t* target,
+                         io::EpsCopyOutputStream* stream) const;
+
+  // Parses a length-delimited payload at `ptr`, i.e. what follows the tag.
+  const char* _InternalParse(const MessageLite& prototype, Arena* arena,
+                             const char* ptr, ParseContext* ctx);
+
+  // Swaps with `other`, which must be on the same arena.
+  void InternalSwap(LazyField* other);
+
+  // Heap space used by the recorded bytes when they are not aliased. The
+  // message, if materialized, is not included.
+  size_t SpaceUsedExcludingSelfLong() const;
+
+  // Frees the heap-allocated state. Must only be called when the owner is not
+  // on an arena.
+  void Destroy();
+
+ private:
+  // Parses the recorded bytes and installs the result unless another thread
+  // got there first. Returns the installed message.
+  MessageLite* Materialize(const MessageLite& prototype, Arena* arena) const;
+
+  // Moves the recorded bytes into `owned_`, so that more can be appended,
+  // and returns it. `unparsed_` must be reset from it afterwards.
+  std::string* MutableOwnedBytes(Arena* arena);
+
+  // The recorded serialized message. Points into the parsed input, into
+  // `owned_`, or nowhere.
+  absl::string_view unparsed_;
+  std::string* owned_ = nullptr;
+  // Set once the message has been parsed or created. Only GetMessage() may
+  // set it from a const context, so it is installed with a compare-exchange.
+  mutable std::atomic<MessageLite*> message_{nullptr};
+  // Set once the message may differ from `unparsed_`. When set, `unparsed_` is
+  // empty and `message_` is not null.
+  bool dirty_ = false;
+  // Nesting allowed below the message when parsing `unparsed_`.
+  int depth_ = 0;
+};
+
+}  // namespace internal
+}  // namespace protobuf
+}  // namespace google
+
+#include "google/protobuf/port_undef.inc"
+
+#endif  // GOOGLE_PROTOBUF_LAZY_FIELD_H__
@@ -0,0 +1,463 @@
+// Protocol Buffers - Google's data interchange format
+// Copyright 2008 Google Inc.  All rights reserved.
+// https://developers.google.com/protocol-buffers/
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "google/protobuf/lazy_field.h"
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "absl/strings/string_view.h"
+#include "google/protobuf/arena.h"
+#include "google/protobuf/io/coded_stream.h"
+#include "google/protobuf/io/zero_copy_stream_impl_lite.h"
+#include "google/protobuf/parse_context.h"
+#include "google/protobuf/test_util.h"
+#include "google/protobuf/unittest.pb.h"
+#include "google/protobuf/wire_format_lite.h"
+
+namespace google {
+namespace protobuf {
+namespace internal {
+namespace {
+
+using ::protobuf_unittest::TestAllTypes;
+
+constexpr int kFieldNumber = 1;
+
+// Returns `payload` encoded as field kFieldNumber.
+std::string Field(absl::string_view payload) {
+  std::string out;
+  {
+    io::StringOutputStream output(&out);
+    io::CodedOutputStream coded(&output);
+    WireFormatLite::WriteBytes(kFieldNumber, std::string(payload), &coded);
+  }
+  return out;
+}
+
+// Parses `data`, a sequence of kFieldNumber fields, into `field`. With
+// `aliasing`, `data` must outlive `field`.
+bool Parse(absl::string_view data, bool aliasing, LazyField* field,
+           Arena* arena = nullptr) {
+  const char* ptr;
+  ParseContext ctx(io::CodedInputStream::GetDefaultRecursionLimit(), aliasing,
+                   &ptr, data);
+  while (!ctx.Done(&ptr)) {
+    uint32_t tag;
+    ptr = ReadTag(ptr, &tag);
+    if (ptr == nullptr ||
+        tag != WireFormatLite::MakeTag(
+                   kFieldNumber, WireFormatLite::WIRETYPE_LENGTH_DELIMITED)) {
+      return false;
+    }
+    ptr = field->_InternalParse(TestAllTypes::default_instance(), arena, ptr,
+                                &ctx);
+    if (ptr == nullptr) return false;
+  }
+  return ptr != nullptr && ctx.EndedAtLimit();
+}
+
+std::string Serialize(const LazyField& field) {
+  field.ByteSizeLong();
+  std::string out;
+  {
+    io::StringOutputStream output(&out);
+    io::CodedOutputStream coded(&output);
+    coded.SetCur(field.InternalWrite(kFieldNumber, coded.Cur(),
+                                     coded.EpsCopy()));
+  }
+  return out;
+}
+
+// A payload whose canonical re-encoding differs from it: the field is set
+// twice.
+std::string NonCanonicalPayload() {
+  TestAllTypes first, second;
+  first.set_optional_int32(1);
+  second.set_optional_int32(2);
+  return first.SerializeAsString() + second.SerializeAsString();
+}
+
+TEST(LazyFieldTest, ParsesOnFirstAccess) {
+  TestAllTypes expected;
+  TestUtil::SetAllFields(&expected);
+  const std::string data = Field(expected.SerializeAsString());
+
+  for (bool aliasing : {false, true}) {
+    LazyField field;
+    ASSERT_TRUE(Parse(data, aliasing, &field));
+    EXPECT_FALSE(field.IsEmpty());
+    EXPECT_FALSE(field.IsMaterialized());
+    const auto& message = static_cast<const TestAllTypes&>(
+        field.GetMessage(TestAllTypes::default_instance(), nullptr));
+    EXPECT_TRUE(field.IsMaterialized());
+    TestUtil::ExpectAllFieldsSet(message);
+    EXPECT_EQ(&message,
+              &field.GetMessage(TestAllTypes::default_instance(), nullptr));
+    field.Destroy();
+  }
+}
+
+TEST(LazyFieldTest, EmptyFieldReturnsPrototype) {
+  LazyField field;
+  EXPECT_TRUE(field.IsEmpty());
+  EXPECT_EQ(&field.GetMessage(TestAllTypes::default_instance(), nullptr),
+            &TestAllTypes::default_instance());
+  EXPECT_FALSE(field.IsMaterialized());
+  EXPECT_EQ(field.ByteSizeLong(), 0);
+}
+
+TEST(LazyFieldTest, SerializesUntouchedBytes) {
+  const std::string data = Field(NonCanonicalPayload());
+  LazyField field;
+  ASSERT_TRUE(Parse(data, /*aliasing=*/true, &field));
+  EXPECT_EQ(Serialize(field), data);
+
+  // Reading the message does not change what is written.
+  EXPECT_EQ(static_cast<const TestAllTypes&>(
+                field.GetMessage(TestAllTypes::default_instance(), nullptr))
+                .optional_int32(),
+            2);
+  EXPECT_EQ(Serialize(field), data);
+  field.Destroy();
+}
+
+TEST(LazyFieldTest, SerializesMutatedMessage) {
+  LazyField field;
+  ASSERT_TRUE(Parse(Field(NonCanonicalPayload()), /*aliasing=*/false, &field));
+  auto* message = static_cast<TestAllTypes*>(
+      field.MutableMessage(TestAllTypes::default_instance(), nullptr));
+  EXPECT_EQ(message->optional_int32(), 2);
+  message->set_optional_string("hello");
+  EXPECT_EQ(Serialize(field), Field(message->SerializeAsString()));
+  field.Destroy();
+}
+
+TEST(LazyFieldTest, AliasesInput) {
+  TestAllTypes payload;
+  payload.set_optional_string(std::string(100, 'a'));
+  std::string data = Field(payload.SerializeAsString());
+
+  LazyField aliased, copied;
+  ASSERT_TRUE(Parse(data, /*aliasing=*/true, &aliased));
+  ASSERT_TRUE(Parse(data, /*aliasing=*/false, &copied));
+  const std::string original = data;
+  data[data.size() - 1] = 'b';
+  EXPECT_EQ(Serialize(aliased), data);
+  EXPECT_EQ(Serialize(copied), original);
+  aliased.Destroy();
+  copied.Destroy();
+}
+
+TEST(LazyFieldTest, ParsesRepeatedOccurrencesFromChunkedInput) {
+  TestAllTypes payload;
+  TestUtil::SetAllFields(&payload);
+  const std::string bytes = payload.SerializeAsString();
+  std::string data, concatenated;
+  for (int i = 0; i < 20; ++i) {
+    data += Field(bytes);
+    concatenated += bytes;
+  }
+  TestAllTypes merged;
+  ASSERT_TRUE(merged.ParseFromString(concatenated));
+
+  // Fields crossing a chunk boundary are copied, the others may be aliased.
+  // Either way all occurrences are concatenated, which merges them.
+  for (int block_size : {1, 7, 64, 1000, 1 << 16}) {
+    SCOPED_TRACE(block_size);
+    io::ArrayInputStream input(data.data(), static_cast<int>(data.size()),
+                               block_size);
+    const char* ptr;
+    ParseContext ctx(io::CodedInputStream::GetDefaultRecursionLimit(),
+                     /*aliasing=*/true, &ptr, &input);
+    LazyField field;
+    while (!ctx.Done(&ptr)) {
+      uint32_t tag;
+      ptr = ReadTag(ptr, &tag);
+      ASSERT_NE(ptr, nullptr);
+      ptr = field._InternalParse(TestAllTypes::default_instance(), nullptr,
+                                 ptr, &ctx);
+      ASSERT_NE(ptr, nullptr);
+    }
+    EXPECT_FALSE(field.IsMaterialized());
+    EXPECT_EQ(Serialize(field), Field(concatenated));
+    EXPECT_EQ(field.GetMessage(TestAllTypes::default_instance(), nullptr)
+                  .SerializeAsString(),
+              merged.SerializeAsString());
+    field.Destroy();
+  }
+}
+
+TEST(LazyFieldTest, ParseMergesIntoMaterializedMessage) {
+  TestAllTypes first, second;
+  first.set_optional_int32(1);
+  second.set_optional_string("x");
+  const std::string first_data = Field(first.SerializeAsString());
+  const std::string second_data = Field(second.SerializeAsString());
+  LazyField field;
+  ASSERT_TRUE(Parse(first_data, /*aliasing=*/true, &field));
+  const MessageLite& message =
+      field.GetMessage(TestAllTypes::default_instance(), nullptr);
+  ASSERT_TRUE(Parse(second_data, /*aliasing=*/true, &field));
+  EXPECT_EQ(&field.GetMessage(TestAllTypes::default_instance(), nullptr),
+            &message);
+  const auto& merged = static_cast<const TestAllTypes&>(message);
+  EXPECT_EQ(merged.optional_int32(), 1);
+  EXPECT_EQ(merged.optional_string(), "x");
+  field.Destroy();
+}
+
+TEST(LazyFieldTest, MergeFrom) {
+  TestAllTypes first, second;
+  first.set_optional_int32(1);
+  first.add_repeated_int32(1);
+  second.set_optional_string("x");
+  second.add_repeated_int32(2);
+  TestAllTypes expected = first;
+  expected.MergeFrom(second);
+  const std::string first_data = Field(first.SerializeAsString());
+  const std::string second_data = Field(second.SerializeAsString());
+
+  // Unparsed into unparsed: bytes are concatenated.
+  {
+    LazyField to, from;
+    ASSERT_TRUE(Parse(first_data, true, &to));
+    ASSERT_TRUE(Parse(second_data, true, &from));
+    to.MergeFrom(TestAllTypes::default_instance(), from, nullptr);
+    EXPECT_FALSE(to.IsMaterialized());
+    EXPECT_EQ(to.GetMessage(TestAllTypes::default_instance(), nullptr)
+                  .SerializeAsString(),
+              expected.SerializeAsString());
+    to.Destroy();
+    from.Destroy();
+  }
+  // Unparsed into materialized.
+  {
+    LazyField to, from;
+    ASSERT_TRUE(Parse(first_data, true, &to));
+    ASSERT_TRUE(Parse(second_data, true, &from));
+    to.GetMessage(TestAllTypes::default_instance(), nullptr);
+    to.MergeFrom(TestAllTypes::default_instance(), from, nullptr);
+    EXPECT_EQ(Serialize(to), Field(expected.SerializeAsString()));
+    to.Destroy();
+    from.Destroy();
+  }
+  // Mutated into unparsed.
+  {
+    LazyField to, from;
+    ASSERT_TRUE(Parse(first_data, true, &to));
+    from.MutableMessage(TestAllTypes::default_instance(), nullptr)
+        ->CheckTypeAndMergeFrom(second);
+    to.MergeFrom(TestAllTypes::default_instance(), from, nullptr);
+    EXPECT_EQ(Serialize(to), Field(expected.SerializeAsString()));
+    to.Destroy();
+    from.Destroy();
+  }
+}
+
+TEST(LazyFieldTest, Clear) {
+  const std::string data = Field(NonCanonicalPayload());
+  LazyField field;
+  ASSERT_TRUE(Parse(data, true, &field));
+  field.Clear();
+  EXPECT_TRUE(field.IsEmpty());
+  EXPECT_EQ(Serialize(field), Field(""));
+
+  ASSERT_TRUE(Parse(data, true, &field));
+  const MessageLite* message =
+      field.MutableMessage(TestAllTypes::default_instance(), nullptr);
+  field.Clear();
+  EXPECT_TRUE(field.IsEmpty());
+  // The message is kept for reuse.
+  EXPECT_EQ(&field.GetMessage(TestAllTypes::default_instance(), nullptr),
+            message);
+  EXPECT_EQ(message->ByteSizeLong(), 0);
+  field.Destroy();
+}
+
+TEST(LazyFieldTest, InvalidPayloadReadsAsEmptyAndIsKept) {
+  const std::string data = Field("\xff\xff");
+  LazyField field;
+  ASSERT_TRUE(Parse(data, true, &field));
+  EXPECT_EQ(field.GetMessage(TestAllTypes::default_instance(), nullptr)
+                .ByteSizeLong(),
+            0);
+  EXPECT_EQ(Serialize(field), data);
+  field.Destroy();
+}
+
+TEST(LazyFieldTest, TruncatedInput) {
+  std::string data = Field(NonCanonicalPayload());
+  data.resize(data.size() - 1);
+  for (bool aliasing : {false, true}) {
+    LazyField field;
+    EXPECT_FALSE(Parse(data, aliasing, &field));
+    field.Destroy();
+  }
+}
+
+TEST(LazyFieldTest, OnArena) {
+  TestAllTypes payload;
+  TestUtil::SetAllFields(&payload);
+  Arena arena;
+  auto* field = Arena::Create<LazyField>(&arena);
+  ASSERT_TRUE(Parse(Field(payload.SerializeAsString()), false, field, &arena));
+  ASSERT_TRUE(Parse(Field(payload.SerializeAsString()), false, field, &arena));
+  const MessageLite& message =
+      field->GetMessage(TestAllTypes::default_instance(), &arena);
+  EXPECT_EQ(message.GetArena(), &arena);
+  EXPECT_EQ(field->MutableMessage(TestAllTypes::default_instance(), &arena),
+            &message);
+}
+
+TEST(LazyFieldTest, ConcurrentFirstAccess) {
+  TestAllTypes payload;
+  TestUtil::SetAllFields(&payload);
+  const std::string data = Field(payload.SerializeAsString());
+  for (int round = 0; round < 10; ++round) {
+    LazyField field;
+    ASSERT_TRUE(Parse(data, true, &field));
+    std::vector<const MessageLite*> results(4);
+    std::vector<std::thread> threads;
+    for (auto& result : results) {
+      threads.emplace_back([&] {
+        result = &field.GetMessage(TestAllTypes::default_instance(), nullptr);
+      });
+    }
+    for (auto& thread : threads) thread.join();
+    for (const MessageLite* result : results) {
+      EXPECT_EQ(result, results[0]);
+    }
+    TestUtil::ExpectAllFieldsSet(*static_cast<const TestAllTypes*>(results[0]));
+    field.Destroy();
+  }
+}
+
+TEST(LazyFieldTest, InternalSwap) {
+  const std::string data = Field(NonCanonicalPayload());
+  LazyField a, b;
+  ASSERT_TRUE(Parse(data, true, &a));
+  b.MutableMessage(TestAllTypes::default_instance(), nullptr);
+  a.InternalSwap(&b);
+  EXPECT_TRUE(a.IsMaterialized());
+  EXPECT_FALSE(b.IsMaterialized());
+  EXPECT_EQ(Serialize(b), data);
+  EXPECT_EQ(Serialize(a), Field(""));
+  a.Destroy();
+  b.Destroy();
+}
+
+// Generated code stores [lazy=true] fields such as
+// TestAllTypes.optional_lazy_message as a LazyField.
+
+// Returns a TestAllTypes encoding whose optional_lazy_message holds `payload`.
+std::string WithLazyMessage(absl::string_view payload) {
+  std::string out;
+  {
+    io::StringOutputStream output(&out);
+    io::CodedOutputStream coded(&output);
+    WireFormatLite::WriteBytes(TestAllTypes::kOptionalLazyMessageFieldNumber,
+                               std::string(payload), &coded);
+  }
+  return out;
+}
+
+TEST(LazyFieldTest, GeneratedCodeDefersParsing) {
+  // An invalid payload is not looked at by the parse, and is written back
+  // unchanged until the field is mutated.
+  const std::string data = WithLazyMessage("\xff\xff");
+  TestAllTypes message;
+  ASSERT_TRUE(message.ParseFromString(data));
+  EXPECT_TRUE(message.has_optional_lazy_message());
+  EXPECT_EQ(message.SerializeAsString(), data);
+  EXPECT_FALSE(message.optional_lazy_message().has_bb());
+  EXPECT_EQ(message.SerializeAsString(), data);
+
+  message.mutable_optional_lazy_message()->set_bb(7);
+  TestAllTypes reparsed;
+  ASSERT_TRUE(reparsed.ParseFromString(message.SerializeAsString()));
+  EXPECT_EQ(reparsed.optional_lazy_message().bb(), 7);
+}
+
+TEST(LazyFieldTest, GeneratedCodeKeepsEmptyMessagePresent) {
+  const std::string data = WithLazyMessage("");
+  TestAllTypes message;
+  ASSERT_TRUE(message.ParseFromString(data));
+  EXPECT_TRUE(message.has_optional_lazy_message());
+  EXPECT_EQ(message.SerializeAsString(), data);
+}
+
+TEST(LazyFieldTest, GeneratedCodeCopyMergeAndRelease) {
+  const std::string data = WithLazyMessage(NonCanonicalPayload());
+  TestAllTypes message;
+  ASSERT_TRUE(message.ParseFromString(data));
+
+  TestAllTypes copy(message);
+  EXPECT_EQ(copy.SerializeAsString(), data);
+  // Merging unparsed fields concatenates their bytes.
+  copy.MergeFrom(message);
+  EXPECT_EQ(copy.SerializeAsString(),
+            WithLazyMessage(NonCanonicalPayload() + NonCanonicalPayload()));
+  // NestedMessage.bb shares field number 1 with TestAllTypes.optional_int32.
+  EXPECT_EQ(copy.optional_lazy_message().bb(), 2);
+
+  std::unique_ptr<TestAllTypes::NestedMessage> released(
+      message.release_optional_lazy_message());
+  ASSERT_NE(released, nullptr);
+  EXPECT_FALSE(message.has_optional_lazy_message());
+  EXPECT_EQ(released->bb(), 2);
+}
+
+TEST(LazyFieldTest, GeneratedCodeChecksRequiredFields) {
+  protobuf_unittest::TestRequired required;
+  required.set_a(1);
+  std::string data;
+  {
+    io::StringOutputStream output(&data);
+    io::CodedOutputStream coded(&output);
+    WireFormatLite::WriteBytes(1, required.SerializePartialAsString(), &coded);
+  }
+  protobuf_unittest::TestLazyRequired message;
+  EXPECT_TRUE(message.ParsePartialFromString(data));
+  EXPECT_FALSE(message.IsInitialized());
+  EXPECT_FALSE(message.ParseFromString(data));
+
+  message.mutable_lazy_message()->set_b(2);
+  message.mutable_lazy_message()->set_c(3);
+  EXPECT_TRUE(message.IsInitialized());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace protobuf
+}  // namespace google
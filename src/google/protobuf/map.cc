@@ -30,12 +30,27 @@
 
 #include "google/protobuf/map.h"
 
+#include <atomic>
+
 namespace google {
 namespace protobuf {
 namespace internal {
 
 const TableEntryPtr kGlobalEmptyTable[kGlobalEmptyTableSize] = {};
 
+namespace {
+std::atomic<bool> map_open_addressing_default{false};
+}  // namespace
+
+bool MapOpenAddressingDefault() {
+  return map_open_addressing_default.load(std::memory_order_relaxed);
+}
+
 }  // namespace internal
+
+void SetMapOpenAddressingDefault(bool enable) {
+  internal::map_open_addressing_default.store(enable,
+                                              std::memory_order_relaxed);
+}
 }  // namespace protobuf
 }  // namespace google
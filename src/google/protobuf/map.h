@@ -38,6 +38,8 @@
 #define GOOGLE_PROTOBUF_MAP_H__
 
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <functional>
 #include <initializer_list>
 #include <iterator>
@@ -54,9 +56,16 @@
 #include <mach/mach_time.h>
 #endif
 
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#endif
+
 #include "google/protobuf/stubs/common.h"
 #include "google/protobuf/arena.h"
 #include "absl/container/btree_map.h"
+#include "absl/numeric/bits.h"
+#include "google/protobuf/endian.h"
 #include "google/protobuf/generated_enum_util.h"
 #include "google/protobuf/map_type_handler.h"
 #include "google/protobuf/port.h"
@@ -363,6 +372,95 @@ constexpr size_t kGlobalEmptyTableSize = 1;
 PROTOBUF_EXPORT extern const TableEntryPtr
     kGlobalEmptyTable[kGlobalEmptyTableSize];
 
+// Returns the value last passed to SetMapOpenAddressingDefault().
+PROTOBUF_EXPORT bool MapOpenAddressingDefault();
+
+// Control bytes of the open-addressing index.  Each slot of the table has one:
+// kMapCtrlEmpty, kMapCtrlDeleted for a slot whose element was erased, or the
+// low 7 bits of the element's hash for a full slot.  Lookups compare a group of
+// control bytes at once against the hash and only look at the matching nodes.
+enum : int8_t { kMapCtrlEmpty = -128, kMapCtrlDeleted = -2 };
+
+// The slots of a MapCtrlGroup that satisfy some condition.  Slot i corresponds
+// to bit (i << kShift) of the mask.  Iterating over it yields the slots in
+// increasing order.
+template <int kShift>
+class MapCtrlMask {
+ public:
+  explicit MapCtrlMask(uint64_t mask) : mask_(mask) {}
+
+  explicit operator bool() const { return mask_ != 0; }
+  int Lowest() const { return absl::countr_zero(mask_) >> kShift; }
+
+  int operator*() const { return Lowest(); }
+  MapCtrlMask& operator++() {
+    mask_ &= mask_ - 1;
+    return *this;
+  }
+  MapCtrlMask begin() const { return *this; }
+  MapCtrlMask end() const { return MapCtrlMask(0); }
+  friend bool operator!=(const MapCtrlMask& a, const MapCtrlMask& b) {
+    return a.mask_ != b.mask_;
+  }
+
+ private:
+  uint64_t mask_;
+};
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+// Sixteen control bytes, compared with one SSE2 instruction each.
+class MapCtrlGroup {
+ public:
+  static constexpr size_t kWidth = 16;
+  using Mask = MapCtrlMask<0>;
+
+  explicit MapCtrlGroup(const int8_t* ctrl)
+      : ctrl_(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl))) {}
+
+  Mask Match(int8_t h2) const {
+    return Mask(static_cast<uint32_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_))));
+  }
+  Mask MatchEmpty() const { return Match(kMapCtrlEmpty); }
+  // Empty and deleted slots are the ones whose control byte is negative.
+  Mask MatchEmptyOrDeleted() const {
+    return Mask(static_cast<uint32_t>(_mm_movemask_epi8(ctrl_)));
+  }
+
+ private:
+  __m128i ctrl_;
+};
+#else
+// Eight control bytes, compared as the bytes of a 64-bit word.
+class MapCtrlGroup {
+ public:
+  static constexpr size_t kWidth = 8;
+  using Mask = MapCtrlMask<3>;
+
+  explicit MapCtrlGroup(const int8_t* ctrl) {
+    memcpy(&ctrl_, ctrl, sizeof(ctrl_));
+    ctrl_ = little_endian::ToHost(ctrl_);
+  }
+
+  // May report slots whose control byte is h2 ^ 1 when the byte below matches.
+  // Those are full slots, whose keys are compared anyway.
+  Mask Match(int8_t h2) const {
+    const uint64_t x = ctrl_ ^ (kLsbs * static_cast<uint8_t>(h2));
+    return Mask((x - kLsbs) & ~x & kMsbs);
+  }
+  // Of the negative control bytes, only kMapCtrlEmpty has bit 1 clear.
+  Mask MatchEmpty() const { return Mask(ctrl_ & ~(ctrl_ << 6) & kMsbs); }
+  Mask MatchEmptyOrDeleted() const { return Mask(ctrl_ & kMsbs); }
+
+ private:
+  static constexpr uint64_t kLsbs = 0x0101010101010101;
+  static constexpr uint64_t kMsbs = 0x8080808080808080;
+
+  uint64_t ctrl_;
+};
+#endif
+
 // Space used for the table, trees, and nodes.
 // Does not include the indirect space used. Eg the data of a std::string.
 template <typename Key>
@@ -434,13 +532,24 @@ class KeyMapBase {
         seed_(0),
         index_of_first_non_null_(internal::kGlobalEmptyTableSize),
         table_(const_cast<TableEntryPtr*>(internal::kGlobalEmptyTable)),
-        alloc_(arena) {}
+        alloc_(arena),
+        index_request_(kIndexDefault),
+        open_addressing_(false),
+        reserved_log2_(0),
+        parse_reserved_log2_(0) {}
 
   KeyMapBase(const KeyMapBase&) = delete;
   KeyMapBase& operator=(const KeyMapBase&) = delete;
 
  protected:
-  enum { kMinTableSize = 8 };
+  enum {
+    kMinTableSize = 8,
+    // Must hold at least one group, and some empty slots besides.
+    kMinOpenAddressingTableSize = 16,
+  };
+  static_assert(kMinOpenAddressingTableSize >= MapCtrlGroup::kWidth, "");
+
+  enum : uint8_t { kIndexDefault, kIndexChained, kIndexOpenAddressing };
 
   struct KeyNode : NodeBase {
     static constexpr size_t kOffset = sizeof(NodeBase);
@@ -531,6 +640,60 @@ class KeyMapBase {
     std::swap(index_of_first_non_null_, other->index_of_first_non_null_);
     std::swap(table_, other->table_);
     std::swap(alloc_, other->alloc_);
+    std::swap(index_request_, other->index_request_);
+    std::swap(open_addressing_, other->open_addressing_);
+    std::swap(reserved_log2_, other->reserved_log2_);
+    std::swap(parse_reserved_log2_, other->parse_reserved_log2_);
+  }
+
+  // Grows the table so that it holds n elements without rehashing, and keeps
+  // it from shrinking below that.
+  void Reserve(size_type n) {
+    if (n > ReservedSize()) {
+      reserved_log2_ = static_cast<uint8_t>(absl::bit_width(n - 1));
+    }
+    Grow(n);
+  }
+
+  // Like Reserve(), but keeps the table from shrinking only until an element
+  // is erased.  n is counted from untrusted input, so it must not leave a
+  // large table behind for good.
+  void ReserveForParse(size_type n) {
+    if (n > ParseReservedSize()) {
+      parse_reserved_log2_ = static_cast<uint8_t>(absl::bit_width(n - 1));
+    }
+    Grow(n);
+  }
+
+  // Grows the table so that it holds n elements without rehashing.
+  void Grow(size_type n) {
+    if (n == 0) return;
+    if (num_buckets_ == kGlobalEmptyTableSize) {
+      // Allocates the smallest table, which picks the index.
+      Resize(kMinTableSize);
+    }
+    const size_type new_num_buckets = NumBucketsFor(n);
+    if (new_num_buckets > num_buckets_) Resize(new_num_buckets);
+  }
+
+  // Switches between the chained and the open-addressing index, moving the
+  // existing nodes to the new one.
+  void SetOpenAddressing(bool enable) {
+    index_request_ = enable ? kIndexOpenAddressing : kIndexChained;
+    if (num_buckets_ == kGlobalEmptyTableSize || open_addressing_ == enable) {
+      // The index is picked when the table is allocated.
+      return;
+    }
+    const auto old_table = table_;
+    const size_type old_table_size = num_buckets_;
+    const size_type start = index_of_first_non_null_;
+    const bool old_open_addressing = open_addressing_;
+    open_addressing_ = enable;
+    num_buckets_ = NumBucketsFor((std::max)(num_elements_, ReservedSize()));
+    table_ = CreateEmptyTable(num_buckets_);
+    index_of_first_non_null_ = num_buckets_;
+    TransferTable(old_table, old_table_size, start);
+    DeallocTable(old_table, old_table_size, old_open_addressing);
   }
 
   hasher hash_function() const { return {}; }
@@ -550,6 +713,11 @@ class KeyMapBase {
       auto* head = TableEntryToNode(table_[b]);
       head = EraseFromLinkedList(node, head);
       table_[b] = NodeToTableEntry(head);
+      if (open_addressing_) {
+        // Later elements of the same probe sequence may have been placed past
+        // this slot, so it must not look empty.
+        SetCtrl(b, kMapCtrlDeleted);
+      }
     } else {
       GOOGLE_ABSL_DCHECK(this->TableEntryIsTree(b));
       Tree* tree = internal::TableEntryToTree<Tree>(this->table_[b]);
@@ -564,6 +732,7 @@ class KeyMapBase {
       }
     }
     --num_elements_;
+    parse_reserved_log2_ = 0;
     if (PROTOBUF_PREDICT_FALSE(b == index_of_first_non_null_)) {
       while (index_of_first_non_null_ < num_buckets_ &&
              TableEntryIsEmpty(index_of_first_non_null_)) {
@@ -575,12 +744,16 @@ class KeyMapBase {
   struct NodeAndBucket {
     NodeBase* node;
     size_type bucket;
+    // With open addressing, the control byte of the key.  If node is null,
+    // bucket is the slot where the key would be inserted.
+    int8_t h2;
   };
   // TODO(sbenza): We can reduce duplication by coercing `K` to a common type.
   // Eg, for string keys we can coerce to string_view. Otherwise, we instantiate
   // this with all the different `char[N]` of the caller.
   template <typename K>
   NodeAndBucket FindHelper(const K& k, TreeIterator* it = nullptr) const {
+    if (open_addressing_) return FindOpenAddressing(k);
     size_type b = BucketNumber(k);
     if (TableEntryIsNonEmptyList(b)) {
       auto* node = internal::TableEntryToNode(table_[b]);
@@ -603,6 +776,47 @@ class KeyMapBase {
     return {nullptr, b};
   }
 
+  template <typename K>
+  NodeAndBucket FindOpenAddressing(const K& k) const {
+    const uint64_t h = OpenAddressingHash(k);
+    const int8_t h2 = static_cast<int8_t>(h & 0x7f);
+    const int8_t* ctrl = Ctrl();
+    const size_type mask = num_buckets_ - 1;
+    size_type pos = (h >> 7) & mask;
+    size_type free_slot = num_buckets_;
+    // Probe whole groups, moving further ahead each time.  Groups may start
+    // anywhere, as the control bytes wrap around past the end of the table.
+    for (size_type step = MapCtrlGroup::kWidth;; step += MapCtrlGroup::kWidth) {
+      MapCtrlGroup group(ctrl + pos);
+      for (int i : group.Match(h2)) {
+        const size_type slot = (pos + i) & mask;
+        auto* node = internal::TableEntryToNode(table_[slot]);
+        if (internal::TransparentSupport<Key>::Equals(
+                static_cast<KeyNode*>(node)->key(), k)) {
+          return {node, slot, h2};
+        }
+      }
+      if (free_slot == num_buckets_) {
+        auto free = group.MatchEmptyOrDeleted();
+        if (free) free_slot = (pos + free.Lowest()) & mask;
+      }
+      // An empty slot ends the probe sequence: the key would have gone there.
+      if (PROTOBUF_PREDICT_TRUE(group.MatchEmpty())) {
+        return {nullptr, free_slot, h2};
+      }
+      pos = (pos + step) & mask;
+    }
+  }
+
+  // Insert the node that FindHelper() did not find at the place it returned.
+  void InsertUnique(const NodeAndBucket& p, KeyNode* node) {
+    if (open_addressing_) {
+      InsertUniqueInSlot(p.bucket, p.h2, node);
+    } else {
+      InsertUnique(p.bucket, node);
+    }
+  }
+
   // Insert the given Node in bucket b.  If that would make bucket b too big,
   // and bucket b is not a tree, create a tree for buckets b.
   // Requires count(*KeyPtrFromNodePtr(node)) == 0 and that b is the correct
@@ -631,6 +845,20 @@ class KeyMapBase {
     }
   }
 
+  // Helper for InsertUnique with open addressing.  Slot s must be empty or
+  // deleted.
+  void InsertUniqueInSlot(size_type s, int8_t h2, KeyNode* node) {
+    GOOGLE_ABSL_DCHECK(FindHelper(node->key()).node == nullptr);
+    GOOGLE_ABSL_DCHECK_LT(Ctrl()[s], 0);
+    // Only filling an empty slot brings the table closer to a rehash: a
+    // deleted slot was already counted.
+    if (Ctrl()[s] == kMapCtrlEmpty) --GrowthLeft();
+    SetCtrl(s, h2);
+    node->next = nullptr;
+    table_[s] = NodeToTableEntry(node);
+    index_of_first_non_null_ = (std::min)(index_of_first_non_null_, s);
+  }
+
   // Returns whether we should insert after the head of the list. For
   // non-optimized builds, we randomly decide whether to insert right at the
   // head of the list or just after the head. This helps add a little bit of
@@ -682,8 +910,15 @@ class KeyMapBase {
   // policy that sometimes we resize down as well as up, clients can easily
   // keep O(size()) = O(number of buckets) if they want that.
   bool ResizeIfLoadIsOutOfRange(size_type new_size) {
-    const size_type kMaxMapLoadTimes16 = 12;  // controls RAM vs CPU tradeoff
-    const size_type hi_cutoff = num_buckets_ * kMaxMapLoadTimes16 / 16;
+    if (open_addressing_) {
+      // Erased slots count against the load until the next rehash, which
+      // drops them.  That rehash picks the size from the number of elements
+      // alone, so it can grow, shrink, or just clean up the table.
+      if (PROTOBUF_PREDICT_TRUE(GrowthLeft() > 0)) return false;
+      Resize(NumBucketsFor((std::max)(new_size * 2, ShrinkFloor())));
+      return true;
+    }
+    const size_type hi_cutoff = MaxLoad(num_buckets_);
     const size_type lo_cutoff = hi_cutoff / 4;
     // We don't care how many elements are in trees.  If a lot are,
     // we may resize even though there are many empty buckets.  In
@@ -703,9 +938,11 @@ class KeyMapBase {
       while ((hypothetical_size << lg2_of_size_reduction_factor) < hi_cutoff) {
         ++lg2_of_size_reduction_factor;
       }
-      size_type new_num_buckets = std::max<size_type>(
-          kMinTableSize, num_buckets_ >> lg2_of_size_reduction_factor);
-      if (new_num_buckets != num_buckets_) {
+      // Never below what Reserve() asked for.
+      size_type new_num_buckets =
+          (std::max)(NumBucketsFor(ShrinkFloor()),
+                     num_buckets_ >> lg2_of_size_reduction_factor);
+      if (new_num_buckets < num_buckets_) {
         Resize(new_num_buckets);
         return true;
       }
@@ -718,19 +955,36 @@ class KeyMapBase {
     if (num_buckets_ == kGlobalEmptyTableSize) {
       // This is the global empty array.
       // Just overwrite with a new one. No need to transfer or free anything.
-      num_buckets_ = index_of_first_non_null_ = kMinTableSize;
+      // The index is fixed from here on, unless SetOpenAddressing() changes
+      // it.
+      if (index_request_ == kIndexDefault) {
+        index_request_ = MapOpenAddressingDefault() ? kIndexOpenAddressing
+                                                    : kIndexChained;
+      }
+      open_addressing_ = index_request_ == kIndexOpenAddressing;
+      num_buckets_ = index_of_first_non_null_ = MinTableSize();
       table_ = CreateEmptyTable(num_buckets_);
       seed_ = Seed();
       return;
     }
 
-    GOOGLE_ABSL_DCHECK_GE(new_num_buckets, kMinTableSize);
+    GOOGLE_ABSL_DCHECK_GE(new_num_buckets, MinTableSize());
     const auto old_table = table_;
     const size_type old_table_size = num_buckets_;
     num_buckets_ = new_num_buckets;
     table_ = CreateEmptyTable(num_buckets_);
     const size_type start = index_of_first_non_null_;
     index_of_first_non_null_ = num_buckets_;
+    TransferTable(old_table, old_table_size, start);
+    DeallocTable(old_table, old_table_size, open_addressing_);
+  }
+
+  // Transfer all nodes of `old_table`, which may use either index, into
+  // `this`.  The buckets before `start` must be empty.
+  void TransferTable(TableEntryPtr* old_table, size_type old_table_size,
+                     size_type start) {
+    // The slots of an open-addressing table look like buckets holding lists
+    // of one node.
     for (size_type i = start; i < old_table_size; ++i) {
       if (internal::TableEntryIsNonEmptyList(old_table[i])) {
         TransferList(static_cast<KeyNode*>(TableEntryToNode(old_table[i])));
@@ -738,14 +992,20 @@ class KeyMapBase {
         TransferTree(TableEntryToTree<Tree>(old_table[i]));
       }
     }
-    Dealloc<TableEntryPtr>(old_table, old_table_size);
   }
 
   // Transfer all nodes in the list `node` into `this`.
   void TransferList(KeyNode* node) {
     do {
       auto* next = static_cast<KeyNode*>(node->next);
-      InsertUnique(BucketNumber(node->key()), node);
+      if (open_addressing_) {
+        // The new table has no deleted slots, so the first free slot of the
+        // probe sequence is the first empty one.
+        auto p = FindOpenAddressing(node->key());
+        InsertUniqueInSlot(p.bucket, p.h2, node);
+      } else {
+        InsertUnique(BucketNumber(node->key()), node);
+      }
       node = next;
     } while (node != nullptr);
   }
@@ -822,6 +1082,82 @@ class KeyMapBase {
     return ((kPhi * h) >> 32) & (num_buckets_ - 1);
   }
 
+  // The hash used with open addressing: the low 7 bits are the control byte
+  // and the others pick the first group to probe.
+  template <typename K>
+  uint64_t OpenAddressingHash(const K& k) const {
+    // As in BucketNumber(), but the high half of the product is folded into
+    // the low half, so that the control byte does not only depend on the low
+    // bits of the hash value.
+    constexpr uint64_t kPhi = uint64_t{0x9e3779b97f4a7c15};
+    uint64_t h = (hash_function()(k) ^ seed_) * kPhi;
+    return h ^ (h >> 32);
+  }
+
+  // The smallest number of buckets that holds n elements without growing.
+  size_type NumBucketsFor(size_type n) const {
+    size_type num_buckets = MinTableSize();
+    while (num_buckets <= max_size() / 2 && n >= MaxLoad(num_buckets)) {
+      num_buckets *= 2;
+    }
+    return num_buckets;
+  }
+
+  // The largest size passed to Reserve(), rounded up to a power of two.
+  size_type ReservedSize() const {
+    return reserved_log2_ == 0 ? 0 : size_type{1} << reserved_log2_;
+  }
+
+  // Same for ReserveForParse() since the last erase.
+  size_type ParseReservedSize() const {
+    return parse_reserved_log2_ == 0 ? 0 : size_type{1}
+                                                << parse_reserved_log2_;
+  }
+
+  // The size the table does not shrink below.
+  size_type ShrinkFloor() const {
+    return (std::max)(ReservedSize(), ParseReservedSize());
+  }
+
+  size_type MinTableSize() const {
+    return static_cast<size_type>(open_addressing_ ? kMinOpenAddressingTableSize
+                                                   : kMinTableSize);
+  }
+
+  // The load of a table with n buckets at which it grows.  With open
+  // addressing, erased slots count as part of the load.
+  size_type MaxLoad(size_type n) const {
+    const size_type kMaxMapLoadTimes16 = 12;  // controls RAM vs CPU tradeoff
+    return open_addressing_ ? n - n / 8 : n * kMaxMapLoadTimes16 / 16;
+  }
+
+  // An open-addressing table with n slots is a single allocation holding the
+  // n slots, the number of slots that can still be filled before the table
+  // must be rehashed, and the control bytes.  The first
+  // MapCtrlGroup::kWidth - 1 control bytes are repeated after the last one so
+  // that a group can be loaded starting at any slot.
+  static size_type OpenAddressingTableEntries(size_type n) {
+    return n + 1 +
+           (n + MapCtrlGroup::kWidth - 1 + sizeof(TableEntryPtr) - 1) /
+               sizeof(TableEntryPtr);
+  }
+  size_type& GrowthLeft() const {
+    return *reinterpret_cast<size_type*>(table_ + num_buckets_);
+  }
+  int8_t* Ctrl() const {
+    return reinterpret_cast<int8_t*>(table_ + num_buckets_ + 1);
+  }
+  void SetCtrl(size_type s, int8_t value) {
+    int8_t* ctrl = Ctrl();
+    ctrl[s] = value;
+    if (s < MapCtrlGroup::kWidth - 1) ctrl[num_buckets_ + s] = value;
+  }
+  // Marks every slot empty, for a table that holds no elements.
+  void ResetCtrl() {
+    memset(Ctrl(), kMapCtrlEmpty, num_buckets_ + MapCtrlGroup::kWidth - 1);
+    GrowthLeft() = MaxLoad(num_buckets_);
+  }
+
   // Return a power of two no less than max(kMinTableSize, n).
   // Assumes either n < kMinTableSize or n is a power of two.
   size_type TableSize(size_type n) {
@@ -850,14 +1186,28 @@ class KeyMapBase {
     }
   }
 
+  // Returns a table of n buckets for the current index.  With open
+  // addressing, num_buckets_ must already be n.
   TableEntryPtr* CreateEmptyTable(size_type n) {
-    GOOGLE_ABSL_DCHECK(n >= kMinTableSize);
+    GOOGLE_ABSL_DCHECK(n >= MinTableSize());
     GOOGLE_ABSL_DCHECK_EQ(n & (n - 1), 0u);
+    if (open_addressing_) {
+      GOOGLE_ABSL_DCHECK_EQ(n, num_buckets_);
+      table_ = Alloc<TableEntryPtr>(OpenAddressingTableEntries(n));
+      memset(table_, 0, n * sizeof(table_[0]));
+      ResetCtrl();
+      return table_;
+    }
     TableEntryPtr* result = Alloc<TableEntryPtr>(n);
     memset(result, 0, n * sizeof(result[0]));
     return result;
   }
 
+  void DeallocTable(TableEntryPtr* table, size_type n, bool open_addressing) {
+    Dealloc<TableEntryPtr>(table,
+                           open_addressing ? OpenAddressingTableEntries(n) : n);
+  }
+
   // Return a randomish value.
   size_type Seed() const {
     // We get a little bit of randomness from the address of the map. The
@@ -920,6 +1270,16 @@ class KeyMapBase {
   size_type index_of_first_non_null_;
   TableEntryPtr* table_;  // an array with num_buckets_ entries
   Allocator alloc_;
+  // The index asked for by SetOpenAddressing(), or kIndexDefault to use
+  // MapOpenAddressingDefault() once the table is allocated.
+  uint8_t index_request_;
+  // Whether table_ is an open-addressing table.  Its slots then hold the nodes
+  // directly, and nodes are not linked.
+  bool open_addressing_;
+  // Log2 of ReservedSize(), or 0 if Reserve() was not called with more than 1.
+  uint8_t reserved_log2_;
+  // Log2 of ParseReservedSize().  Cleared when an element is erased.
+  uint8_t parse_reserved_log2_;
 };
 
 }  // namespace internal
@@ -961,6 +1321,12 @@ struct PROTOBUF_ATTRIBUTE_STANDALONE_DEBUG MapPair {
 };
 #endif
 
+// Sets how maps that never call Map::set_open_addressing() index their
+// elements: with an open-addressing table if `enable` is true, with chained
+// buckets (the default) otherwise.  A map settles on its index when its first
+// element is inserted, so this is best called at startup.  Thread-safe.
+PROTOBUF_EXPORT void SetMapOpenAddressingDefault(bool enable);
+
 // Map is an associative container type used to store protobuf map
 // fields.  Each Map instance may or may not use a different hash function, a
 // different iteration order, and so on.  E.g., please don't examine
@@ -1069,6 +1435,12 @@ class Map {
   // 10. InnerMap uses KeyForTree<Key> when using the Tree representation, which
   //    is either `Key`, if Key is a scalar, or `reference_wrapper<const Key>`
   //    otherwise. This avoids unnecessary copies of string keys, for example.
+  // 11. Alternatively, the nodes can be indexed by an open-addressing table
+  //    (see Map::set_open_addressing()).  Each slot then points to a single
+  //    node, with a control byte per slot holding 7 bits of the hash so that
+  //    a group of slots can be probed at once, with SSE2 where available.
+  //    The slots look like buckets holding one-node lists, which lets
+  //    iteration and erase(iterator) share the code of the chained table.
   class InnerMap : public internal::KeyMapBase<internal::KeyForBase<Key>> {
    public:
     explicit constexpr InnerMap(Arena* arena) : InnerMap::KeyMapBase(arena) {}
@@ -1080,7 +1452,8 @@ class Map {
       if (this->alloc_.arena() == nullptr &&
           this->num_buckets_ != internal::kGlobalEmptyTableSize) {
         clear();
-        this->template Dealloc<TableEntryPtr>(this->table_, this->num_buckets_);
+        this->DeallocTable(this->table_, this->num_buckets_,
+                           this->open_addressing_);
       }
     }
 
@@ -1154,7 +1527,9 @@ class Map {
         } while (node != nullptr);
       }
       this->num_elements_ = 0;
+      this->parse_reserved_log2_ = 0;
       this->index_of_first_non_null_ = this->num_buckets_;
+      if (this->open_addressing_) this->ResetCtrl();
     }
 
     template <typename K>
@@ -1203,8 +1578,14 @@ class Map {
     }
 
     size_t SpaceUsedInternal() const {
-      return internal::SpaceUsedInTable<Key>(this->table_, this->num_buckets_,
-                                             this->num_elements_, sizeof(Node));
+      size_t size = internal::SpaceUsedInTable<Key>(
+          this->table_, this->num_buckets_, this->num_elements_, sizeof(Node));
+      if (this->open_addressing_) {
+        size += sizeof(TableEntryPtr) *
+                (this->OpenAddressingTableEntries(this->num_buckets_) -
+                 this->num_buckets_);
+      }
+      return size;
     }
 
    private:
@@ -1219,7 +1600,6 @@ class Map {
       if (this->ResizeIfLoadIsOutOfRange(this->num_elements_ + 1)) {
         p = this->FindHelper(k);
       }
-      const size_type b = p.bucket;  // bucket number
       // If K is not key_type, make the conversion to key_type explicit.
       using TypeToInit = typename std::conditional<
           std::is_same<typename std::decay<K>::type, key_type>::value, K&&,
@@ -1234,9 +1614,9 @@ class Map {
       Arena::CreateInArenaStorage(&node->kv.second, this->alloc_.arena(),
                                   std::forward<Args>(args)...);
 
-      this->InsertUnique(b, node);
+      this->InsertUnique(p, node);
       ++this->num_elements_;
-      return std::make_pair(iterator(node, this, b), true);
+      return std::make_pair(iterator(node, this, p.bucket), true);
     }
 
     // A helper function to perform an assignment of `mapped_type`.
@@ -1542,8 +1922,30 @@ class Map {
 
   void InternalSwap(Map* other) { elements_.Swap(&other->elements_); }
 
+  // Like Reserve(), for parsers.  The table may shrink again once an element
+  // is erased.
+  void InternalReserveForParse(size_type n) { elements_.ReserveForParse(n); }
+
   hasher hash_function() const { return {}; }
 
+  // Selects how elements are found by key: by chained buckets, or by an
+  // open-addressing table that probes a group of slots at once, with SSE2
+  // where available.  Open addressing makes inserts and lookups of absent
+  // keys faster, and lookups of string keys in large maps, as those compare
+  // fewer keys.  But a lookup reads a slot before reaching the element, so
+  // finding integer keys that are present can be slower, and unlike the
+  // chained table it does not guard against keys crafted to collide.  Either
+  // way elements are allocated one by one, so switching does not invalidate
+  // pointers or references to them; it does invalidate iterators.  The choice
+  // moves with the elements on swap() but is not copied.
+  void set_open_addressing(bool enable) { elements_.SetOpenAddressing(enable); }
+
+  // Makes room for `n` elements, so that inserting elements until size() is
+  // `n` does not rehash the table.  The table then does not shrink below that
+  // size, rounded up to a power of two, as it otherwise may when inserting
+  // after many elements were erased.
+  void Reserve(size_type n) { elements_.Reserve(n); }
+
   size_t SpaceUsedExcludingSelfLong() const {
     if (empty()) return 0;
     return elements_.SpaceUsedInternal() + internal::SpaceUsedInValues(this);
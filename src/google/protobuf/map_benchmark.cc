@@ -0,0 +1,131 @@
+// Protocol Buffers - Google's data interchange format
+// Copyright 2008 Google Inc.  All rights reserved.
+// https://developers.google.com/protocol-buffers/
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Compares the chained and the open-addressing index of Map: inserting keys
+// into an empty map, looking up keys that are present, and looking up keys
+// that are not, for int64 and string keys and maps of several sizes.
+//
+// Usage: map_benchmark [total operations per measurement]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "google/protobuf/map.h"
+#include "google/protobuf/stubs/logging.h"
+#include "absl/strings/str_cat.h"
+
+namespace google {
+namespace protobuf {
+namespace {
+
+double Seconds(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                       start)
+      .count();
+}
+
+int64_t MakeKey(int64_t i, int64_t*) { return i * 0x9e3779b97f4a7c15; }
+std::string MakeKey(int64_t i, std::string*) {
+  return absl::StrCat("some/longish/key/prefix/", i);
+}
+
+template <typename Key>
+std::vector<Key> MakeKeys(int64_t begin, int64_t end) {
+  std::vector<Key> keys;
+  for (int64_t i = begin; i < end; ++i) {
+    keys.push_back(MakeKey(i, static_cast<Key*>(nullptr)));
+  }
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(12345));
+  return keys;
+}
+
+template <typename Key>
+void Benchmark(const char* key_name, int size, int64_t operations) {
+  const std::vector<Key> present = MakeKeys<Key>(0, size);
+  const std::vector<Key> missing = MakeKeys<Key>(size, 2 * size);
+  const int64_t rounds = std::max<int64_t>(1, operations / size);
+  printf("%s keys, %d elements:\n", key_name, size);
+  for (bool open_addressing : {false, true}) {
+    const char* index = open_addressing ? "open addressing" : "chained";
+
+    auto start = std::chrono::steady_clock::now();
+    for (int64_t r = 0; r < rounds; ++r) {
+      Map<Key, int> map;
+      map.set_open_addressing(open_addressing);
+      for (const Key& key : present) map[key] = 1;
+      GOOGLE_ABSL_CHECK_EQ(map.size(), present.size());
+    }
+    const double insert = Seconds(start) / (rounds * size);
+
+    Map<Key, int> map;
+    map.set_open_addressing(open_addressing);
+    for (const Key& key : present) map[key] = 1;
+    int found = 0;
+    start = std::chrono::steady_clock::now();
+    for (int64_t r = 0; r < rounds; ++r) {
+      for (const Key& key : present) found += map.find(key)->second;
+    }
+    const double hit = Seconds(start) / (rounds * size);
+    GOOGLE_ABSL_CHECK_EQ(found, rounds * size);
+
+    start = std::chrono::steady_clock::now();
+    for (int64_t r = 0; r < rounds; ++r) {
+      for (const Key& key : missing) found += map.contains(key);
+    }
+    const double miss = Seconds(start) / (rounds * size);
+    GOOGLE_ABSL_CHECK_EQ(found, rounds * size);
+
+    printf("  %-16s insert %7.1f ns  find hit %7.1f ns  find miss %7.1f ns\n",
+           index, insert * 1e9, hit * 1e9, miss * 1e9);
+  }
+}
+
+int Run(int64_t operations) {
+  for (int size : {16, 1000, 100000, 1000000}) {
+    Benchmark<int64_t>("int64", size, operations);
+    Benchmark<std::string>("string", size, operations);
+  }
+  return 0;
+}
+
+}  // namespace
+}  // namespace protobuf
+}  // namespace google
+
+int main(int argc, char* argv[]) {
+  int64_t operations = argc > 1 ? atoll(argv[1]) : 4000000;
+  return google::protobuf::Run(operations);
+}
@@ -649,6 +649,90 @@ size_t DynamicMapField::SpaceUsedExcludingSelfNoLock() const {
   return size;
 }
 
+MapEntryView::MapEntryView(const Message& message,
+                           const FieldDescriptor* field)
+    : entry_(message.GetReflection()
+                 ->GetMessageFactory()
+                 ->GetPrototype(field->message_type())
+                 ->New()),
+      key_field_(field->message_type()->map_key()),
+      value_field_(field->message_type()->map_value()) {}
+
+MapEntryView::~MapEntryView() {
+  if (value_field_->cpp_type() == FieldDescriptor::CPPTYPE_MESSAGE) {
+    // The value belongs to the map.
+    entry_->GetReflection()->UnsafeArenaReleaseMessage(entry_.get(),
+                                                       value_field_);
+  }
+}
+
+const Message& MapEntryView::Set(const MapKey& key,
+                                 const MapValueConstRef& value) {
+  const Reflection* reflection = entry_->GetReflection();
+  Message* entry = entry_.get();
+  switch (key_field_->cpp_type()) {
+    case FieldDescriptor::CPPTYPE_STRING:
+      reflection->SetString(entry, key_field_, key.GetStringValue());
+      break;
+    case FieldDescriptor::CPPTYPE_INT64:
+      reflection->SetInt64(entry, key_field_, key.GetInt64Value());
+      break;
+    case FieldDescriptor::CPPTYPE_INT32:
+      reflection->SetInt32(entry, key_field_, key.GetInt32Value());
+      break;
+    case FieldDescriptor::CPPTYPE_UINT64:
+      reflection->SetUInt64(entry, key_field_, key.GetUInt64Value());
+      break;
+    case FieldDescriptor::CPPTYPE_UINT32:
+      reflection->SetUInt32(entry, key_field_, key.GetUInt32Value());
+      break;
+    case FieldDescriptor::CPPTYPE_BOOL:
+      reflection->SetBool(entry, key_field_, key.GetBoolValue());
+      break;
+    default:
+      GOOGLE_ABSL_LOG(DFATAL) << "Invalid key for map field.";
+      break;
+  }
+  switch (value_field_->cpp_type()) {
+    case FieldDescriptor::CPPTYPE_DOUBLE:
+      reflection->SetDouble(entry, value_field_, value.GetDoubleValue());
+      break;
+    case FieldDescriptor::CPPTYPE_FLOAT:
+      reflection->SetFloat(entry, value_field_, value.GetFloatValue());
+      break;
+    case FieldDescriptor::CPPTYPE_ENUM:
+      reflection->SetEnumValue(entry, value_field_, value.GetEnumValue());
+      break;
+    case FieldDescriptor::CPPTYPE_STRING:
+      reflection->SetString(entry, value_field_, value.GetStringValue());
+      break;
+    case FieldDescriptor::CPPTYPE_INT64:
+      reflection->SetInt64(entry, value_field_, value.GetInt64Value());
+      break;
+    case FieldDescriptor::CPPTYPE_INT32:
+      reflection->SetInt32(entry, value_field_, value.GetInt32Value());
+      break;
+    case FieldDescriptor::CPPTYPE_UINT64:
+      reflection->SetUInt64(entry, value_field_, value.GetUInt64Value());
+      break;
+    case FieldDescriptor::CPPTYPE_UINT32:
+      reflection->SetUInt32(entry, value_field_, value.GetUInt32Value());
+      break;
+    case FieldDescriptor::CPPTYPE_BOOL:
+      reflection->SetBool(entry, value_field_, value.GetBoolValue());
+      break;
+    case FieldDescriptor::CPPTYPE_MESSAGE:
+      // Point the entry at the value in the map.  Releasing the previous
+      // value first keeps the entry from ever owning one.
+      reflection->UnsafeArenaReleaseMessage(entry, value_field_);
+      reflection->UnsafeArenaSetAllocatedMessage(
+          entry, const_cast<Message*>(&value.GetMessageValue()),
+          value_field_);
+      break;
+  }
+  return *entry;
+}
+
 }  // namespace internal
 }  // namespace protobuf
 }  // namespace google
@@ -33,6 +33,7 @@
 
 #include <atomic>
 #include <functional>
+#include <memory>
 
 #include "google/protobuf/arena.h"
 #include "google/protobuf/port.h"
@@ -937,6 +938,32 @@ class PROTOBUF_EXPORT MapIterator {
   MapValueRef value_;
 };
 
+namespace internal {
+
+// Presents the elements of a map field one at a time as messages of its entry
+// type, for code written against entry messages, such as printers.  Unlike
+// the repeated field view of the map, which holds an entry message for every
+// element, this holds a single one that each Set() overwrites.  A message
+// value is referred to rather than copied, so it must outlive that use.
+class PROTOBUF_EXPORT MapEntryView {
+ public:
+  // `field` is a map field of `message`.
+  MapEntryView(const Message& message, const FieldDescriptor* field);
+  MapEntryView(const MapEntryView&) = delete;
+  MapEntryView& operator=(const MapEntryView&) = delete;
+  ~MapEntryView();
+
+  // Returns the entry message holding `key` and `value`.
+  const Message& Set(const MapKey& key, const MapValueConstRef& value);
+
+ private:
+  std::unique_ptr<Message> entry_;
+  const FieldDescriptor* key_field_;
+  const FieldDescriptor* value_field_;
+};
+
+}  // namespace internal
+
 }  // namespace protobuf
 }  // namespace google
 
@@ -31,6 +31,7 @@
 #ifndef GOOGLE_PROTOBUF_MAP_FIELD_LITE_H__
 #define GOOGLE_PROTOBUF_MAP_FIELD_LITE_H__
 
+#include <algorithm>
 #include <type_traits>
 
 #include "google/protobuf/port.h"
@@ -159,6 +160,29 @@ EnumParseWrapper<UnknownType, T> InitEnumParseWrapper(
                                           metadata};
 }
 
+// The most entries ReserveMapEntries() reserves past the size of a map, unless
+// the map is larger still, in which case it reserves up to doubling it.
+constexpr size_t kMaxMapEntriesReservedAhead = 1024;
+
+// Called by generated parsers before the run of entries of a map field that
+// starts at `ptr`.  Reserves room for the entries that are already buffered,
+// so that a large map is parsed into a table allocated once instead of one
+// that is rehashed every time it doubles.  Entries with repeated keys add no
+// elements and take as little as two bytes (`0a 00`), so the count is capped,
+// and the table may shrink below it once an element is erased.
+template <uint32_t tag, typename MapFieldType>
+void ReserveMapEntries(MapFieldType* map_field, const char* ptr,
+                       ParseContext* ctx) {
+  const int count = ctx->CountBufferedFields<tag>(ptr);
+  if (count > 1) {
+    auto* map = map_field->MutableMap();
+    const size_t size = map->size();
+    map->InternalReserveForParse(
+        size + (std::min)(static_cast<size_t>(count),
+                          (std::max)(kMaxMapEntriesReservedAhead, size)));
+  }
+}
+
 // True if IsInitialized() is true for value field in all elements of t. T is
 // expected to be message.  It's useful to have this helper here to keep the
 // protobuf compiler from ever having to emit loops in IsInitialized() methods.
@@ -188,6 +188,9 @@ void PerformAbslStringify(
 namespace util {
 class MessageDifferencer;
 }
+namespace json_internal {
+struct UnparseProto2Descriptor;  // unparser_traits.h
+}  // namespace json_internal
 
 
 namespace internal {
@@ -1124,6 +1127,8 @@ class PROTOBUF_EXPORT Reflection final {
   friend struct internal::FuzzPeer;
   // Needed for implementing text format for map.
   friend class internal::MapFieldPrinterHelper;
+  // Needed for implementing JSON for map.
+  friend struct json_internal::UnparseProto2Descriptor;
 
   Reflection(const Descriptor* descriptor,
              const internal::ReflectionSchema& schema,
@@ -59,6 +59,7 @@
 #include "google/protobuf/io/zero_copy_stream_impl.h"
 #include "google/protobuf/io/zero_copy_stream_impl_lite.h"
 #include "google/protobuf/parse_context.h"
+#include "google/protobuf/wire_format_lite.h"
 
 
 // Must be included last.
@@ -431,11 +432,14 @@ bool MessageLite::SerializeToZeroCopyStream(
   return SerializePartialToZeroCopyStream(output);
 }
 
-bool MessageLite::SerializePartialToZeroCopyStream(
-    io::ZeroCopyOutputStream* output) const {
-  const size_t size = ByteSizeLong();  // Force size to be cached.
+namespace {
+
+bool SerializePartialToZeroCopyStreamImpl(const MessageLite& msg,
+                                          io::ZeroCopyOutputStream* output,
+                                          bool aliasing) {
+  const size_t size = msg.ByteSizeLong();  // Force size to be cached.
   if (size > INT_MAX) {
-    GOOGLE_ABSL_LOG(ERROR) << GetTypeName()
+    GOOGLE_ABSL_LOG(ERROR) << msg.GetTypeName()
                     << " exceeded maximum protobuf size of 2GB: " << size;
     return false;
   }
@@ -444,20 +448,34 @@ bool MessageLite::SerializePartialToZeroCopyStream(
   io::EpsCopyOutputStream stream(
       output, io::CodedOutputStream::IsDefaultSerializationDeterministic(),
       &target);
-  target = _InternalSerialize(target, &stream);
+  stream.EnableAliasing(aliasing);
+  target = msg._InternalSerialize(target, &stream);
   stream.Trim(target);
   if (stream.HadError()) return false;
   return true;
 }
 
+}  // namespace
+
+bool MessageLite::SerializePartialToZeroCopyStream(
+    io::ZeroCopyOutputStream* output) const {
+  return SerializePartialToZeroCopyStreamImpl(*this, output,
+                                              /*aliasing=*/false);
+}
+
 bool MessageLite::SerializeToFileDescriptor(int file_descriptor) const {
-  io::FileOutputStream output(file_descriptor);
-  return SerializeToZeroCopyStream(&output) && output.Flush();
+  GOOGLE_ABSL_DCHECK(IsInitialized())
+      << InitializationErrorMessage("serialize", *this);
+  return SerializePartialToFileDescriptor(file_descriptor);
 }
 
 bool MessageLite::SerializePartialToFileDescriptor(int file_descriptor) const {
-  io::FileOutputStream output(file_descriptor);
-  return SerializePartialToZeroCopyStream(&output) && output.Flush();
+  // The message outlives the stream, so large string and bytes fields can be
+  // written directly from it.
+  io::VectoredFileOutputStream output(file_descriptor);
+  return SerializePartialToZeroCopyStreamImpl(*this, &output,
+                                              /*aliasing=*/true) &&
+         output.Flush();
 }
 
 bool MessageLite::SerializeToOstream(std::ostream* output) const {
@@ -506,6 +524,37 @@ bool MessageLite::SerializePartialToString(std::string* output) const {
   return AppendPartialToString(output);
 }
 
+bool MessageLite::SerializeToStringWithFlatSizes(std::string* output) const {
+  GOOGLE_ABSL_DCHECK(IsInitialized())
+      << InitializationErrorMessage("serialize", *this);
+  return SerializePartialToStringWithFlatSizes(output);
+}
+
+bool MessageLite::SerializePartialToStringWithFlatSizes(
+    std::string* output) const {
+  output->clear();
+  internal::FlatSizeCache sizes;
+  size_t byte_size = FlatByteSizeLong(&sizes);
+  if (byte_size > INT_MAX) {
+    GOOGLE_ABSL_LOG(ERROR) << GetTypeName()
+                    << " exceeded maximum protobuf size of 2GB: " << byte_size;
+    return false;
+  }
+
+  absl::strings_internal::STLStringResizeUninitializedAmortized(output,
+                                                                byte_size);
+  uint8_t* start = reinterpret_cast<uint8_t*>(io::mutable_string_data(output));
+  io::EpsCopyOutputStream out(
+      start, static_cast<int>(byte_size),
+      io::CodedOutputStream::IsDefaultSerializationDeterministic());
+  out.SetFlatSizes(sizes.data());
+  uint8_t* end = _InternalSerializeFlatSized(start, &out);
+  GOOGLE_ABSL_DCHECK(start + byte_size == end);
+  GOOGLE_ABSL_DCHECK(out.flat_sizes() == sizes.data() + sizes.size());
+  (void)end;
+  return true;
+}
+
 bool MessageLite::SerializeToArray(void* data, int size) const {
   GOOGLE_ABSL_DCHECK(IsInitialized())
       << InitializationErrorMessage("serialize", *this);
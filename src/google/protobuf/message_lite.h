@@ -90,9 +90,11 @@ class SwapFieldHelper;
 class ParseContext;
 
 class ExtensionSet;
+class FlatSizeCache;
 class LazyField;
 class RepeatedPtrFieldBase;
 class TcParser;
+class TcReverseSerializer;
 class WireFormatLite;
 class WeakFieldMap;
 
@@ -371,6 +373,21 @@ class PROTOBUF_EXPORT MessageLite {
   // Like AppendToString(), but allows missing required fields.
   bool AppendPartialToString(std::string* output) const;
 
+  // Like SerializeToString(), but the sizing pass records the sizes of
+  // singular and repeated sub-message fields in a flat side array (see
+  // FlatByteSizeLong()) that the serialization pass then reads front to back,
+  // instead of storing them in each sub-message's cached size.  This saves a
+  // store per sub-message, which helps messages with many of them.
+  //
+  // The message tree is still written to: packed fields, maps, extensions,
+  // groups and messages generated by older versions of protoc are sized and
+  // serialized with their cached sizes as before.  It is therefore no safer
+  // than SerializeToString() to call on a message that another thread is
+  // serializing.
+  bool SerializeToStringWithFlatSizes(std::string* output) const;
+  // Like SerializeToStringWithFlatSizes(), but allows missing required fields.
+  bool SerializePartialToStringWithFlatSizes(std::string* output) const;
+
   // Reads a protocol buffer from a Cord and merges it into this message.
   bool MergeFromCord(const absl::Cord& cord);
   // Like MergeFromCord(), but accepts messages that are missing
@@ -445,6 +462,14 @@ class PROTOBUF_EXPORT MessageLite {
   // method.)
   virtual int GetCachedSize() const = 0;
 
+  // Computes the serialized size like ByteSizeLong(), but appends the sizes of
+  // sub-messages to `sizes` in serialization order instead of caching them.
+  // Serializing with EpsCopyOutputStream::SetFlatSizes(sizes->data()) then
+  // reproduces them.  The default implementation just calls ByteSizeLong().
+  virtual size_t FlatByteSizeLong(internal::FlatSizeCache* /*sizes*/) const {
+    return ByteSizeLong();
+  }
+
   virtual const char* _InternalParse(const char* /*ptr*/,
                                      internal::ParseContext* /*ctx*/) {
     return nullptr;
@@ -493,6 +518,15 @@ class PROTOBUF_EXPORT MessageLite {
   virtual uint8_t* _InternalSerialize(
       uint8_t* ptr, io::EpsCopyOutputStream* stream) const = 0;
 
+  // Like _InternalSerialize(), but takes the sizes of sub-messages from the
+  // flat sizes of `stream` (see FlatByteSizeLong()).  Generated messages that
+  // override FlatByteSizeLong() override this too, so that _InternalSerialize()
+  // itself never has to check for flat sizes.
+  virtual uint8_t* _InternalSerializeFlatSized(
+      uint8_t* ptr, io::EpsCopyOutputStream* stream) const {
+    return _InternalSerialize(ptr, stream);
+  }
+
   // Identical to IsInitialized() except that it logs an error message.
   bool IsInitializedWithErrors() const {
     if (IsInitialized()) return true;
@@ -509,6 +543,7 @@ class PROTOBUF_EXPORT MessageLite {
   friend class internal::LazyField;
   friend class internal::SwapFieldHelper;
   friend class internal::TcParser;
+  friend class internal::TcReverseSerializer;
   friend class internal::WeakFieldMap;
   friend class internal::WireFormatLite;
 
@@ -0,0 +1,188 @@
+// Protocol Buffers - Google's data interchange format
+// Copyright 2008 Google Inc.  All rights reserved.
+// https://developers.google.com/protocol-buffers/
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Measures packed varint decoding in values per second for several varint
+// length distributions:
+//  - scalar: one VarintParse() and RepeatedField::Add() per value, which is
+//    how packed varints were decoded before the group decoder;
+//  - reserved: the same loop into a field reserved up front with
+//    AddAlreadyReserved(), which isolates the cost of decoding;
+//  - group: internal::ReadPackedVarintArray(), which classifies 16 bytes at a
+//    time (8 without SSE2), into a field reserved the same way;
+//  - parse: a generated TestPackedTypes parse of the same values, including
+//    the per-buffer reservation.
+//
+// Usage: packed_varint_benchmark [values per distribution]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "google/protobuf/io/coded_stream.h"
+#include "google/protobuf/parse_context.h"
+#include "google/protobuf/repeated_field.h"
+#include "google/protobuf/stubs/logging.h"
+#include "google/protobuf/unittest.pb.h"
+
+namespace google {
+namespace protobuf {
+namespace {
+
+using ::protobuf_unittest::TestPackedTypes;
+
+double Seconds(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                       start)
+      .count();
+}
+
+// Values whose encodings are `min_bytes` to `max_bytes` bytes long, with each
+// length equally likely.
+std::vector<int64_t> MakeValues(int count, int min_bytes, int max_bytes) {
+  std::mt19937_64 rng(12345);
+  std::uniform_int_distribution<int> length(min_bytes, max_bytes);
+  std::vector<int64_t> values;
+  for (int i = 0; i < count; ++i) {
+    // The highest bit of the last 7 bit group is set so that the encoding has
+    // exactly the chosen length.
+    int top_bit = std::min(7 * length(rng) - 1, 63);
+    uint64_t value = rng() & (~uint64_t{0} >> (63 - top_bit));
+    value |= uint64_t{1} << top_bit;
+    values.push_back(static_cast<int64_t>(value));
+  }
+  return values;
+}
+
+// Returns the packed payload of `values`, without tag and length, followed by
+// the 16 bytes of slop the parser is allowed to read past the end.
+std::string EncodePayload(const std::vector<int64_t>& values) {
+  std::string payload(values.size() * 10 + 16, '\0');
+  uint8_t* start = reinterpret_cast<uint8_t*>(&payload[0]);
+  uint8_t* ptr = start;
+  for (int64_t v : values) {
+    ptr = io::CodedOutputStream::WriteVarint64ToArray(v, ptr);
+  }
+  payload.resize(ptr - start + 16);
+  return payload;
+}
+
+const char* ScalarDecode(const char* ptr, const char* end,
+                         RepeatedField<int64_t>* out) {
+  while (ptr < end) {
+    uint64_t varint;
+    ptr = internal::VarintParse(ptr, &varint);
+    if (ptr == nullptr) return nullptr;
+    out->Add(varint);
+  }
+  return ptr;
+}
+
+const char* ScalarReservedDecode(const char* ptr, const char* end,
+                                 RepeatedField<int64_t>* out) {
+  out->Reserve(out->size() + internal::CountVarintsUpperBound(ptr, end));
+  while (ptr < end) {
+    uint64_t varint;
+    ptr = internal::VarintParse(ptr, &varint);
+    if (ptr == nullptr) return nullptr;
+    out->AddAlreadyReserved(varint);
+  }
+  return ptr;
+}
+
+const char* GroupDecode(const char* ptr, const char* end,
+                        RepeatedField<int64_t>* out) {
+  out->Reserve(out->size() + internal::CountVarintsUpperBound(ptr, end));
+  return internal::ReadPackedVarintArray(
+      ptr, end, [out](uint64_t varint) { out->AddAlreadyReserved(varint); });
+}
+
+template <typename Decode>
+double Measure(const std::string& payload, int count, int rounds,
+               Decode decode) {
+  auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < rounds; ++r) {
+    RepeatedField<int64_t> out;
+    const char* end = decode(payload.data(),
+                             payload.data() + payload.size() - 16, &out);
+    GOOGLE_ABSL_CHECK(end != nullptr);
+    GOOGLE_ABSL_CHECK_EQ(out.size(), count);
+  }
+  return static_cast<double>(count) * rounds / Seconds(start);
+}
+
+void Benchmark(const char* name, int count, int min_bytes, int max_bytes) {
+  const std::vector<int64_t> values = MakeValues(count, min_bytes, max_bytes);
+  const std::string payload = EncodePayload(values);
+  const int rounds = 50000000 / count + 1;
+  const double scalar = Measure(payload, count, rounds, ScalarDecode);
+  const double reserved =
+      Measure(payload, count, rounds, ScalarReservedDecode);
+  const double group = Measure(payload, count, rounds, GroupDecode);
+
+  TestPackedTypes source;
+  for (int64_t v : values) source.add_packed_int64(v);
+  const std::string message = source.SerializeAsString();
+  auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < rounds; ++r) {
+    TestPackedTypes parsed;
+    GOOGLE_ABSL_CHECK(parsed.ParseFromString(message));
+  }
+  const double parse = static_cast<double>(count) * rounds / Seconds(start);
+
+  printf(
+      "%-11s scalar %6.1f  reserved %6.1f  group %6.1f (%.2fx)  parse %6.1f "
+      "M values/s\n",
+      name, scalar / 1e6, reserved / 1e6, group / 1e6, group / reserved,
+      parse / 1e6);
+}
+
+int Run(int count) {
+  Benchmark("1 byte", count, 1, 1);
+  Benchmark("1-2 bytes", count, 1, 2);
+  Benchmark("1-3 bytes", count, 1, 3);
+  Benchmark("1-5 bytes", count, 1, 5);
+  Benchmark("1-10 bytes", count, 1, 10);
+  Benchmark("9-10 bytes", count, 9, 10);
+  return 0;
+}
+
+}  // namespace
+}  // namespace protobuf
+}  // namespace google
+
+int main(int argc, char* argv[]) {
+  int count = argc > 1 ? atoi(argv[1]) : 100000;
+  return google::protobuf::Run(count);
+}
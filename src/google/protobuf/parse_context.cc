@@ -399,19 +399,23 @@ const char* InlineGreedyStringParser(std::string* s, const char* ptr,
 
 template <typename T, bool sign>
 const char* VarintParser(void* object, const char* ptr, ParseContext* ctx) {
-  return ctx->ReadPackedVarint(ptr, [object](uint64_t varint) {
-    T val;
-    if (sign) {
-      if (sizeof(T) == 8) {
-        val = WireFormatLite::ZigZagDecode64(varint);
-      } else {
-        val = WireFormatLite::ZigZagDecode32(varint);
-      }
-    } else {
-      val = varint;
-    }
-    static_cast<RepeatedField<T>*>(object)->Add(val);
-  });
+  auto* field = static_cast<RepeatedField<T>*>(object);
+  return ctx->ReadPackedVarint(
+      ptr,
+      [field](uint64_t varint) {
+        T val;
+        if (sign) {
+          if (sizeof(T) == 8) {
+            val = WireFormatLite::ZigZagDecode64(varint);
+          } else {
+            val = WireFormatLite::ZigZagDecode32(varint);
+          }
+        } else {
+          val = varint;
+        }
+        field->AddAlreadyReserved(val);
+      },
+      [field](int num) { field->Reserve(field->size() + num); });
 }
 
 const char* PackedInt32Parser(void* object, const char* ptr,
@@ -36,8 +36,14 @@
 #include <string>
 #include <type_traits>
 
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#endif
+
 #include "google/protobuf/stubs/logging.h"
 #include "google/protobuf/stubs/logging.h"
+#include "absl/numeric/bits.h"
 #include "absl/strings/internal/resize_uninitialized.h"
 #include "absl/strings/string_view.h"
 #include "google/protobuf/arena.h"
@@ -190,11 +196,32 @@ class PROTOBUF_EXPORT EpsCopyInputStream {
                                                    Tag expected_tag,
                                                    RepeatedField<T>* out);
 
+  // Returns how many length-delimited fields with tag `tag` follow each other
+  // from `ptr`, which points to the tag of the first one.  Only fields that
+  // start in the data buffered so far are counted, which when parsing a flat
+  // array is nearly all of them.  Used to size containers before parsing
+  // their elements.
+  template <uint32_t tag>
+  int CountBufferedFields(const char* ptr) const;
+  // Same as above for a tag that is only known at run time, given as the
+  // value UnalignedLoad<TagType>() reads from its bytes.
+  template <typename TagType>
+  int CountBufferedFields(const char* ptr, TagType coded_tag) const;
+
   template <typename T>
   PROTOBUF_NODISCARD const char* ReadPackedFixed(const char* ptr, int size,
                                                  RepeatedField<T>* out);
   template <typename Add>
-  PROTOBUF_NODISCARD const char* ReadPackedVarint(const char* ptr, Add add);
+  PROTOBUF_NODISCARD const char* ReadPackedVarint(const char* ptr, Add add) {
+    return ReadPackedVarint(ptr, add, [](int) {});
+  }
+  // Like above, but before decoding each contiguous chunk of the packed field
+  // calls size_callback with an upper bound on the number of values `add` will
+  // receive for that chunk. This lets callers reserve space once per chunk
+  // instead of growing the destination one element at a time.
+  template <typename Add, typename SizeCb>
+  PROTOBUF_NODISCARD const char* ReadPackedVarint(const char* ptr, Add add,
+                                                  SizeCb size_callback);
 
   uint32_t LastTag() const { return last_tag_minus_1_ + 1; }
   bool ConsumeEndGroup(uint32_t start_tag) {
@@ -211,6 +238,22 @@ class PROTOBUF_EXPORT EpsCopyInputStream {
            (next_chunk_ == nullptr || ptr - buffer_end_ > limit_);
   }
   bool AliasingEnabled() const { return aliasing_ != kNoAliasing; }
+  // If aliasing is enabled and the `size` bytes at `ptr` are contiguous in the
+  // caller's input, returns their address in that input, which outlives the
+  // parse. Otherwise returns nullptr and the bytes have to be copied. The
+  // caller is responsible for checking `size` against the current limit.
+  const char* AliasedData(const char* ptr, int size) const {
+    if (aliasing_ == kNoAliasing || aliasing_ == kOnPatch) return nullptr;
+    // Reading straight from the caller's buffer, the slop bytes are part of it
+    // too. Otherwise `ptr` is in the patch buffer, of which only the bytes
+    // before buffer_end_ have a counterpart in the input.
+    if (aliasing_ == kNoDelta) {
+      return size <= buffer_end_ + kSlopBytes - ptr ? ptr : nullptr;
+    }
+    if (size > buffer_end_ - ptr) return nullptr;
+    return reinterpret_cast<const char*>(reinterpret_cast<std::uintptr_t>(ptr) +
+                                         aliasing_);
+  }
   int BytesUntilLimit(const char* ptr) const {
     return limit_ + static_cast<int>(buffer_end_ - ptr);
   }
@@ -329,6 +372,10 @@ class PROTOBUF_EXPORT EpsCopyInputStream {
   const char* SkipFallback(const char* ptr, int size);
   const char* AppendStringFallback(const char* ptr, int size, std::string* str);
   const char* ReadStringFallback(const char* ptr, int size, std::string* str);
+  // Implements CountBufferedFields() for tags of `tag_size` bytes recognized
+  // by `is_tag`.
+  template <typename IsTag>
+  int CountBufferedFields(const char* ptr, int tag_size, IsTag is_tag) const;
   bool StreamNext(const void** data) {
     bool res = zcis_->Next(data, &size_);
     if (res) overall_limit_ -= size_;
@@ -884,6 +931,39 @@ const char* EpsCopyInputStream::ReadRepeatedFixed(const char* ptr,
   return ptr;
 }
 
+template <uint32_t tag>
+int EpsCopyInputStream::CountBufferedFields(const char* ptr) const {
+  return CountBufferedFields(ptr, tag < 128 ? 1 : 2,
+                             [](const char* p) { return ExpectTag<tag>(p); });
+}
+
+template <typename TagType>
+int EpsCopyInputStream::CountBufferedFields(const char* ptr,
+                                            TagType coded_tag) const {
+  return CountBufferedFields(ptr, sizeof(TagType), [coded_tag](const char* p) {
+    return UnalignedLoad<TagType>(p) == coded_tag;
+  });
+}
+
+template <typename IsTag>
+int EpsCopyInputStream::CountBufferedFields(const char* ptr, int tag_size,
+                                            IsTag is_tag) const {
+  int count = 0;
+  // The tag and the size take at most 7 bytes, so they can be read from
+  // anywhere before limit_end_ thanks to the slop bytes.
+  while (ptr < limit_end_ && is_tag(ptr)) {
+    ++count;
+    ptr += tag_size;
+    const uint32_t size = ReadSize(&ptr);
+    if (ptr == nullptr || ptr >= limit_end_ ||
+        size >= static_cast<uint32_t>(limit_end_ - ptr)) {
+      break;
+    }
+    ptr += size;
+  }
+  return count;
+}
+
 // Add any of the following lines to debug which parse function is failing.
 
 #define GOOGLE_PROTOBUF_ASSERT_RETURN(predicate, ret) \
@@ -901,6 +981,14 @@ const char* EpsCopyInputStream::ReadPackedFixed(const char* ptr, int size,
                                                 RepeatedField<T>* out) {
   GOOGLE_PROTOBUF_PARSER_ASSERT(ptr);
   int nbytes = static_cast<int>(buffer_end_ + kSlopBytes - ptr);
+  if (size > nbytes && PROTOBUF_PREDICT_TRUE(size <= BytesUntilLimit(ptr))) {
+    // The payload spans several buffers. Reserve the whole field up front, up
+    // to the same static safe size used for strings, so that the per-buffer
+    // copies below land directly in the final backing store instead of
+    // regrowing it once per buffer.
+    out->Reserve(out->size() +
+                 std::min<int>(size, kSafeStringSize) / sizeof(T));
+  }
   while (size > nbytes) {
     int num = nbytes / sizeof(T);
     int old_entries = out->size();
@@ -937,8 +1025,93 @@ const char* EpsCopyInputStream::ReadPackedFixed(const char* ptr, int size,
   return ptr;
 }
 
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+// Number of bytes VarintTerminatorMask() classifies at once.
+constexpr int kVarintGroupWidth = 16;
+
+// Returns a mask with bit i set if byte i at `p` does not have the
+// continuation bit set, i.e. ends a varint.  Classifies 16 bytes with SSE2.
+inline uint32_t VarintTerminatorMask(const char* p) {
+  return ~static_cast<uint32_t>(_mm_movemask_epi8(
+             _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)))) &
+         0xFFFF;
+}
+#else
+constexpr int kVarintGroupWidth = 8;
+
+// Same as above for 8 bytes, classified as the bytes of a 64-bit word.  The
+// multiplication gathers the high bit of every byte into the top byte.
+inline uint32_t VarintTerminatorMask(const char* p) {
+  uint64_t word;
+  std::memcpy(&word, p, sizeof(word));
+  return static_cast<uint32_t>(
+      (((~word & uint64_t{0x8080808080808080}) >> 7) *
+       uint64_t{0x0102040810204080}) >>
+      56);
+}
+#endif
+
+// Decodes the varint of 1 to 8 bytes at `p`, whose length is already known.
+// Reads 8 bytes, so they must be available.  Only used in little endian mode.
+inline uint64_t DecodeShortVarint(const char* p, int len) {
+  uint64_t word;
+  std::memcpy(&word, p, sizeof(word));
+  word &= ~uint64_t{0} >> (64 - 8 * len);
+  word &= uint64_t{0x7f7f7f7f7f7f7f7f};
+  // Squeeze out the continuation bits, doubling the group width each step.
+  word = ((word & uint64_t{0x7f007f007f007f00}) >> 1) |
+         (word & uint64_t{0x007f007f007f007f});
+  word = ((word & uint64_t{0x3fff00003fff0000}) >> 2) |
+         (word & uint64_t{0x00003fff00003fff});
+  word = ((word & uint64_t{0x0fffffff00000000}) >> 4) |
+         (word & uint64_t{0x000000000fffffff});
+  return word;
+}
+
 template <typename Add>
 const char* ReadPackedVarintArray(const char* ptr, const char* end, Add add) {
+#ifdef PROTOBUF_LITTLE_ENDIAN
+  // Classify a group of bytes at a time and decode every varint that ends in
+  // the group from the positions of its terminating bytes.  A group of single
+  // byte varints, the common case for small values and enums, is emitted
+  // without looking at the bytes one by one.  Decoding a varint that ends in
+  // the group may read up to 8 bytes past the group, hence the extra margin.
+  while (end - ptr >= kVarintGroupWidth + 8) {
+    uint32_t terminators = VarintTerminatorMask(ptr);
+    if (terminators == (uint32_t{1} << kVarintGroupWidth) - 1) {
+      for (int i = 0; i < kVarintGroupWidth; ++i) {
+        add(static_cast<uint8_t>(ptr[i]));
+      }
+      ptr += kVarintGroupWidth;
+      continue;
+    }
+    if (terminators == 0) {
+      // A varint longer than the group; only possible for 8 byte groups.
+      uint64_t varint;
+      ptr = VarintParse(ptr, &varint);
+      if (ptr == nullptr) return nullptr;
+      add(varint);
+      continue;
+    }
+    const char* group = ptr;
+    do {
+      const char* next = group + absl::countr_zero(terminators) + 1;
+      int len = static_cast<int>(next - ptr);
+      if (PROTOBUF_PREDICT_TRUE(len <= 8)) {
+        add(DecodeShortVarint(ptr, len));
+      } else {
+        // Only 16 byte groups get here.  Bits beyond 64 are dropped, as in
+        // VarintParse().
+        if (len > 10) return nullptr;
+        add(DecodeShortVarint(ptr, 8) |
+            DecodeShortVarint(ptr + 8, len - 8) << 56);
+      }
+      ptr = next;
+      terminators &= terminators - 1;
+    } while (terminators != 0);
+  }
+#endif
   while (ptr < end) {
     uint64_t varint;
     ptr = VarintParse(ptr, &varint);
@@ -948,12 +1121,31 @@ const char* ReadPackedVarintArray(const char* ptr, const char* end, Add add) {
   return ptr;
 }
 
-template <typename Add>
-const char* EpsCopyInputStream::ReadPackedVarint(const char* ptr, Add add) {
+// Returns an upper bound on the number of varints starting in [ptr, end). Every
+// varint that ends in the range has exactly one byte without the continuation
+// bit set, and at most one more can start in the range and end past it. The
+// bytes are classified 8 at a time.
+inline int CountVarintsUpperBound(const char* ptr, const char* end) {
+  int count = 1;
+  for (; end - ptr >= 8; ptr += 8) {
+    uint64_t word;
+    std::memcpy(&word, ptr, sizeof(word));
+    count += absl::popcount(~word & uint64_t{0x8080808080808080});
+  }
+  for (; ptr < end; ++ptr) {
+    count += static_cast<uint8_t>(*ptr) < 0x80;
+  }
+  return count;
+}
+
+template <typename Add, typename SizeCb>
+const char* EpsCopyInputStream::ReadPackedVarint(const char* ptr, Add add,
+                                                 SizeCb size_callback) {
   int size = ReadSize(&ptr);
   GOOGLE_PROTOBUF_PARSER_ASSERT(ptr);
   int chunk_size = static_cast<int>(buffer_end_ - ptr);
   while (size > chunk_size) {
+    size_callback(CountVarintsUpperBound(ptr, buffer_end_));
     ptr = ReadPackedVarintArray(ptr, buffer_end_, add);
     if (ptr == nullptr) return nullptr;
     int overrun = static_cast<int>(ptr - buffer_end_);
@@ -966,6 +1158,7 @@ const char* EpsCopyInputStream::ReadPackedVarint(const char* ptr, Add add) {
       std::memcpy(buf, buffer_end_, kSlopBytes);
       GOOGLE_ABSL_CHECK_LE(size - chunk_size, kSlopBytes);
       auto end = buf + (size - chunk_size);
+      size_callback(CountVarintsUpperBound(buf + overrun, end));
       auto res = ReadPackedVarintArray(buf + overrun, end, add);
       if (res == nullptr || res != end) return nullptr;
       return buffer_end_ + (res - buf);
@@ -980,10 +1173,23 @@ const char* EpsCopyInputStream::ReadPackedVarint(const char* ptr, Add add) {
     chunk_size = static_cast<int>(buffer_end_ - ptr);
   }
   auto end = ptr + size;
+  size_callback(CountVarintsUpperBound(ptr, end));
   ptr = ReadPackedVarintArray(ptr, end, add);
   return end == ptr ? ptr : nullptr;
 }
 
+// Called by generated parsers before the run of elements of a repeated message
+// field that starts at `ptr`.  On an arena, creates the elements that are
+// already buffered up front, in a single allocation, so that they are not
+// interleaved with the allocations made while parsing their contents.
+template <uint32_t tag, typename T>
+void PreallocateRepeatedMessages(RepeatedPtrField<T>* field, const char* ptr,
+                                 ParseContext* ctx) {
+  if (field->GetArena() == nullptr || field->ClearedCount() != 0) return;
+  const int count = ctx->CountBufferedFields<tag>(ptr);
+  if (count > 1) field->InternalPreallocate(count);
+}
+
 // Helper for verification of utf8
 PROTOBUF_EXPORT
 bool VerifyUTF8(absl::string_view s, const char* field_name);
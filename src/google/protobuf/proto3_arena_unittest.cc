@@ -37,9 +37,11 @@
 #include <gtest/gtest.h>
 #include "absl/strings/match.h"
 #include "google/protobuf/test_util.h"
+#include "google/protobuf/test_util2.h"
 #include "google/protobuf/unittest.pb.h"
 #include "google/protobuf/unittest_proto3_arena.pb.h"
 #include "google/protobuf/unittest_proto3_optional.pb.h"
+#include "google/protobuf/wire_format.h"
 
 // Must be included last.
 #include "google/protobuf/port_def.inc"
@@ -162,6 +164,48 @@ TEST(Proto3ArenaTest, UnknownFields) {
       arena_message->GetReflection()->GetUnknownFields(*arena_message).empty());
 }
 
+TEST(Proto3ArenaTest, SerializeReverse) {
+  TestAllTypes original;
+  std::string data;
+  // Fields without presence are not serialized when zero.
+  original.set_optional_int32(0);
+  original.set_optional_string("");
+  EXPECT_TRUE(internal::WireFormat::SerializeReverse(original, &data));
+  EXPECT_EQ("", data);
+
+  SetAllFields(&original);
+  original.set_optional_int32(-1);
+  original.add_repeated_int32(-2);
+  EXPECT_TRUE(internal::WireFormat::SerializeReverse(original, &data));
+  EXPECT_EQ(data, original.SerializeAsString());
+
+  Arena arena;
+  TestAllTypes* arena_message = Arena::CreateMessage<TestAllTypes>(&arena);
+  ASSERT_TRUE(arena_message->ParseFromString(data));
+  EXPECT_TRUE(internal::WireFormat::SerializeReverse(*arena_message, &data));
+  EXPECT_EQ(data, original.SerializeAsString());
+}
+
+TEST(Proto3ArenaTest, TcSerializer) {
+  using TestUtil::SerializeWithTcSerializer;
+  TestAllTypes original;
+  // Fields without presence are not serialized when zero, but -0.0 is.
+  original.set_optional_int32(0);
+  original.set_optional_string("");
+  EXPECT_EQ("", SerializeWithTcSerializer(original));
+  original.set_optional_double(-0.0);
+  EXPECT_EQ(original.SerializeAsString(), SerializeWithTcSerializer(original));
+
+  SetAllFields(&original);
+  original.clear_optional_lazy_message();
+  original.clear_optional_unverified_lazy_message();
+  original.clear_optional_lazy_import_message();
+  original.clear_repeated_lazy_message();
+  original.set_optional_int32(-1);
+  original.add_repeated_int32(-2);
+  EXPECT_EQ(original.SerializeAsString(), SerializeWithTcSerializer(original));
+}
+
 TEST(Proto3ArenaTest, GetArena) {
   Arena arena;
 
@@ -565,6 +609,17 @@ TEST(Proto3OptionalTest, BinaryRoundTrip) {
   TestAllFieldsSet(msg2, true);
 }
 
+TEST(Proto3OptionalTest, SerializeReverse) {
+  protobuf_unittest::TestProto3Optional msg;
+  std::string serialized;
+  SetAllFieldsZero(&msg);
+  EXPECT_TRUE(internal::WireFormat::SerializeReverse(msg, &serialized));
+  EXPECT_EQ(serialized, msg.SerializeAsString());
+  SetAllFieldsNonZero(&msg);
+  EXPECT_TRUE(internal::WireFormat::SerializeReverse(msg, &serialized));
+  EXPECT_EQ(serialized, msg.SerializeAsString());
+}
+
 TEST(Proto3OptionalTest, TextFormatRoundTripZeros) {
   protobuf_unittest::TestProto3Optional msg;
   SetAllFieldsZero(&msg);
@@ -0,0 +1,139 @@
+// Protocol Buffers - Google's data interchange format
+// Copyright 2008 Google Inc.  All rights reserved.
+// https://developers.google.com/protocol-buffers/
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Counts the heap allocations made while building, parsing and copying
+// messages whose repeated fields hold only a few elements, which is the common
+// case.  A RepeatedPtrField stores a single element in the field object itself
+// and only allocates an array for the second one, so with one element per
+// field the element is the only allocation; RepeatedField always allocates its
+// array.  Build this at two revisions to compare them.
+//
+// Usage: repeated_field_allocation_benchmark [iterations]
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+#include "google/protobuf/stubs/logging.h"
+#include "google/protobuf/test_messages_proto3.pb.h"
+
+namespace {
+
+std::atomic<int64_t> allocations{0};
+std::atomic<int64_t> allocated_bytes{0};
+
+}  // namespace
+
+void* operator new(size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+  void* p = malloc(size == 0 ? 1 : size);
+  if (p == nullptr) throw std::bad_alloc();
+  return p;
+}
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+namespace google {
+namespace protobuf {
+namespace {
+
+using ::protobuf_test_messages::proto3::TestAllTypesProto3;
+
+// A message with a few scalar fields and `n` elements in each of its string,
+// sub-message and int32 repeated fields.
+TestAllTypesProto3 MakeMessage(int n) {
+  TestAllTypesProto3 message;
+  message.set_optional_int32(42);
+  message.set_optional_string("a string longer than the inline buffer");
+  for (int i = 0; i < n; ++i) {
+    message.add_repeated_string("a string longer than the inline buffer");
+    message.add_repeated_nested_message()->set_a(i);
+    message.add_repeated_foreign_message()->set_c(i);
+    message.add_repeated_int32(i);
+  }
+  return message;
+}
+
+double Seconds(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                       start)
+      .count();
+}
+
+template <typename Op>
+void Measure(const char* name, int iterations, Op op) {
+  const int64_t allocations_before = allocations.load();
+  const int64_t bytes_before = allocated_bytes.load();
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i) op();
+  const double seconds = Seconds(start) / iterations;
+  printf("  %-8s %6.1f allocations %8.1f bytes %8.0f ns\n", name,
+         static_cast<double>(allocations.load() - allocations_before) /
+             iterations,
+         static_cast<double>(allocated_bytes.load() - bytes_before) /
+             iterations,
+         seconds * 1e9);
+}
+
+int Run(int iterations) {
+  for (int n : {0, 1, 2, 4}) {
+    const TestAllTypesProto3 message = MakeMessage(n);
+    const std::string data = message.SerializeAsString();
+    printf("%d element(s) per repeated field, %zu bytes:\n", n, data.size());
+    Measure("build", iterations, [&] {
+      TestAllTypesProto3 built = MakeMessage(n);
+      GOOGLE_ABSL_CHECK_EQ(built.repeated_string_size(), n);
+    });
+    Measure("parse", iterations, [&] {
+      TestAllTypesProto3 parsed;
+      GOOGLE_ABSL_CHECK(parsed.ParseFromString(data));
+    });
+    Measure("copy", iterations, [&] {
+      TestAllTypesProto3 copy(message);
+      GOOGLE_ABSL_CHECK_EQ(copy.repeated_nested_message_size(), n);
+    });
+  }
+  return 0;
+}
+
+}  // namespace
+}  // namespace protobuf
+}  // namespace google
+
+int main(int argc, char* argv[]) {
+  int iterations = argc > 1 ? atoi(argv[1]) : 100000;
+  return google::protobuf::Run(iterations);
+}
@@ -1184,6 +1184,97 @@ TEST(RepeatedPtrField, Small) {
   EXPECT_EQ(field.size(), 0);
 }
 
+TEST(RepeatedPtrField, SingleElementDoesNotAllocateArray) {
+  Arena arena;
+  auto* field = Arena::CreateMessage<RepeatedPtrField<std::string>>(&arena);
+  const size_t initial = arena.SpaceUsed();
+  EXPECT_EQ(field->Capacity(), 1);
+  EXPECT_EQ(field->begin(), field->end());
+
+  field->Add()->assign("foo");
+  // Only the string itself is allocated; its pointer is held in the field.
+  EXPECT_EQ(arena.SpaceUsed() - initial, sizeof(std::string));
+  EXPECT_EQ(field->Capacity(), 1);
+  EXPECT_EQ(field->SpaceUsedExcludingSelf(),
+            internal::StringSpaceUsedExcludingSelfLong(field->Get(0)) +
+                sizeof(std::string));
+  EXPECT_THAT(*field, ElementsAre("foo"));
+
+  // The second element moves both pointers to an array.
+  field->Add()->assign("bar");
+  EXPECT_GT(arena.SpaceUsed() - initial, 2 * sizeof(std::string));
+  EXPECT_GE(field->Capacity(), 2);
+  EXPECT_THAT(*field, ElementsAre("foo", "bar"));
+}
+
+TEST(RepeatedPtrField, SingleElementOperations) {
+  RepeatedPtrField<std::string> field;
+
+  // A cleared element is kept and reused.
+  std::string* foo = field.Add();
+  *foo = "foo";
+  field.RemoveLast();
+  EXPECT_EQ(field.ClearedCount(), 1);
+  EXPECT_EQ(field.Add(), foo);
+  EXPECT_EQ(field.ClearedCount(), 0);
+
+  // Adding an allocated element while one is cleared replaces it.
+  field.RemoveLast();
+  std::string* bar = new std::string("bar");
+  field.AddAllocated(bar);
+  EXPECT_EQ(field.ClearedCount(), 0);
+  EXPECT_EQ(field.Capacity(), 1);
+  EXPECT_THAT(field, ElementsAre("bar"));
+
+  // Releasing the element empties the field.
+  std::string* released = field.ReleaseLast();
+  EXPECT_EQ(released, bar);
+  EXPECT_TRUE(field.empty());
+  EXPECT_EQ(field.ClearedCount(), 0);
+  field.AddAllocated(released);
+
+  // Pointer iterators and data() see the inline element.
+  EXPECT_EQ(*field.pointer_begin(), bar);
+  EXPECT_EQ(field.pointer_end() - field.pointer_begin(), 1);
+  EXPECT_EQ(field.data()[0], bar);
+
+  // Copies, swaps and merges between inline and array representations.
+  RepeatedPtrField<std::string> other;
+  other.Add()->assign("baz");
+  other.Add()->assign("qux");
+  field.Swap(&other);
+  EXPECT_THAT(field, ElementsAre("baz", "qux"));
+  EXPECT_THAT(other, ElementsAre("bar"));
+  other.MergeFrom(field);
+  EXPECT_THAT(other, ElementsAre("bar", "baz", "qux"));
+  RepeatedPtrField<std::string> copy(other);
+  EXPECT_THAT(copy, ElementsAre("bar", "baz", "qux"));
+
+  // Extracting the only element.
+  RepeatedPtrField<std::string> single;
+  single.Add()->assign("one");
+  std::string* extracted;
+  single.ExtractSubrange(0, 1, &extracted);
+  EXPECT_TRUE(single.empty());
+  EXPECT_EQ(single.ClearedCount(), 0);
+  EXPECT_EQ(*extracted, "one");
+  delete extracted;
+  single.Add()->assign("two");
+  single.DeleteSubrange(0, 1);
+  EXPECT_TRUE(single.empty());
+
+#ifndef PROTOBUF_FUTURE_REMOVE_CLEARED_API
+  // Cleared elements can be handed over in either representation.
+  single.AddCleared(new std::string);
+  EXPECT_EQ(single.ClearedCount(), 1);
+  single.AddCleared(new std::string);
+  EXPECT_EQ(single.ClearedCount(), 2);
+  delete single.ReleaseCleared();
+  delete single.ReleaseCleared();
+  EXPECT_EQ(single.ClearedCount(), 0);
+#endif  // !PROTOBUF_FUTURE_REMOVE_CLEARED_API
+}
+
 TEST(RepeatedPtrField, Large) {
   RepeatedPtrField<std::string> field;
 
@@ -1419,6 +1510,9 @@ TEST(RepeatedPtrField, AddAllocated) {
   EXPECT_EQ(0, field.ClearedCount());
   EXPECT_EQ(foo, &field.Get(index));
 
+  // Leave room for the two branches below, which need a free slot.
+  field.Reserve(field.size() + 2);
+
   // Last branch:  Field is not at capacity and there are no cleared objects.
   std::string* bar = new std::string("bar");
   field.AddAllocated(bar);
@@ -1642,6 +1736,7 @@ TEST(RepeatedPtrField, MoveAssign) {
     *source.Add() = "2";
     RepeatedPtrField<std::string> destination;
     *destination.Add() = "3";
+    *destination.Add() = "4";
     const std::string* const* source_data = source.data();
     const std::string* const* destination_data = destination.data();
     destination = std::move(source);
@@ -1650,7 +1745,7 @@ TEST(RepeatedPtrField, MoveAssign) {
     // This property isn't guaranteed but it's useful to have a test that would
     // catch changes in this area.
     EXPECT_EQ(destination_data, source.data());
-    EXPECT_THAT(source, ElementsAre("3"));
+    EXPECT_THAT(source, ElementsAre("3", "4"));
   }
   {
     Arena arena;
@@ -1661,6 +1756,7 @@ TEST(RepeatedPtrField, MoveAssign) {
     RepeatedPtrField<std::string>* destination =
         Arena::CreateMessage<RepeatedPtrField<std::string>>(&arena);
     *destination->Add() = "3";
+    *destination->Add() = "4";
     const std::string* const* source_data = source->data();
     const std::string* const* destination_data = destination->data();
     *destination = std::move(*source);
@@ -1669,7 +1765,7 @@ TEST(RepeatedPtrField, MoveAssign) {
     // This property isn't guaranteed but it's useful to have a test that would
     // catch changes in this area.
     EXPECT_EQ(destination_data, source->data());
-    EXPECT_THAT(*source, ElementsAre("3"));
+    EXPECT_THAT(*source, ElementsAre("3", "4"));
   }
   {
     Arena source_arena;
@@ -50,45 +50,49 @@ namespace internal {
 void** RepeatedPtrFieldBase::InternalExtend(int extend_amount) {
   int new_size = current_size_ + extend_amount;
   if (total_size_ >= new_size) {
-    // N.B.: rep_ is non-nullptr because extend_amount is always > 0, hence
-    // total_size must be non-zero since it is lower-bounded by new_size.
-    return &rep_->elements[current_size_];
+    // N.B.: extend_amount is always > 0, so there is room for at least one
+    // element after current_size_.
+    return elements() + current_size_;
   }
-  Rep* old_rep = rep_;
   Arena* arena = GetOwningArena();
   new_size = internal::CalculateReserveSize<void*, kRepHeaderSize>(total_size_,
                                                                    new_size);
   GOOGLE_ABSL_CHECK_LE(static_cast<int64_t>(new_size),
                 static_cast<int64_t>(
                     (std::numeric_limits<size_t>::max() - kRepHeaderSize) /
-                    sizeof(old_rep->elements[0])))
+                    sizeof(void*)))
       << "Requested size is too large to fit into size_t.";
-  size_t bytes = kRepHeaderSize + sizeof(old_rep->elements[0]) * new_size;
+  size_t bytes = kRepHeaderSize + sizeof(void*) * new_size;
+  Rep* new_rep;
   if (arena == nullptr) {
-    rep_ = reinterpret_cast<Rep*>(::operator new(bytes));
+    new_rep = reinterpret_cast<Rep*>(::operator new(bytes));
   } else {
-    rep_ = reinterpret_cast<Rep*>(Arena::CreateArray<char>(arena, bytes));
+    new_rep = reinterpret_cast<Rep*>(Arena::CreateArray<char>(arena, bytes));
   }
-  const int old_total_size = total_size_;
-  total_size_ = new_size;
-  if (old_rep) {
+  if (using_sso()) {
+    // Move the inline element, if any, to the first slot of the new Rep.
+    new_rep->elements[0] = tagged_rep_or_elem_;
+    new_rep->allocated_size = tagged_rep_or_elem_ != nullptr ? 1 : 0;
+  } else {
+    Rep* old_rep = rep();
     if (old_rep->allocated_size > 0) {
-      memcpy(rep_->elements, old_rep->elements,
-             old_rep->allocated_size * sizeof(rep_->elements[0]));
+      memcpy(new_rep->elements, old_rep->elements,
+             old_rep->allocated_size * sizeof(new_rep->elements[0]));
     }
-    rep_->allocated_size = old_rep->allocated_size;
+    new_rep->allocated_size = old_rep->allocated_size;
 
     const size_t old_size =
-        old_total_size * sizeof(rep_->elements[0]) + kRepHeaderSize;
+        total_size_ * sizeof(new_rep->elements[0]) + kRepHeaderSize;
     if (arena == nullptr) {
       internal::SizedDelete(old_rep, old_size);
     } else {
       arena_->ReturnArrayMemory(old_rep, old_size);
     }
-  } else {
-    rep_->allocated_size = 0;
   }
-  return &rep_->elements[current_size_];
+  tagged_rep_or_elem_ =
+      reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(new_rep) + 1);
+  total_size_ = new_size;
+  return &new_rep->elements[current_size_];
 }
 
 void RepeatedPtrFieldBase::Reserve(int new_size) {
@@ -98,50 +102,69 @@ void RepeatedPtrFieldBase::Reserve(int new_size) {
 }
 
 void RepeatedPtrFieldBase::DestroyProtos() {
-  GOOGLE_ABSL_DCHECK(rep_);
+  GOOGLE_ABSL_DCHECK(tagged_rep_or_elem_ != nullptr);
   GOOGLE_ABSL_DCHECK(arena_ == nullptr);
-  int n = rep_->allocated_size;
-  void* const* elements = rep_->elements;
-  for (int i = 0; i < n; i++) {
-    delete static_cast<MessageLite*>(elements[i]);
+  if (using_sso()) {
+    delete static_cast<MessageLite*>(tagged_rep_or_elem_);
+  } else {
+    Rep* r = rep();
+    int n = r->allocated_size;
+    void* const* elems = r->elements;
+    for (int i = 0; i < n; i++) {
+      delete static_cast<MessageLite*>(elems[i]);
+    }
+    const size_t size = total_size_ * sizeof(elems[0]) + kRepHeaderSize;
+    internal::SizedDelete(r, size);
   }
-  const size_t size = total_size_ * sizeof(elements[0]) + kRepHeaderSize;
-  internal::SizedDelete(rep_, size);
-  rep_ = nullptr;
+  tagged_rep_or_elem_ = nullptr;
 }
 
 void* RepeatedPtrFieldBase::AddOutOfLineHelper(void* obj) {
-  if (!rep_ || rep_->allocated_size == total_size_) {
+  if (allocated_size() == total_size_) {
     InternalExtend(1);  // Equivalent to "Reserve(total_size_ + 1)"
   }
-  ++rep_->allocated_size;
-  rep_->elements[ExchangeCurrentSize(current_size_ + 1)] = obj;
+  if (!using_sso()) ++rep()->allocated_size;
+  elements()[ExchangeCurrentSize(current_size_ + 1)] = obj;
   return obj;
 }
 
+void RepeatedPtrFieldBase::Preallocate(const MessageLite* prototype, int n) {
+  const int allocated = allocated_size();
+  Reserve(allocated + n);
+  void** elems = elements();
+  for (int i = 0; i < n; ++i) {
+    elems[allocated + i] = prototype->New(arena_);
+  }
+  if (!using_sso()) rep()->allocated_size = allocated + n;
+}
+
 void RepeatedPtrFieldBase::CloseGap(int start, int num) {
-  if (rep_ == nullptr) return;
+  if (using_sso()) {
+    // The only element, if any, is the one being removed.
+    if (num > 0) {
+      GOOGLE_ABSL_DCHECK_EQ(start, 0);
+      tagged_rep_or_elem_ = nullptr;
+      ExchangeCurrentSize(current_size_ - num);
+    }
+    return;
+  }
   // Close up a gap of "num" elements starting at offset "start".
-  for (int i = start + num; i < rep_->allocated_size; ++i)
-    rep_->elements[i - num] = rep_->elements[i];
+  Rep* r = rep();
+  for (int i = start + num; i < r->allocated_size; ++i)
+    r->elements[i - num] = r->elements[i];
   ExchangeCurrentSize(current_size_ - num);
-  rep_->allocated_size -= num;
+  r->allocated_size -= num;
 }
 
 MessageLite* RepeatedPtrFieldBase::AddWeak(const MessageLite* prototype) {
-  if (rep_ != nullptr && current_size_ < rep_->allocated_size) {
+  if (current_size_ < allocated_size()) {
     return reinterpret_cast<MessageLite*>(
-        rep_->elements[ExchangeCurrentSize(current_size_ + 1)]);
-  }
-  if (!rep_ || rep_->allocated_size == total_size_) {
-    Reserve(total_size_ + 1);
+        elements()[ExchangeCurrentSize(current_size_ + 1)]);
   }
-  ++rep_->allocated_size;
   MessageLite* result = prototype
                             ? prototype->New(arena_)
                             : Arena::CreateMessage<ImplicitWeakMessage>(arena_);
-  rep_->elements[ExchangeCurrentSize(current_size_ + 1)] = result;
-  return result;
+  return reinterpret_cast<MessageLite*>(AddOutOfLineHelper(result));
 }
 
 }  // namespace internal
@@ -84,6 +84,7 @@ struct ArenaBlock {
 
 enum class AllocationClient { kDefault, kArray };
 
+class SerialArena;
 class ThreadSafeArena;
 
 // Tag type used to invoke the constructor of the first SerialArena.
@@ -91,6 +92,16 @@ struct FirstSerialArena {
   explicit FirstSerialArena() = default;
 };
 
+// Allocation state of one SerialArena, saved by ThreadSafeArena::Checkpoint().
+struct ArenaCheckpoint {
+  uint64_t lifecycle_id = 0;
+  SerialArena* serial = nullptr;
+  ArenaBlock* head = nullptr;
+  char* ptr = nullptr;
+  char* limit = nullptr;
+  size_t space_used = 0;
+};
+
 // A simple arena allocator. Calls to allocate functions must be properly
 // serialized by the caller, hence this class cannot be used as a general
 // purpose allocator in a multi-threaded program. It serves as a building block
@@ -319,6 +330,12 @@ class PROTOBUF_EXPORT SerialArena {
   template <typename Deallocator>
   Memory Free(Deallocator deallocator);
 
+  // Saves the current allocation state. RewindTo() runs the cleanups
+  // registered since then and returns ptr_ and limit_ to where they were; the
+  // blocks allocated in between are kept in `spare_blocks_`.
+  ArenaCheckpoint Checkpoint();
+  void RewindTo(const ArenaCheckpoint& checkpoint);
+
   // Members are declared here to track sizeof(SerialArena) and hotness
   // centrally. They are (roughly) laid out in descending order of hotness.
 
@@ -348,6 +365,10 @@ class PROTOBUF_EXPORT SerialArena {
   uint8_t cached_block_length_ = 0;
   CachedBlock** cached_blocks_ = nullptr;
 
+  // Blocks discarded by RewindTo(), smallest first. AllocateNewBlock() takes
+  // the first one if it is large enough; the rest are freed with the arena.
+  ArenaBlock* spare_blocks_ = nullptr;
+
   // Helper getters/setters to handle relaxed operations on atomic variables.
   ArenaBlock* head() { return head_.load(std::memory_order_relaxed); }
   const ArenaBlock* head() const {
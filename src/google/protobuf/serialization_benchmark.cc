@@ -0,0 +1,302 @@
+// Protocol Buffers - Google's data interchange format
+// Copyright 2008 Google Inc.  All rights reserved.
+// https://developers.google.com/protocol-buffers/
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Compares the ways of serializing a message to a string: SerializeToString(),
+// which sizes the message with ByteSizeLong() before writing it,
+// SerializeToStringWithFlatSizes(), and the experimental single-pass
+// back-to-front WireFormat::SerializeReverse().  The messages are a flat
+// TestAllTypesProto3, one holding many small sub-messages, and a deep chain of
+// recursive_message.
+//
+// It then compares the code generated by default with the code generated with
+// experimental_table_driven_serialization, whose _InternalSerialize() hands
+// every level of the message to TcSerializer.  The messages of
+// unittest_table_driven.proto are serialized next to their unittest.proto
+// counterparts.  Serializing one type over and over keeps its code hot;
+// cycling through all of them shows the cost of each type bringing its own
+// code into the instruction cache, which TcSerializer shares between types.
+// Run it under `perf stat -e L1-icache-load-misses` to count the misses
+// directly.
+//
+// Usage: serialization_benchmark [iterations]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "google/protobuf/descriptor.pb.h"
+#include "google/protobuf/descriptor.h"
+#include "google/protobuf/message.h"
+#include "google/protobuf/stubs/logging.h"
+#include "google/protobuf/test_messages_proto3.pb.h"
+#include "google/protobuf/unittest.pb.h"
+#include "google/protobuf/unittest_table_driven.pb.h"
+#include "google/protobuf/wire_format.h"
+
+namespace google {
+namespace protobuf {
+namespace {
+
+using ::protobuf_test_messages::proto3::TestAllTypesProto3;
+
+struct Method {
+  const char* name;
+  std::function<bool(const Message&, std::string*)> serialize;
+};
+
+void SetScalars(TestAllTypesProto3* message, int i) {
+  message->set_optional_int32(i * 37);
+  message->set_optional_int64(-int64_t{i} << 20);
+  message->set_optional_uint32(i);
+  message->set_optional_sint32(-i);
+  message->set_optional_fixed64(i * 1000003);
+  message->set_optional_double(i / 3.0);
+  message->set_optional_bool(i % 2);
+  message->set_optional_string("request " + std::to_string(i));
+  message->set_optional_bytes(std::string(i % 16, 'x'));
+  message->set_optional_nested_enum(TestAllTypesProto3::BAR);
+  for (int j = 0; j < 8; ++j) {
+    message->add_repeated_int32(i + j);
+    message->add_repeated_double(j * 0.5);
+  }
+}
+
+TestAllTypesProto3 MakeFlat() {
+  TestAllTypesProto3 message;
+  SetScalars(&message, 12345);
+  message.mutable_optional_nested_message()->set_a(7);
+  return message;
+}
+
+TestAllTypesProto3 MakeWide() {
+  TestAllTypesProto3 message;
+  SetScalars(&message, 1);
+  for (int i = 0; i < 200; ++i) {
+    message.add_repeated_nested_message()->set_a(i);
+    message.add_repeated_foreign_message()->set_c(i);
+  }
+  return message;
+}
+
+TestAllTypesProto3 MakeDeep(int depth) {
+  TestAllTypesProto3 message;
+  TestAllTypesProto3* level = &message;
+  for (int i = 0; i < depth; ++i) {
+    SetScalars(level, i);
+    level = level->mutable_recursive_message();
+  }
+  return message;
+}
+
+double Seconds(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                       start)
+      .count();
+}
+
+void Benchmark(const char* name, const TestAllTypesProto3& message,
+               const std::vector<Method>& methods, int iterations) {
+  const std::string expected = message.SerializeAsString();
+  printf("%s: %zu bytes\n", name, expected.size());
+  for (const Method& method : methods) {
+    std::string data;
+    GOOGLE_ABSL_CHECK(method.serialize(message, &data));
+    GOOGLE_ABSL_CHECK(data == expected) << method.name;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) method.serialize(message, &data);
+    double seconds = Seconds(start) / iterations;
+    printf("  %-32s %10.0f ns %8.1f MB/s\n", method.name, seconds * 1e9,
+           expected.size() / seconds / 1e6);
+  }
+}
+
+// Returns the message type of unittest.proto or unittest_import.proto that
+// `descriptor`, from unittest_table_driven.proto, mirrors.
+const Descriptor* FindMirroredType(const Descriptor* descriptor) {
+  const std::string name = descriptor->full_name().substr(
+      descriptor->file()->package().size());
+  const Descriptor* mirrored =
+      DescriptorPool::generated_pool()->FindMessageTypeByName(
+          "protobuf_unittest" + name);
+  if (mirrored == nullptr) {
+    mirrored = DescriptorPool::generated_pool()->FindMessageTypeByName(
+        "protobuf_unittest_import" + name);
+  }
+  GOOGLE_ABSL_CHECK(mirrored != nullptr) << descriptor->full_name();
+  return mirrored;
+}
+
+void CollectTypes(const Descriptor* descriptor,
+                  std::vector<const Descriptor*>* types) {
+  types->push_back(descriptor);
+  for (int i = 0; i < descriptor->nested_type_count(); ++i) {
+    CollectTypes(descriptor->nested_type(i), types);
+  }
+}
+
+// Sets every field of `message`, taking only the first member of each oneof
+// and recursing `depth` levels into sub-messages.
+void Populate(Message* message, int depth) {
+  const Descriptor* descriptor = message->GetDescriptor();
+  const Reflection* reflection = message->GetReflection();
+  for (int i = 0; i < descriptor->field_count(); ++i) {
+    const FieldDescriptor* field = descriptor->field(i);
+    const OneofDescriptor* oneof = field->real_containing_oneof();
+    if (oneof != nullptr && oneof->field(0) != field) continue;
+    const int count = field->is_repeated() ? 3 : 1;
+    for (int j = 0; j < count; ++j) {
+      const int value = (i + 1) * 37 + j;
+      const bool add = field->is_repeated();
+      switch (field->cpp_type()) {
+#define SET(CPPTYPE, METHOD, VALUE)                             \
+  case FieldDescriptor::CPPTYPE_##CPPTYPE:                      \
+    if (add) {                                                  \
+      reflection->Add##METHOD(message, field, VALUE);           \
+    } else {                                                    \
+      reflection->Set##METHOD(message, field, VALUE);           \
+    }                                                           \
+    break;
+        SET(INT32, Int32, -value)
+        SET(INT64, Int64, -int64_t{value} << 20)
+        SET(UINT32, UInt32, static_cast<uint32_t>(value))
+        SET(UINT64, UInt64, uint64_t{static_cast<uint32_t>(value)} << 20)
+        SET(FLOAT, Float, value / 3.0f)
+        SET(DOUBLE, Double, value / 3.0)
+        SET(BOOL, Bool, true)
+        SET(STRING, String, "value " + std::to_string(value))
+        SET(ENUM, Enum,
+            field->enum_type()->value(field->enum_type()->value_count() - 1))
+#undef SET
+        case FieldDescriptor::CPPTYPE_MESSAGE:
+          if (depth > 0) {
+            Populate(add ? reflection->AddMessage(message, field)
+                         : reflection->MutableMessage(message, field),
+                     depth - 1);
+          }
+          break;
+      }
+    }
+  }
+}
+
+void BenchmarkManyTypes(int iterations) {
+  std::vector<const Descriptor*> types;
+  const FileDescriptor* file =
+      protobuf_unittest_table_driven::TestAllTypes::descriptor()->file();
+  for (int i = 0; i < file->message_type_count(); ++i) {
+    CollectTypes(file->message_type(i), &types);
+  }
+  // The same contents in the types generated both ways.
+  std::vector<std::unique_ptr<Message>> generated;
+  std::vector<std::unique_ptr<Message>> table_driven;
+  size_t total_size = 0;
+  for (const Descriptor* type : types) {
+    MessageFactory* factory = MessageFactory::generated_factory();
+    table_driven.emplace_back(factory->GetPrototype(type)->New());
+    Populate(table_driven.back().get(), 1);
+    generated.emplace_back(
+        factory->GetPrototype(FindMirroredType(type))->New());
+    GOOGLE_ABSL_CHECK(generated.back()->ParsePartialFromString(
+        table_driven.back()->SerializePartialAsString()));
+    total_size += generated.back()->ByteSizeLong();
+  }
+  printf("many types: %zu types, %zu bytes\n", types.size(), total_size);
+
+  const std::vector<
+      std::pair<const char*, const std::vector<std::unique_ptr<Message>>*>>
+      methods = {
+          {"generated", &generated},
+          {"table_driven_serialization", &table_driven},
+      };
+  for (const auto& method : methods) {
+    const std::vector<std::unique_ptr<Message>>& messages = *method.second;
+    std::string data;
+    for (size_t i = 0; i < messages.size(); ++i) {
+      GOOGLE_ABSL_CHECK(messages[i]->SerializePartialToString(&data));
+      GOOGLE_ABSL_CHECK(data == generated[i]->SerializePartialAsString())
+          << method.first << " " << messages[i]->GetTypeName();
+    }
+    // The same type over and over.
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& message : messages) {
+      for (int i = 0; i < iterations; ++i) {
+        message->SerializePartialToString(&data);
+      }
+    }
+    const double hot = Seconds(start) / iterations;
+    // Every type in turn.
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+      for (const auto& message : messages) {
+        message->SerializePartialToString(&data);
+      }
+    }
+    const double cold = Seconds(start) / iterations;
+    printf("  %-32s hot %8.0f ns %8.1f MB/s   cycling %8.0f ns %8.1f MB/s\n",
+           method.first, hot / messages.size() * 1e9, total_size / hot / 1e6,
+           cold / messages.size() * 1e9, total_size / cold / 1e6);
+  }
+}
+
+int Run(int iterations) {
+  const std::vector<Method> methods = {
+      {"SerializeToString",
+       [](const Message& m, std::string* s) {
+         return m.SerializeToString(s);
+       }},
+      {"SerializeToStringWithFlatSizes",
+       [](const Message& m, std::string* s) {
+         return m.SerializeToStringWithFlatSizes(s);
+       }},
+      {"WireFormat::SerializeReverse",
+       [](const Message& m, std::string* s) {
+         return internal::WireFormat::SerializeReverse(m, s);
+       }},
+  };
+  Benchmark("flat", MakeFlat(), methods, iterations);
+  Benchmark("wide", MakeWide(), methods, iterations / 100 + 1);
+  Benchmark("deep (depth 50)", MakeDeep(50), methods, iterations / 50 + 1);
+  BenchmarkManyTypes(iterations / 100 + 1);
+  return 0;
+}
+
+}  // namespace
+}  // namespace protobuf
+}  // namespace google
+
+int main(int argc, char* argv[]) {
+  int iterations = argc > 1 ? atoi(argv[1]) : 100000;
+  return google::protobuf::Run(iterations);
+}
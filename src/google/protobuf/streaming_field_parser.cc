@@ -0,0 +1,105 @@
+// Protocol Buffers - Google's data interchange format
+// Copyright 2008 Google Inc.  All rights reserved.
+// https://developers.google.com/protocol-buffers/
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "google/protobuf/streaming_field_parser.h"
+
+#include "google/protobuf/io/coded_stream.h"
+#include "google/protobuf/wire_format_lite.h"
+
+// Must be included last.
+#include "google/protobuf/port_def.inc"
+
+namespace google {
+namespace protobuf {
+
+using internal::WireFormatLite;
+
+StreamingFieldParser::StreamingFieldParser(io::ZeroCopyInputStream* input,
+                                           int field_number,
+                                           MessageLite* other_fields)
+    : ctx_(io::CodedInputStream::GetDefaultRecursionLimit(),
+           /*aliasing=*/false, &ptr_, input),
+      message_tag_(WireFormatLite::MakeTag(
+          field_number, WireFormatLite::WIRETYPE_LENGTH_DELIMITED)),
+      group_tag_(WireFormatLite::MakeTag(field_number,
+                                         WireFormatLite::WIRETYPE_START_GROUP)),
+      other_fields_(other_fields) {}
+
+bool StreamingFieldParser::Fail() {
+  done_ = true;
+  failed_ = true;
+  return false;
+}
+
+bool StreamingFieldParser::Next(MessageLite* element) {
+  if (done_) return false;
+  // This is the parse loop of a generated message, except that it returns
+  // after each element of the streamed field.
+  while (!ctx_.Done(&ptr_)) {
+    uint32_t tag;
+    ptr_ = internal::ReadTag(ptr_, &tag);
+    // A zero or end-group tag ends a message, which at the top level of the
+    // stream is an error, as it is for ParseFromZeroCopyStream().
+    if (ptr_ == nullptr || tag == 0 ||
+        WireFormatLite::GetTagWireType(tag) ==
+            WireFormatLite::WIRETYPE_END_GROUP) {
+      return Fail();
+    }
+    if (tag == message_tag_ || tag == group_tag_) {
+      element->Clear();
+      ptr_ = tag == message_tag_ ? ctx_.ParseMessage(element, ptr_)
+                                 : ctx_.ParseGroup(element, ptr_, tag);
+      if (ptr_ == nullptr) return Fail();
+      return true;
+    }
+    if (other_fields_ == nullptr) {
+      ptr_ = internal::UnknownFieldParse(tag, nullptr, ptr_, &ctx_);
+      if (ptr_ == nullptr) return Fail();
+      continue;
+    }
+    // Parsing concatenated serializations is the same as merging them, so
+    // the fields can be merged one by one in the order they come.
+    field_.clear();
+    ptr_ = internal::UnknownFieldParse(tag, &field_, ptr_, &ctx_);
+    if (ptr_ == nullptr ||
+        !other_fields_->ParseFrom<MessageLite::kMergePartial>(field_)) {
+      return Fail();
+    }
+  }
+  // Done() clears ptr_ if the last field ran past the end of the input.
+  if (ptr_ == nullptr || !ctx_.EndedAtEndOfStream()) return Fail();
+  done_ = true;
+  return false;
+}
+
+}  // namespace protobuf
+}  // namespace google
+
+#include "google/protobuf/port_undef.inc"
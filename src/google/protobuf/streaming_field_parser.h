@@ -0,0 +1,117 @@
+// Protocol Buffers - Google's data interchange format
+// Copyright 2008 Google Inc.  All rights reserved.
+// https://developers.google.com/protocol-buffers/
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// This file contains a parser that reads the elements of a repeated message
+// field one at a time, so that messages too large to hold in memory can be
+// processed.
+
+#ifndef GOOGLE_PROTOBUF_STREAMING_FIELD_PARSER_H__
+#define GOOGLE_PROTOBUF_STREAMING_FIELD_PARSER_H__
+
+#include <cstdint>
+#include <string>
+
+#include "google/protobuf/io/zero_copy_stream.h"
+#include "google/protobuf/message_lite.h"
+#include "google/protobuf/parse_context.h"
+
+// Must be included last.
+#include "google/protobuf/port_def.inc"
+
+namespace google {
+namespace protobuf {
+
+// Parses a serialized message from a stream, handing out the elements of one
+// of its repeated message fields one at a time instead of building the whole
+// message in memory.  Only one element is held at a time, so a message with
+// any number of elements is processed in constant memory.  For example, for a
+// file holding one message with a `repeated Record records = 1` field:
+//
+//   io::FileInputStream input(fd);
+//   Archive header;  // Receives every field except records.
+//   StreamingFieldParser parser(&input, Archive::kRecordsFieldNumber,
+//                               &header);
+//   Record record;
+//   while (parser.Next(&record)) {
+//     Process(record);
+//   }
+//   if (parser.failed()) {
+//     // Handle the parse error.
+//   }
+//
+// The other top-level fields may come before, between or after the elements;
+// each is merged into the `other_fields` message as it is reached, so fields
+// that follow the last element are only there once Next() has returned false.
+// Like ParsePartialFromZeroCopyStream(), this does not check that required
+// fields are set.
+class PROTOBUF_EXPORT StreamingFieldParser {
+ public:
+  // Reads from `input`, which must outlive the parser, the serialization of a
+  // message whose field `field_number` is a repeated message or group field.
+  // The other fields of the message are merged into `other_fields`, or
+  // skipped if it is null.
+  StreamingFieldParser(io::ZeroCopyInputStream* input, int field_number,
+                       MessageLite* other_fields = nullptr);
+  StreamingFieldParser(const StreamingFieldParser&) = delete;
+  StreamingFieldParser& operator=(const StreamingFieldParser&) = delete;
+
+  // Clears `element` and parses the next element of the field into it.
+  // Returns false once the input is exhausted, or on a parse error.  Passing
+  // the same message to every call lets each element reuse the memory
+  // allocated by the previous ones; this also holds for a message allocated
+  // on an arena, which then stops growing once it has seen the largest
+  // element.
+  bool Next(MessageLite* element);
+
+  // Returns true if Next() returned false because of a parse error rather
+  // than at the end of the input.
+  bool failed() const { return failed_; }
+
+ private:
+  bool Fail();
+
+  // Must be declared before ctx_, which initializes it.
+  const char* ptr_;
+  internal::ParseContext ctx_;
+  const uint32_t message_tag_;
+  const uint32_t group_tag_;
+  MessageLite* const other_fields_;
+  // Holds each of the other fields while it is merged into other_fields_.
+  std::string field_;
+  bool done_ = false;
+  bool failed_ = false;
+};
+
+}  // namespace protobuf
+}  // namespace google
+
+#include "google/protobuf/port_undef.inc"
+
+#endif  // GOOGLE_PROTOBUF_STREAMING_FIELD_PARSER_H__
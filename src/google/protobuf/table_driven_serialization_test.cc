@@ -0,0 +1,173 @@
+// Protocol Buffers - Google's data interchange format
+// Copyright 2008 Google Inc.  All rights reserved.
+// https://developers.google.com/protocol-buffers/
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Tests code generated with experimental_table_driven_serialization, whose
+// _InternalSerialize() calls TcSerializer, against the code generated by
+// default.  unittest_table_driven.proto mirrors messages of unittest.proto, so
+// the same bytes parse into both; each must then serialize them identically.
+
+#include <limits>
+#include <string>
+
+#include <gtest/gtest.h>
+#include "google/protobuf/test_util.h"
+#include "google/protobuf/unittest.pb.h"
+#include "google/protobuf/unittest_table_driven.pb.h"
+
+namespace google {
+namespace protobuf {
+namespace {
+
+namespace table_driven = ::protobuf_unittest_table_driven;
+
+// Parses `data` into a message generated by default and into its table-driven
+// mirror, and expects both to serialize it the same way.
+template <typename Default, typename TableDriven>
+void ExpectSameSerialization(const std::string& data) {
+  Default expected;
+  ASSERT_TRUE(expected.ParseFromString(data));
+  TableDriven actual;
+  ASSERT_TRUE(actual.ParseFromString(data));
+  EXPECT_EQ(expected.ByteSizeLong(), actual.ByteSizeLong());
+  EXPECT_EQ(expected.SerializeAsString(), actual.SerializeAsString());
+}
+
+TEST(TableDrivenSerializationTest, Empty) {
+  ExpectSameSerialization<unittest::TestAllTypes, table_driven::TestAllTypes>(
+      "");
+  EXPECT_EQ("", table_driven::TestAllTypes().SerializeAsString());
+}
+
+TEST(TableDrivenSerializationTest, AllFields) {
+  unittest::TestAllTypes message;
+  TestUtil::SetAllFields(&message);
+  const std::string data = message.SerializeAsString();
+  ExpectSameSerialization<unittest::TestAllTypes, table_driven::TestAllTypes>(
+      data);
+
+  table_driven::TestAllTypes table_driven_message;
+  ASSERT_TRUE(table_driven_message.ParseFromString(data));
+  EXPECT_EQ(data, table_driven_message.SerializeAsString());
+
+  TestUtil::ModifyRepeatedFields(&message);
+  ExpectSameSerialization<unittest::TestAllTypes, table_driven::TestAllTypes>(
+      message.SerializeAsString());
+}
+
+TEST(TableDrivenSerializationTest, EdgeValues) {
+  unittest::TestAllTypes message;
+  // Negative varints take ten bytes, zero fields with presence are still
+  // written, and so is -0.0.
+  message.set_optional_int32(-1);
+  message.set_optional_int64(0);
+  message.set_optional_sint32(-2);
+  message.set_optional_sint64(std::numeric_limits<int64_t>::min());
+  message.set_optional_uint64(std::numeric_limits<uint64_t>::max());
+  message.set_optional_double(-0.0);
+  message.set_optional_bool(false);
+  message.set_optional_string("");
+  message.set_optional_nested_enum(unittest::TestAllTypes::NEG);
+  message.mutable_optional_nested_message();
+  message.add_repeated_int32(-1);
+  message.add_repeated_nested_enum(unittest::TestAllTypes::NEG);
+  message.add_repeated_nested_message();
+  message.add_repeatedgroup();
+  message.set_optional_bytes(std::string(300, '\0'));
+  ExpectSameSerialization<unittest::TestAllTypes, table_driven::TestAllTypes>(
+      message.SerializeAsString());
+}
+
+TEST(TableDrivenSerializationTest, Oneof) {
+  unittest::TestAllTypes message;
+  message.set_oneof_uint32(0);
+  ExpectSameSerialization<unittest::TestAllTypes, table_driven::TestAllTypes>(
+      message.SerializeAsString());
+  message.mutable_oneof_nested_message()->set_bb(1);
+  ExpectSameSerialization<unittest::TestAllTypes, table_driven::TestAllTypes>(
+      message.SerializeAsString());
+  message.set_oneof_string("string");
+  ExpectSameSerialization<unittest::TestAllTypes, table_driven::TestAllTypes>(
+      message.SerializeAsString());
+  message.set_oneof_bytes("bytes");
+  ExpectSameSerialization<unittest::TestAllTypes, table_driven::TestAllTypes>(
+      message.SerializeAsString());
+}
+
+TEST(TableDrivenSerializationTest, PackedFields) {
+  unittest::TestPackedTypes message;
+  TestUtil::SetPackedFields(&message);
+  ExpectSameSerialization<unittest::TestPackedTypes,
+                          table_driven::TestPackedTypes>(
+      message.SerializeAsString());
+}
+
+TEST(TableDrivenSerializationTest, Extensions) {
+  unittest::TestAllExtensions message;
+  message.SetExtension(unittest::optional_int32_extension, 101);
+  message.SetExtension(unittest::optional_string_extension, "115");
+  message.MutableExtension(unittest::optional_nested_message_extension)
+      ->set_bb(118);
+  message.AddExtension(unittest::repeated_int32_extension, 201);
+  message.AddExtension(unittest::repeated_int32_extension, -301);
+  const std::string data = message.SerializeAsString();
+  ExpectSameSerialization<unittest::TestAllExtensions,
+                          table_driven::TestAllExtensions>(data);
+
+  table_driven::TestAllExtensions table_driven_message;
+  ASSERT_TRUE(table_driven_message.ParseFromString(data));
+  EXPECT_EQ(101, table_driven_message.GetExtension(
+                     table_driven::optional_int32_extension));
+}
+
+TEST(TableDrivenSerializationTest, UnknownFields) {
+  // ForeignMessage keeps all but the first two fields of TestAllTypes as
+  // unknown fields, and writes them after its own.
+  unittest::TestAllTypes message;
+  TestUtil::SetAllFields(&message);
+  ExpectSameSerialization<unittest::ForeignMessage,
+                          table_driven::ForeignMessage>(
+      message.SerializeAsString());
+}
+
+TEST(TableDrivenSerializationTest, Deep) {
+  unittest::TestRecursiveMessage message;
+  unittest::TestRecursiveMessage* leaf = &message;
+  for (int i = 0; i < 90; ++i) {
+    leaf->set_i(i);
+    leaf = leaf->mutable_a();
+  }
+  ExpectSameSerialization<unittest::TestRecursiveMessage,
+                          table_driven::TestRecursiveMessage>(
+      message.SerializeAsString());
+}
+
+}  // namespace
+}  // namespace protobuf
+}  // namespace google
@@ -37,9 +37,13 @@
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "absl/strings/strip.h"
+#include "google/protobuf/generated_message_tctable_serializer.h"
+#include "google/protobuf/io/coded_stream.h"
 #include "google/protobuf/io/zero_copy_stream.h"
 #include "google/protobuf/io/zero_copy_stream_impl_lite.h"
+#include "google/protobuf/message.h"
 #include "google/protobuf/util/message_differencer.h"
+#include "google/protobuf/wire_format.h"
 
 namespace google {
 namespace protobuf {
@@ -83,6 +87,20 @@ bool EqualsToSerialized(const ProtoType& message, const std::string& data) {
   return util::MessageDifferencer::Equals(message, other);
 }
 
+// Serializes "message" with TcSerializer walking the table built by
+// reflection, as _InternalSerialize() does for messages generated with
+// experimental_table_driven_serialization.
+inline std::string SerializeWithTcSerializer(const Message& message) {
+  std::string data(message.ByteSizeLong(), '\0');
+  uint8_t* start = reinterpret_cast<uint8_t*>(&data[0]);
+  io::EpsCopyOutputStream stream(start, static_cast<int>(data.size()),
+                                 /*deterministic=*/false);
+  uint8_t* end = internal::TcSerializer::SerializeFields(
+      message, internal::WireFormat::GetTcParseTable(message), start, &stream);
+  EXPECT_EQ(data.size(), end - start);
+  return data;
+}
+
 // Wraps io::ArrayInputStream while checking against bound. When a blocking
 // stream is used with bounded length, proto parsing must not access beyond the
 // bound. Otherwise, it can result in unintended block, then deadlock.
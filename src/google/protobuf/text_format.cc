@@ -42,6 +42,7 @@
 #include <climits>
 #include <cmath>
 #include <limits>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -2332,129 +2333,66 @@ class MapEntryMessageComparator {
 };
 
 namespace internal {
+// Hands out the entries of a map field sorted by key.  DynamicMapSorter::Sort
+// cannot be used because it enforces syncing with repeated field.
 class MapFieldPrinterHelper {
  public:
-  // DynamicMapSorter::Sort cannot be used because it enforces syncing with
-  // repeated field.
-  static bool SortMap(const Message& message, const Reflection* reflection,
-                      const FieldDescriptor* field,
-                      std::vector<const Message*>* sorted_map_field);
-  static void CopyKey(const MapKey& key, Message* message,
-                      const FieldDescriptor* field_desc);
-  static void CopyValue(const MapValueRef& value, Message* message,
-                        const FieldDescriptor* field_desc);
+  MapFieldPrinterHelper(const Message& message, const Reflection* reflection,
+                        const FieldDescriptor* field);
+
+  // Returns the entry with the index-th smallest key, which is only valid
+  // until the next call.
+  const Message& Entry(int index);
+
+ private:
+  using Element = std::pair<MapKey, MapValueConstRef>;
+
+  // The entry messages of the repeated field, if it is up to date.
+  std::vector<const Message*> sorted_entries_;
+  // Otherwise the elements of the map, presented one at a time through
+  // entry_view_, so that printing never builds the repeated field.
+  std::vector<Element> elements_;
+  std::vector<const Element*> sorted_elements_;
+  std::unique_ptr<MapEntryView> entry_view_;
 };
 
-// Returns true if elements contained in sorted_map_field need to be released.
-bool MapFieldPrinterHelper::SortMap(
-    const Message& message, const Reflection* reflection,
-    const FieldDescriptor* field,
-    std::vector<const Message*>* sorted_map_field) {
-  bool need_release = false;
+MapFieldPrinterHelper::MapFieldPrinterHelper(const Message& message,
+                                             const Reflection* reflection,
+                                             const FieldDescriptor* field) {
   const MapFieldBase& base = *reflection->GetMapData(message, field);
 
   if (base.IsRepeatedFieldValid()) {
     const RepeatedPtrField<Message>& map_field =
         reflection->GetRepeatedPtrFieldInternal<Message>(message, field);
-    for (int i = 0; i < map_field.size(); ++i) {
-      sorted_map_field->push_back(
-          const_cast<RepeatedPtrField<Message>*>(&map_field)->Mutable(i));
-    }
-  } else {
-    // TODO(teboring): For performance, instead of creating map entry message
-    // for each element, just store map keys and sort them.
-    const Descriptor* map_entry_desc = field->message_type();
-    const Message* prototype =
-        reflection->GetMessageFactory()->GetPrototype(map_entry_desc);
-    for (MapIterator iter =
-             reflection->MapBegin(const_cast<Message*>(&message), field);
-         iter != reflection->MapEnd(const_cast<Message*>(&message), field);
-         ++iter) {
-      Message* map_entry_message = prototype->New();
-      CopyKey(iter.GetKey(), map_entry_message, map_entry_desc->field(0));
-      CopyValue(iter.GetValueRef(), map_entry_message,
-                map_entry_desc->field(1));
-      sorted_map_field->push_back(map_entry_message);
-    }
-    need_release = true;
-  }
-
-  MapEntryMessageComparator comparator(field->message_type());
-  std::stable_sort(sorted_map_field->begin(), sorted_map_field->end(),
-                   comparator);
-  return need_release;
-}
-
-void MapFieldPrinterHelper::CopyKey(const MapKey& key, Message* message,
-                                    const FieldDescriptor* field_desc) {
-  const Reflection* reflection = message->GetReflection();
-  switch (field_desc->cpp_type()) {
-    case FieldDescriptor::CPPTYPE_DOUBLE:
-    case FieldDescriptor::CPPTYPE_FLOAT:
-    case FieldDescriptor::CPPTYPE_ENUM:
-    case FieldDescriptor::CPPTYPE_MESSAGE:
-      GOOGLE_ABSL_LOG(ERROR) << "Not supported.";
-      break;
-    case FieldDescriptor::CPPTYPE_STRING:
-      reflection->SetString(message, field_desc, key.GetStringValue());
-      return;
-    case FieldDescriptor::CPPTYPE_INT64:
-      reflection->SetInt64(message, field_desc, key.GetInt64Value());
-      return;
-    case FieldDescriptor::CPPTYPE_INT32:
-      reflection->SetInt32(message, field_desc, key.GetInt32Value());
-      return;
-    case FieldDescriptor::CPPTYPE_UINT64:
-      reflection->SetUInt64(message, field_desc, key.GetUInt64Value());
-      return;
-    case FieldDescriptor::CPPTYPE_UINT32:
-      reflection->SetUInt32(message, field_desc, key.GetUInt32Value());
-      return;
-    case FieldDescriptor::CPPTYPE_BOOL:
-      reflection->SetBool(message, field_desc, key.GetBoolValue());
-      return;
+    sorted_entries_.assign(map_field.pointer_begin(), map_field.pointer_end());
+    MapEntryMessageComparator comparator(field->message_type());
+    std::stable_sort(sorted_entries_.begin(), sorted_entries_.end(),
+                     comparator);
+    return;
   }
-}
 
-void MapFieldPrinterHelper::CopyValue(const MapValueRef& value,
-                                      Message* message,
-                                      const FieldDescriptor* field_desc) {
-  const Reflection* reflection = message->GetReflection();
-  switch (field_desc->cpp_type()) {
-    case FieldDescriptor::CPPTYPE_DOUBLE:
-      reflection->SetDouble(message, field_desc, value.GetDoubleValue());
-      return;
-    case FieldDescriptor::CPPTYPE_FLOAT:
-      reflection->SetFloat(message, field_desc, value.GetFloatValue());
-      return;
-    case FieldDescriptor::CPPTYPE_ENUM:
-      reflection->SetEnumValue(message, field_desc, value.GetEnumValue());
-      return;
-    case FieldDescriptor::CPPTYPE_MESSAGE: {
-      Message* sub_message = value.GetMessageValue().New();
-      sub_message->CopyFrom(value.GetMessageValue());
-      reflection->SetAllocatedMessage(message, sub_message, field_desc);
-      return;
-    }
-    case FieldDescriptor::CPPTYPE_STRING:
-      reflection->SetString(message, field_desc, value.GetStringValue());
-      return;
-    case FieldDescriptor::CPPTYPE_INT64:
-      reflection->SetInt64(message, field_desc, value.GetInt64Value());
-      return;
-    case FieldDescriptor::CPPTYPE_INT32:
-      reflection->SetInt32(message, field_desc, value.GetInt32Value());
-      return;
-    case FieldDescriptor::CPPTYPE_UINT64:
-      reflection->SetUInt64(message, field_desc, value.GetUInt64Value());
-      return;
-    case FieldDescriptor::CPPTYPE_UINT32:
-      reflection->SetUInt32(message, field_desc, value.GetUInt32Value());
-      return;
-    case FieldDescriptor::CPPTYPE_BOOL:
-      reflection->SetBool(message, field_desc, value.GetBoolValue());
-      return;
+  elements_.reserve(reflection->MapSize(message, field));
+  for (MapIterator iter =
+           reflection->MapBegin(const_cast<Message*>(&message), field);
+       iter != reflection->MapEnd(const_cast<Message*>(&message), field);
+       ++iter) {
+    elements_.emplace_back(iter.GetKey(), iter.GetValueRef());
   }
+  // Sort pointers so that string keys are not copied around.
+  for (const Element& element : elements_) {
+    sorted_elements_.push_back(&element);
+  }
+  std::sort(sorted_elements_.begin(), sorted_elements_.end(),
+            [](const Element* a, const Element* b) {
+              return a->first < b->first;
+            });
+  entry_view_ = std::make_unique<MapEntryView>(message, field);
+}
+
+const Message& MapFieldPrinterHelper::Entry(int index) {
+  if (entry_view_ == nullptr) return *sorted_entries_[index];
+  const Element& element = *sorted_elements_[index];
+  return entry_view_->Set(element.first, element.second);
 }
 }  // namespace internal
 
@@ -2478,12 +2416,11 @@ void TextFormat::Printer::PrintField(const Message& message,
     count = 1;
   }
 
-  std::vector<const Message*> sorted_map_field;
-  bool need_release = false;
+  std::unique_ptr<internal::MapFieldPrinterHelper> sorted_map;
   bool is_map = field->is_map();
   if (is_map) {
-    need_release = internal::MapFieldPrinterHelper::SortMap(
-        message, reflection, field, &sorted_map_field);
+    sorted_map = std::make_unique<internal::MapFieldPrinterHelper>(
+        message, reflection, field);
   }
 
   for (int j = 0; j < count; ++j) {
@@ -2495,7 +2432,7 @@ void TextFormat::Printer::PrintField(const Message& message,
       const FastFieldValuePrinter* printer = GetFieldPrinter(field);
       const Message& sub_message =
           field->is_repeated()
-              ? (is_map ? *sorted_map_field[j]
+              ? (is_map ? sorted_map->Entry(j)
                         : reflection->GetRepeatedMessage(message, field, j))
               : reflection->GetMessage(message, field);
       printer->PrintMessageStart(sub_message, field_index, count,
@@ -2519,12 +2456,6 @@ void TextFormat::Printer::PrintField(const Message& message,
       }
     }
   }
-
-  if (need_release) {
-    for (const Message* message_to_delete : sorted_map_field) {
-      delete message_to_delete;
-    }
-  }
 }
 
 void TextFormat::Printer::PrintShortRepeatedField(
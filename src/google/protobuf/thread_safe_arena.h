@@ -124,6 +124,11 @@ class PROTOBUF_EXPORT ThreadSafeArena {
   // Add object pointer and cleanup function pointer to the list.
   void AddCleanup(void* elem, void (*cleanup)(void*));
 
+  // Saves and restores the allocation state of the calling thread's
+  // SerialArena. See Arena::Checkpoint().
+  ArenaCheckpoint Checkpoint();
+  void RewindTo(const ArenaCheckpoint& checkpoint);
+
  private:
   friend class ArenaBenchmark;
   friend class TcParser;
@@ -33,7 +33,12 @@
 
 #include "google/protobuf/util/delimited_message_util.h"
 
+#include <algorithm>
+#include <climits>
+
+#include "google/protobuf/stubs/logging.h"
 #include "google/protobuf/io/coded_stream.h"
+#include "google/protobuf/io/zero_copy_stream_impl_lite.h"
 
 namespace google {
 namespace protobuf {
@@ -124,6 +129,221 @@ bool SerializeDelimitedToCodedStream(const MessageLite& message,
   return true;
 }
 
+DelimitedRecordIndex::DelimitedRecordIndex(int interval)
+    : interval_(interval) {
+  GOOGLE_ABSL_DCHECK_GT(interval, 0);
+}
+
+std::string DelimitedRecordIndex::SerializeAsString() const {
+  std::string data;
+  {
+    io::StringOutputStream output(&data);
+    io::CodedOutputStream coded_output(&output);
+    coded_output.WriteVarint32(static_cast<uint32_t>(interval_));
+    int64_t previous = 0;
+    for (int64_t offset : offsets_) {
+      coded_output.WriteVarint64(static_cast<uint64_t>(offset - previous));
+      previous = offset;
+    }
+  }
+  return data;
+}
+
+bool DelimitedRecordIndex::ParseFromString(absl::string_view data) {
+  if (data.size() > INT_MAX) return false;
+  io::CodedInputStream input(reinterpret_cast<const uint8_t*>(data.data()),
+                             static_cast<int>(data.size()));
+  uint32_t interval;
+  if (!input.ReadVarint32(&interval) || interval == 0 || interval > INT_MAX) {
+    return false;
+  }
+  std::vector<int64_t> offsets;
+  int64_t offset = 0;
+  while (input.CurrentPosition() < static_cast<int>(data.size())) {
+    uint64_t delta;
+    if (!input.ReadVarint64(&delta)) return false;
+    offset += static_cast<int64_t>(delta);
+    offsets.push_back(offset);
+  }
+  interval_ = static_cast<int>(interval);
+  offsets_ = std::move(offsets);
+  return true;
+}
+
+DelimitedRecordWriter::DelimitedRecordWriter(io::ZeroCopyOutputStream* output,
+                                             DelimitedRecordIndex* index)
+    : output_(output), index_(index) {}
+
+void DelimitedRecordWriter::StartRecord(uint32_t size) {
+  if (index_ != nullptr && records_written_ % index_->interval() == 0) {
+    index_->offsets_.push_back(position_);
+  }
+  ++records_written_;
+  position_ +=
+      static_cast<int64_t>(io::CodedOutputStream::VarintSize32(size)) + size;
+  output_.WriteVarint32(size);
+}
+
+bool DelimitedRecordWriter::Write(const MessageLite& message) {
+  const size_t size = message.ByteSizeLong();
+  if (size > INT_MAX) return false;
+  StartRecord(static_cast<uint32_t>(size));
+  uint8_t* buffer =
+      output_.GetDirectBufferForNBytesAndAdvance(static_cast<int>(size));
+  if (buffer != nullptr) {
+    message.SerializeWithCachedSizesToArray(buffer);
+    return true;
+  }
+  message.SerializeWithCachedSizes(&output_);
+  return !output_.HadError();
+}
+
+bool DelimitedRecordWriter::WriteRaw(absl::string_view record) {
+  if (record.size() > INT_MAX) return false;
+  StartRecord(static_cast<uint32_t>(record.size()));
+  output_.WriteRaw(record.data(), static_cast<int>(record.size()));
+  return !output_.HadError();
+}
+
+DelimitedRecordReader::DelimitedRecordReader(io::ZeroCopyInputStream* input)
+    : input_(input) {}
+
+DelimitedRecordReader::~DelimitedRecordReader() {
+  if (ptr_ != end_) input_->BackUp(static_cast<int>(end_ - ptr_));
+}
+
+bool DelimitedRecordReader::Fail() {
+  failed_ = true;
+  return false;
+}
+
+bool DelimitedRecordReader::Refill() {
+  const void* data;
+  int size;
+  do {
+    if (!input_->Next(&data, &size)) {
+      ptr_ = end_ = nullptr;
+      return false;
+    }
+  } while (size == 0);
+  ptr_ = static_cast<const char*>(data);
+  end_ = ptr_ + size;
+  return true;
+}
+
+bool DelimitedRecordReader::ReadSize(uint32_t* size) {
+  if (ptr_ == end_ && !Refill()) return false;
+  uint32_t value = 0;
+  for (int shift = 0;; shift += 7) {
+    // The size may span chunks.
+    if (ptr_ == end_ && !Refill()) return Fail();
+    const uint8_t byte = static_cast<uint8_t>(*ptr_++);
+    ++position_;
+    // Sizes are at most INT_MAX, which takes five bytes, the last of them at
+    // most 7.  Anything more would not fit in `value`.
+    if (shift == 28 && byte > 0x07) return Fail();
+    value |= static_cast<uint32_t>(byte & 0x7f) << shift;
+    if (byte < 0x80) break;
+  }
+  *size = value;
+  return true;
+}
+
+bool DelimitedRecordReader::SkipBytes(int64_t count) {
+  const int64_t available = end_ - ptr_;
+  if (count <= available) {
+    ptr_ += count;
+    position_ += count;
+    return true;
+  }
+  ptr_ = end_;
+  position_ += available;
+  count -= available;
+  while (count > 0) {
+    const int chunk = static_cast<int>(std::min<int64_t>(count, INT_MAX));
+    if (!input_->Skip(chunk)) return Fail();
+    position_ += chunk;
+    count -= chunk;
+  }
+  return true;
+}
+
+bool DelimitedRecordReader::NextRaw(absl::string_view* record) {
+  if (failed_) return false;
+  uint32_t size;
+  if (!ReadSize(&size)) return false;
+  if (static_cast<size_t>(end_ - ptr_) >= size) {
+    // The whole record is in this chunk: no copy needed.
+    *record = absl::string_view(ptr_, size);
+    ptr_ += size;
+  } else {
+    scratch_.assign(ptr_, end_);
+    ptr_ = end_;
+    while (scratch_.size() < size) {
+      if (!Refill()) return Fail();
+      const size_t n = std::min(static_cast<size_t>(size - scratch_.size()),
+                                static_cast<size_t>(end_ - ptr_));
+      scratch_.append(ptr_, n);
+      ptr_ += n;
+    }
+    *record = scratch_;
+  }
+  position_ += size;
+  ++records_read_;
+  return true;
+}
+
+bool DelimitedRecordReader::Next(MessageLite* message) {
+  absl::string_view record;
+  if (!NextRaw(&record)) return false;
+  if (!message->ParseFromArray(record.data(),
+                               static_cast<int>(record.size()))) {
+    return Fail();
+  }
+  return true;
+}
+
+bool DelimitedRecordReader::NextRawBatch(int max_records,
+                                         DelimitedRecordBatch* batch) {
+  batch->Clear();
+  absl::string_view record;
+  while (batch->size() < max_records && NextRaw(&record)) {
+    batch->data_.append(record.data(), record.size());
+    batch->ends_.push_back(batch->data_.size());
+  }
+  return batch->size() > 0;
+}
+
+bool DelimitedRecordReader::SkipRecords(int64_t count) {
+  if (failed_) return false;
+  for (; count > 0; --count) {
+    uint32_t size;
+    if (!ReadSize(&size) || !SkipBytes(size)) return false;
+    ++records_read_;
+  }
+  return true;
+}
+
+bool DelimitedRecordReader::SeekTo(const DelimitedRecordIndex& index,
+                                   int64_t record) {
+  if (failed_ || record < records_read_) return false;
+  const auto& offsets = index.offsets();
+  if (!offsets.empty()) {
+    // The last indexed record at or before `record`.
+    const int64_t entry = std::min(record / index.interval(),
+                                   static_cast<int64_t>(offsets.size()) - 1);
+    const int64_t indexed_record = entry * index.interval();
+    if (indexed_record > records_read_) {
+      const int64_t offset = offsets[static_cast<size_t>(entry)];
+      // The index does not belong to this stream.
+      if (offset < position_) return Fail();
+      if (!SkipBytes(offset - position_)) return false;
+      records_read_ = indexed_record;
+    }
+  }
+  return SkipRecords(record - records_read_);
+}
+
 }  // namespace util
 }  // namespace protobuf
 }  // namespace google
@@ -34,11 +34,16 @@
 #ifndef GOOGLE_PROTOBUF_UTIL_DELIMITED_MESSAGE_UTIL_H__
 #define GOOGLE_PROTOBUF_UTIL_DELIMITED_MESSAGE_UTIL_H__
 
+#include <cstdint>
 #include <ostream>
+#include <string>
+#include <vector>
 
 #include "google/protobuf/message_lite.h"
+#include "absl/strings/string_view.h"
 #include "google/protobuf/io/coded_stream.h"
 #include "google/protobuf/io/zero_copy_stream_impl.h"
+#include "google/protobuf/repeated_ptr_field.h"
 
 // Must be included last.
 #include "google/protobuf/port_def.inc"
@@ -99,6 +104,179 @@ bool PROTOBUF_EXPORT SerializeDelimitedToZeroCopyStream(
 bool PROTOBUF_EXPORT SerializeDelimitedToCodedStream(
     const MessageLite& message, io::CodedOutputStream* output);
 
+// The byte offsets of every interval()-th record of a stream of delimited
+// messages, which let DelimitedRecordReader::SeekTo() skip to a record without
+// reading the records in front of it.  DelimitedRecordWriter builds it while
+// writing the stream; it can then be saved next to the stream, e.g. in a
+// sidecar file, with SerializeAsString().
+class PROTOBUF_EXPORT DelimitedRecordIndex {
+ public:
+  explicit DelimitedRecordIndex(int interval = 1024);
+
+  int interval() const { return interval_; }
+  // offsets()[i] is the offset of record i * interval() from the start of the
+  // stream.
+  const std::vector<int64_t>& offsets() const { return offsets_; }
+
+  // The serialization is the interval followed by the differences between
+  // consecutive offsets, all as varints.
+  std::string SerializeAsString() const;
+  bool ParseFromString(absl::string_view data);
+
+ private:
+  friend class DelimitedRecordWriter;
+
+  int interval_;
+  std::vector<int64_t> offsets_;
+};
+
+// The bytes of a run of records, as read by
+// DelimitedRecordReader::NextRawBatch().  A batch owns its bytes, so it can be
+// handed to another thread to parse while the reader goes on.
+class PROTOBUF_EXPORT DelimitedRecordBatch {
+ public:
+  int size() const { return static_cast<int>(ends_.size()); }
+  absl::string_view record(int i) const {
+    const size_t start = i == 0 ? 0 : ends_[i - 1];
+    return absl::string_view(data_).substr(start, ends_[i] - start);
+  }
+  void Clear() {
+    data_.clear();
+    ends_.clear();
+  }
+
+ private:
+  friend class DelimitedRecordReader;
+
+  std::string data_;
+  std::vector<size_t> ends_;
+};
+
+// Writes a stream of delimited messages, in the same format as
+// SerializeDelimitedToZeroCopyStream().  Unlike calling that function for each
+// message, the writer keeps one CodedOutputStream for the whole stream.  What
+// has been written is only guaranteed to have reached `output` once the
+// writer is destroyed.
+class PROTOBUF_EXPORT DelimitedRecordWriter {
+ public:
+  // If `index` is not null, the offset of every index->interval()-th record is
+  // added to it, counted from where the writer started writing to `output`.
+  explicit DelimitedRecordWriter(io::ZeroCopyOutputStream* output,
+                                 DelimitedRecordIndex* index = nullptr);
+  DelimitedRecordWriter(const DelimitedRecordWriter&) = delete;
+  DelimitedRecordWriter& operator=(const DelimitedRecordWriter&) = delete;
+
+  // Both return false if the record exceeds 2GB.  Like
+  // SerializeDelimitedToZeroCopyStream(), they only notice errors of `output`
+  // when the record does not fit in its current buffer; HadError() catches
+  // all of them.
+  bool Write(const MessageLite& message);
+  // Writes a record that has already been serialized.
+  bool WriteRaw(absl::string_view record);
+
+  // Returns true if there was an error writing to `output`.  This flushes
+  // the buffered data, so it is best called once at the end.
+  bool HadError() { return output_.HadError(); }
+
+  int64_t records_written() const { return records_written_; }
+  // Number of bytes written, which unlike CodedOutputStream::ByteCount() may
+  // exceed 2GB.
+  int64_t position() const { return position_; }
+
+ private:
+  void StartRecord(uint32_t size);
+
+  io::CodedOutputStream output_;
+  DelimitedRecordIndex* const index_;
+  int64_t records_written_ = 0;
+  int64_t position_ = 0;
+};
+
+// Reads a stream of delimited messages, as written by DelimitedRecordWriter
+// or SerializeDelimitedToZeroCopyStream().  Rather than setting up a
+// CodedInputStream with a limit for each message, the reader takes the
+// chunks of `input` directly: a record that lies within one chunk is parsed
+// from it in place, and only one that spans chunks is copied first.  Streams
+// longer than 2GB are supported.
+//
+// When the reader is destroyed, `input` is backed up to just after the last
+// record read.
+class PROTOBUF_EXPORT DelimitedRecordReader {
+ public:
+  explicit DelimitedRecordReader(io::ZeroCopyInputStream* input);
+  DelimitedRecordReader(const DelimitedRecordReader&) = delete;
+  DelimitedRecordReader& operator=(const DelimitedRecordReader&) = delete;
+  ~DelimitedRecordReader();
+
+  // Clears `message` and parses the next record into it.  Returns false at
+  // the end of the stream, or on an error; failed() tells them apart.  Like
+  // ParseFromArray(), fails if required fields are missing.
+  bool Next(MessageLite* message);
+
+  // Returns the bytes of the next record, without parsing them.  They stay
+  // valid until the next call on the reader.
+  bool NextRaw(absl::string_view* record);
+
+  // Replaces the contents of `records` with up to `max_records` records.
+  // Records are only added once parsed, and elements that `records` has
+  // already allocated are reused, so reading batches into the same field
+  // allocates little.  If `records` is on an arena, the records are allocated
+  // on that arena.  Returns the number of records read, which is less than
+  // `max_records` at the end of the stream or on an error.
+  template <typename T>
+  int NextBatch(int max_records, RepeatedPtrField<T>* records) {
+    records->Clear();
+    while (records->size() < max_records) {
+      T* record = records->Add();
+      if (!Next(record)) {
+        records->RemoveLast();
+        break;
+      }
+    }
+    return records->size();
+  }
+
+  // Replaces the contents of `batch` with the bytes of up to `max_records`
+  // records, for parsing elsewhere, e.g. on worker threads.  Returns false if
+  // no record could be read.
+  bool NextRawBatch(int max_records, DelimitedRecordBatch* batch);
+
+  // Skips `count` records without parsing them.
+  bool SkipRecords(int64_t count);
+
+  // Skips ahead to record number `record` of the stream, using `index` to skip
+  // most of the records in between without reading them.  `index` must be
+  // that of the stream, which the reader must have been reading from its
+  // start.  As ZeroCopyInputStream only goes forward, so does SeekTo(): to go
+  // back to an earlier record, seek with a new stream and reader.
+  bool SeekTo(const DelimitedRecordIndex& index, int64_t record);
+
+  // Returns true if a call returned false because of an error rather than at
+  // the end of the stream.
+  bool failed() const { return failed_; }
+  int64_t records_read() const { return records_read_; }
+  // Offset of the next record from the start of the stream.
+  int64_t position() const { return position_; }
+
+ private:
+  bool Fail();
+  // Moves to the next non-empty chunk of the input.
+  bool Refill();
+  // Reads the size of the next record; returns false at the end of the
+  // stream.
+  bool ReadSize(uint32_t* size);
+  bool SkipBytes(int64_t count);
+
+  io::ZeroCopyInputStream* const input_;
+  const char* ptr_ = nullptr;
+  const char* end_ = nullptr;
+  int64_t position_ = 0;
+  int64_t records_read_ = 0;
+  // Holds records that span chunks.
+  std::string scratch_;
+  bool failed_ = false;
+};
+
 }  // namespace util
 }  // namespace protobuf
 }  // namespace google
@@ -34,11 +34,13 @@
 #include "google/protobuf/util/delimited_message_util.h"
 
 #include <sstream>
+#include <string>
 
 #include "google/protobuf/testing/googletest.h"
 #include <gtest/gtest.h>
 #include "google/protobuf/test_util.h"
 #include "google/protobuf/unittest.pb.h"
+#include "google/protobuf/io/zero_copy_stream_impl_lite.h"
 
 namespace google {
 namespace protobuf {
@@ -111,6 +113,194 @@ TEST(DelimitedMessageUtilTest, FailsAtEndOfStream) {
   }
 }
 
+TEST(DelimitedMessageUtilTest, RecordReaderAndWriter) {
+  std::string data;
+  int64_t position;
+  DelimitedRecordIndex index(/*interval=*/3);
+  {
+    io::StringOutputStream output(&data);
+    DelimitedRecordWriter writer(&output, &index);
+    protobuf_unittest::TestAllTypes message;
+    TestUtil::SetAllFields(&message);
+    for (int i = 0; i < 10; ++i) {
+      message.set_optional_int32(i);
+      if (i == 5) {
+        EXPECT_TRUE(writer.WriteRaw(message.SerializeAsString()));
+      } else {
+        EXPECT_TRUE(writer.Write(message));
+      }
+    }
+    EXPECT_EQ(10, writer.records_written());
+    EXPECT_FALSE(writer.HadError());
+    position = writer.position();
+  }
+  EXPECT_EQ(static_cast<int64_t>(data.size()), position);
+  ASSERT_EQ(4, index.offsets().size());
+
+  {
+    // Small blocks make records span chunks.
+    io::ArrayInputStream input(data.data(), static_cast<int>(data.size()),
+                               /*block_size=*/100);
+    DelimitedRecordReader reader(&input);
+    protobuf_unittest::TestAllTypes message;
+    for (int i = 0; i < 10; ++i) {
+      if (i % 3 == 0) EXPECT_EQ(index.offsets()[i / 3], reader.position());
+      ASSERT_TRUE(reader.Next(&message));
+      EXPECT_EQ(i, message.optional_int32());
+      EXPECT_EQ("115", message.optional_string());
+    }
+    EXPECT_FALSE(reader.Next(&message));
+    EXPECT_FALSE(reader.failed());
+    EXPECT_EQ(10, reader.records_read());
+    EXPECT_EQ(static_cast<int64_t>(data.size()), reader.position());
+  }
+
+  {
+    io::ArrayInputStream input(data.data(), static_cast<int>(data.size()));
+    DelimitedRecordReader reader(&input);
+    RepeatedPtrField<protobuf_unittest::TestAllTypes> batch;
+    EXPECT_EQ(4, reader.NextBatch(4, &batch));
+    EXPECT_EQ(3, batch.Get(3).optional_int32());
+    DelimitedRecordBatch raw_batch;
+    ASSERT_TRUE(reader.NextRawBatch(4, &raw_batch));
+    ASSERT_EQ(4, raw_batch.size());
+    protobuf_unittest::TestAllTypes message;
+    ASSERT_TRUE(message.ParseFromString(raw_batch.record(1)));
+    EXPECT_EQ(5, message.optional_int32());
+    EXPECT_EQ(2, reader.NextBatch(4, &batch));
+    EXPECT_EQ(9, batch.Get(1).optional_int32());
+    EXPECT_FALSE(reader.NextRawBatch(4, &raw_batch));
+    EXPECT_FALSE(reader.failed());
+  }
+}
+
+TEST(DelimitedMessageUtilTest, RecordReaderSeekTo) {
+  std::string data;
+  DelimitedRecordIndex index(/*interval=*/4);
+  {
+    io::StringOutputStream output(&data);
+    DelimitedRecordWriter writer(&output, &index);
+    protobuf_unittest::ForeignMessage message;
+    for (int i = 0; i < 20; ++i) {
+      message.set_c(i);
+      EXPECT_TRUE(writer.Write(message));
+    }
+  }
+  DelimitedRecordIndex parsed_index;
+  ASSERT_TRUE(parsed_index.ParseFromString(index.SerializeAsString()));
+  EXPECT_EQ(4, parsed_index.interval());
+  EXPECT_EQ(index.offsets(), parsed_index.offsets());
+
+  io::ArrayInputStream input(data.data(), static_cast<int>(data.size()),
+                             /*block_size=*/7);
+  DelimitedRecordReader reader(&input);
+  protobuf_unittest::ForeignMessage message;
+  ASSERT_TRUE(reader.SeekTo(parsed_index, 9));
+  EXPECT_EQ(9, reader.records_read());
+  ASSERT_TRUE(reader.Next(&message));
+  EXPECT_EQ(9, message.c());
+  ASSERT_TRUE(reader.SeekTo(parsed_index, 19));
+  ASSERT_TRUE(reader.Next(&message));
+  EXPECT_EQ(19, message.c());
+  // Only forward.
+  EXPECT_FALSE(reader.SeekTo(parsed_index, 3));
+  EXPECT_FALSE(reader.SeekTo(parsed_index, 25));
+  EXPECT_FALSE(reader.failed());
+}
+
+TEST(DelimitedMessageUtilTest, RecordReaderErrors) {
+  std::string data;
+  {
+    io::StringOutputStream output(&data);
+    DelimitedRecordWriter writer(&output);
+    protobuf_unittest::ForeignMessage message;
+    message.set_c(1);
+    EXPECT_TRUE(writer.Write(message));
+    EXPECT_TRUE(writer.Write(message));
+  }
+  protobuf_unittest::ForeignMessage message;
+
+  // Truncated in the second record.
+  io::ArrayInputStream truncated(data.data(),
+                                 static_cast<int>(data.size()) - 1);
+  DelimitedRecordReader reader(&truncated);
+  EXPECT_TRUE(reader.Next(&message));
+  EXPECT_FALSE(reader.Next(&message));
+  EXPECT_TRUE(reader.failed());
+
+  // Missing required fields.
+  io::ArrayInputStream input(data.data(), static_cast<int>(data.size()));
+  DelimitedRecordReader required_reader(&input);
+  protobuf_unittest::TestRequired required;
+  EXPECT_FALSE(required_reader.Next(&required));
+  EXPECT_TRUE(required_reader.failed());
+}
+
+TEST(DelimitedMessageUtilTest, RecordReaderRejectsOversizedRecords) {
+  protobuf_unittest::ForeignMessage message;
+  const std::string sizes[] = {
+      // 2^31, one more than the largest record.
+      std::string("\x80\x80\x80\x80\x08", 5),
+      // 2^32, whose fifth byte has bits that a 32-bit size cannot hold.
+      std::string("\x80\x80\x80\x80\x10", 5),
+      std::string("\xff\xff\xff\xff\x7f", 5),
+      // A sixth byte.
+      std::string("\x80\x80\x80\x80\x80\x00", 6),
+  };
+  for (const std::string& size : sizes) {
+    io::ArrayInputStream input(size.data(), static_cast<int>(size.size()));
+    DelimitedRecordReader reader(&input);
+    absl::string_view record;
+    EXPECT_FALSE(reader.NextRaw(&record));
+    EXPECT_TRUE(reader.failed());
+  }
+
+  // INT_MAX itself is a valid size, but the record is missing.
+  const std::string max_size("\xff\xff\xff\xff\x07", 5);
+  io::ArrayInputStream input(max_size.data(),
+                             static_cast<int>(max_size.size()));
+  DelimitedRecordReader reader(&input);
+  EXPECT_FALSE(reader.SkipRecords(1));
+  EXPECT_TRUE(reader.failed());
+  EXPECT_EQ(0, reader.records_read());
+}
+
+TEST(DelimitedMessageUtilTest, RecordWriterReportsErrors) {
+  // Too small for a record that does not fit in the buffer.
+  char buffer[8];
+  io::ArrayOutputStream output(buffer, sizeof(buffer));
+  DelimitedRecordWriter writer(&output);
+  EXPECT_TRUE(writer.WriteRaw("abc"));
+  EXPECT_FALSE(writer.WriteRaw("0123456789"));
+  EXPECT_TRUE(writer.HadError());
+
+  io::ArrayOutputStream message_output(buffer, sizeof(buffer));
+  DelimitedRecordWriter message_writer(&message_output);
+  protobuf_unittest::TestAllTypes message;
+  message.set_optional_string("0123456789");
+  EXPECT_FALSE(message_writer.Write(message));
+  EXPECT_TRUE(message_writer.HadError());
+}
+
+TEST(DelimitedMessageUtilTest, RecordReaderBacksUpInput) {
+  std::string data;
+  {
+    io::StringOutputStream output(&data);
+    DelimitedRecordWriter writer(&output);
+    protobuf_unittest::ForeignMessage message;
+    message.set_c(1);
+    EXPECT_TRUE(writer.Write(message));
+  }
+  data += "trailer";
+  io::ArrayInputStream input(data.data(), static_cast<int>(data.size()));
+  {
+    DelimitedRecordReader reader(&input);
+    protobuf_unittest::ForeignMessage message;
+    EXPECT_TRUE(reader.Next(&message));
+  }
+  EXPECT_EQ(static_cast<int64_t>(data.size() - 7), input.ByteCount());
+}
+
 }  // namespace util
 }  // namespace protobuf
 }  // namespace google
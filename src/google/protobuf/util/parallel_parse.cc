@@ -0,0 +1,185 @@
+// Protocol Buffers - Google's data interchange format
+// Copyright 2008 Google Inc.  All rights reserved.
+// https://developers.google.com/protocol-buffers/
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "google/protobuf/util/parallel_parse.h"
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/blocking_counter.h"
+#include "google/protobuf/descriptor.h"
+#include "google/protobuf/io/coded_stream.h"
+#include "google/protobuf/wire_format_lite.h"
+
+// Must be included last.
+#include "google/protobuf/port_def.inc"
+
+namespace google {
+namespace protobuf {
+namespace util {
+
+namespace {
+
+using internal::WireFormatLite;
+
+// One top-level field occurrence in the input.
+struct Record {
+  // Set if the record may be parsed on a worker: the field is a repeated,
+  // length-delimited, non-map message field.
+  const FieldDescriptor* field;
+  // Offsets of the tag, the payload and the end of the record.
+  int start;
+  int payload;
+  int end;
+};
+
+bool IsSplittable(const FieldDescriptor* field) {
+  return field != nullptr && field->is_repeated() && !field->is_map() &&
+         field->type() == FieldDescriptor::TYPE_MESSAGE;
+}
+
+// Finds the boundaries of every top-level field in `data`.
+bool ScanRecords(absl::string_view data, const Descriptor* descriptor,
+                 std::vector<Record>* records) {
+  io::CodedInputStream input(reinterpret_cast<const uint8_t*>(data.data()),
+                             static_cast<int>(data.size()));
+  while (true) {
+    int start = input.CurrentPosition();
+    uint32_t tag = input.ReadTag();
+    if (tag == 0) return input.ConsumedEntireMessage();
+    const FieldDescriptor* field = nullptr;
+    if (WireFormatLite::GetTagWireType(tag) ==
+        WireFormatLite::WIRETYPE_LENGTH_DELIMITED) {
+      field =
+          descriptor->FindFieldByNumber(WireFormatLite::GetTagFieldNumber(tag));
+      if (!IsSplittable(field)) field = nullptr;
+    }
+    if (field != nullptr) {
+      uint32_t length;
+      if (!input.ReadVarint32(&length)) return false;
+      int payload = input.CurrentPosition();
+      if (!input.Skip(static_cast<int>(length))) return false;
+      records->push_back({field, start, payload, input.CurrentPosition()});
+    } else {
+      if (!WireFormatLite::SkipField(&input, tag)) return false;
+      records->push_back({nullptr, start, start, input.CurrentPosition()});
+    }
+  }
+}
+
+bool ParseParallelImpl(absl::string_view data,
+                       const ParallelParseExecutor& executor, Message* message,
+                       const ParallelParseOptions& options) {
+  const int elements_per_task = std::max(options.elements_per_task, 1);
+  message->Clear();
+  std::vector<Record> records;
+  if (!ScanRecords(data, message->GetDescriptor(), &records)) return false;
+
+  absl::flat_hash_map<const FieldDescriptor*, int> counts;
+  for (const Record& record : records) {
+    if (record.field != nullptr) ++counts[record.field];
+  }
+  for (Record& record : records) {
+    if (record.field != nullptr && counts[record.field] <= elements_per_task) {
+      record.field = nullptr;
+    }
+  }
+
+  // Everything that stays on this thread is parsed from one buffer holding
+  // those records in their original order.
+  std::string rest;
+  for (const Record& record : records) {
+    if (record.field == nullptr) {
+      rest.append(data.data() + record.start, record.end - record.start);
+    }
+  }
+  if (rest.size() == data.size()) {
+    return message->ParsePartialFromString(data);
+  }
+  if (!message->ParsePartialFromString(rest)) return false;
+
+  // Elements are appended serially to keep wire order; only parsing them is
+  // done by the tasks.
+  const Reflection* reflection = message->GetReflection();
+  std::vector<std::pair<Message*, absl::string_view>> elements;
+  for (const Record& record : records) {
+    if (record.field == nullptr) continue;
+    elements.emplace_back(
+        reflection->AddMessage(message, record.field),
+        data.substr(record.payload, record.end - record.payload));
+  }
+
+  const int num_elements = static_cast<int>(elements.size());
+  const int num_tasks = (num_elements + elements_per_task - 1) /
+                        elements_per_task;
+  absl::BlockingCounter pending(num_tasks);
+  std::atomic<bool> success{true};
+  for (int begin = 0; begin < num_elements; begin += elements_per_task) {
+    const int end = std::min(begin + elements_per_task, num_elements);
+    executor([&elements, &pending, &success, begin, end] {
+      for (int i = begin; i < end; ++i) {
+        if (!elements[i].first->ParsePartialFromString(elements[i].second)) {
+          success.store(false, std::memory_order_relaxed);
+          break;
+        }
+      }
+      pending.DecrementCount();
+    });
+  }
+  pending.Wait();
+  return success.load(std::memory_order_relaxed);
+}
+
+}  // namespace
+
+bool ParseFromStringParallel(absl::string_view data,
+                             const ParallelParseExecutor& executor,
+                             Message* message,
+                             const ParallelParseOptions& options) {
+  return ParseParallelImpl(data, executor, message, options) &&
+         message->IsInitialized();
+}
+
+bool ParsePartialFromStringParallel(absl::string_view data,
+                                    const ParallelParseExecutor& executor,
+                                    Message* message,
+                                    const ParallelParseOptions& options) {
+  return ParseParallelImpl(data, executor, message, options);
+}
+
+}  // namespace util
+}  // namespace protobuf
+}  // namespace google
+
+#include "google/protobuf/port_undef.inc"
@@ -0,0 +1,91 @@
+// Protocol Buffers - Google's data interchange format
+// Copyright 2008 Google Inc.  All rights reserved.
+// https://developers.google.com/protocol-buffers/
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Utilities for parsing messages with very large repeated message fields on
+// several threads.
+
+#ifndef GOOGLE_PROTOBUF_UTIL_PARALLEL_PARSE_H__
+#define GOOGLE_PROTOBUF_UTIL_PARALLEL_PARSE_H__
+
+#include <functional>
+
+#include "google/protobuf/message.h"
+#include "absl/strings/string_view.h"
+
+// Must be included last.
+#include "google/protobuf/port_def.inc"
+
+namespace google {
+namespace protobuf {
+namespace util {
+
+// Schedules `task` to run at some point, possibly on another thread. The
+// parse functions below block until every task they scheduled has finished, so
+// an executor that simply runs `task` inline is valid (if pointless).
+using ParallelParseExecutor = std::function<void(std::function<void()> task)>;
+
+struct ParallelParseOptions {
+  // Number of repeated field elements parsed by a single task. Top-level
+  // repeated message fields with no more elements than this are parsed on the
+  // calling thread.
+  int elements_per_task = 1024;
+};
+
+// Parses `data` into `message` with the semantics of
+// Message::ParseFromString(), spreading the elements of large top-level
+// repeated message fields across tasks run by `executor`.
+//
+// The input is first scanned to find the boundaries of every top-level field.
+// All fields except the large repeated message fields are parsed on the
+// calling thread, then the repeated field elements are appended in wire order
+// and parsed concurrently, each into its own element. If `message` lives on an
+// arena the elements are allocated there too, and since arenas are thread-safe
+// each worker thread allocates from its own block of that arena.
+//
+// Map fields are never split. `data` must stay alive until this returns.
+bool PROTOBUF_EXPORT ParseFromStringParallel(
+    absl::string_view data, const ParallelParseExecutor& executor,
+    Message* message,
+    const ParallelParseOptions& options = ParallelParseOptions());
+
+// Like ParseFromStringParallel(), but accepts messages that are missing
+// required fields.
+bool PROTOBUF_EXPORT ParsePartialFromStringParallel(
+    absl::string_view data, const ParallelParseExecutor& executor,
+    Message* message,
+    const ParallelParseOptions& options = ParallelParseOptions());
+
+}  // namespace util
+}  // namespace protobuf
+}  // namespace google
+
+#include "google/protobuf/port_undef.inc"
+
+#endif  // GOOGLE_PROTOBUF_UTIL_PARALLEL_PARSE_H__
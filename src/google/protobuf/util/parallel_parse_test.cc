@@ -0,0 +1,175 @@
+// Protocol Buffers - Google's data interchange format
+// Copyright 2008 Google Inc.  All rights reserved.
+// https://developers.google.com/protocol-buffers/
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "google/protobuf/util/parallel_parse.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "absl/synchronization/mutex.h"
+#include "google/protobuf/arena.h"
+#include "google/protobuf/test_util.h"
+#include "google/protobuf/unittest.pb.h"
+
+namespace google {
+namespace protobuf {
+namespace util {
+namespace {
+
+// Runs every task on its own thread and joins them on destruction.
+class ThreadPerTaskExecutor {
+ public:
+  ~ThreadPerTaskExecutor() {
+    absl::MutexLock lock(&mu_);
+    for (auto& thread : threads_) thread.join();
+  }
+
+  ParallelParseExecutor executor() {
+    return [this](std::function<void()> task) {
+      absl::MutexLock lock(&mu_);
+      threads_.emplace_back(std::move(task));
+    };
+  }
+
+ private:
+  absl::Mutex mu_;
+  std::vector<std::thread> threads_;
+};
+
+std::string MakeLargeMessage(int num_elements) {
+  protobuf_unittest::TestAllTypes message;
+  TestUtil::SetAllFields(&message);
+  for (int i = 0; i < num_elements; ++i) {
+    message.add_repeated_nested_message()->set_bb(i);
+    message.add_repeated_foreign_message()->set_c(-i);
+  }
+  return message.SerializeAsString();
+}
+
+TEST(ParallelParseTest, MatchesSerialParse) {
+  const std::string data = MakeLargeMessage(1000);
+  protobuf_unittest::TestAllTypes expected;
+  ASSERT_TRUE(expected.ParseFromString(data));
+
+  for (int elements_per_task : {1, 7, 100, 5000}) {
+    SCOPED_TRACE(elements_per_task);
+    ParallelParseOptions options;
+    options.elements_per_task = elements_per_task;
+    ThreadPerTaskExecutor pool;
+    protobuf_unittest::TestAllTypes message;
+    ASSERT_TRUE(
+        ParseFromStringParallel(data, pool.executor(), &message, options));
+    EXPECT_EQ(message.SerializeAsString(), expected.SerializeAsString());
+  }
+}
+
+TEST(ParallelParseTest, ParsesOnArena) {
+  const std::string data = MakeLargeMessage(1000);
+  Arena arena;
+  auto* message =
+      Arena::CreateMessage<protobuf_unittest::TestAllTypes>(&arena);
+  ParallelParseOptions options;
+  options.elements_per_task = 64;
+  {
+    ThreadPerTaskExecutor pool;
+    ASSERT_TRUE(
+        ParseFromStringParallel(data, pool.executor(), message, options));
+  }
+  ASSERT_EQ(message->repeated_nested_message_size(), 1002);
+  EXPECT_EQ(message->repeated_nested_message(1001).bb(), 999);
+  EXPECT_EQ(message->repeated_nested_message(0).GetArena(), &arena);
+  EXPECT_EQ(message->SerializeAsString(), data);
+}
+
+TEST(ParallelParseTest, InlineExecutor) {
+  const std::string data = MakeLargeMessage(100);
+  ParallelParseOptions options;
+  options.elements_per_task = 10;
+  protobuf_unittest::TestAllTypes message;
+  ASSERT_TRUE(ParseFromStringParallel(
+      data, [](std::function<void()> task) { task(); }, &message, options));
+  EXPECT_EQ(message.SerializeAsString(), data);
+}
+
+TEST(ParallelParseTest, FailsOnMalformedElement) {
+  protobuf_unittest::TestAllTypes message;
+  for (int i = 0; i < 100; ++i) {
+    message.add_repeated_nested_message()->set_bb(i);
+  }
+  std::string data = message.SerializeAsString();
+  // Each element is encoded as tag, length 2, tag of `bb`, value. Replace the
+  // last element's field tag with an invalid one.
+  data[data.size() - 2] = 0;
+
+  ParallelParseOptions options;
+  options.elements_per_task = 10;
+  ThreadPerTaskExecutor pool;
+  EXPECT_FALSE(
+      ParseFromStringParallel(data, pool.executor(), &message, options));
+}
+
+TEST(ParallelParseTest, FailsOnTruncatedInput) {
+  std::string data = MakeLargeMessage(100);
+  data.resize(data.size() - 1);
+  ParallelParseOptions options;
+  options.elements_per_task = 10;
+  ThreadPerTaskExecutor pool;
+  protobuf_unittest::TestAllTypes message;
+  EXPECT_FALSE(
+      ParseFromStringParallel(data, pool.executor(), &message, options));
+}
+
+TEST(ParallelParseTest, RequiredFieldsInElements) {
+  protobuf_unittest::TestRequiredForeign message;
+  for (int i = 0; i < 100; ++i) {
+    auto* element = message.add_repeated_message();
+    element->set_a(i);
+    if (i != 50) element->set_b(i);
+  }
+  const std::string data = message.SerializePartialAsString();
+
+  ParallelParseOptions options;
+  options.elements_per_task = 10;
+  ThreadPerTaskExecutor pool;
+  protobuf_unittest::TestRequiredForeign parsed;
+  EXPECT_FALSE(
+      ParseFromStringParallel(data, pool.executor(), &parsed, options));
+  EXPECT_TRUE(
+      ParsePartialFromStringParallel(data, pool.executor(), &parsed, options));
+  EXPECT_EQ(parsed.repeated_message_size(), 100);
+  EXPECT_FALSE(parsed.repeated_message(50).has_b());
+}
+
+}  // namespace
+}  // namespace util
+}  // namespace protobuf
+}  // namespace google
@@ -44,6 +44,7 @@
 #include "google/protobuf/descriptor.h"
 #include "google/protobuf/descriptor.pb.h"
 #include "google/protobuf/dynamic_message.h"
+#include "google/protobuf/generated_message_tctable_reverse.h"
 #include "google/protobuf/io/coded_stream.h"
 #include "google/protobuf/io/zero_copy_stream.h"
 #include "google/protobuf/io/zero_copy_stream_impl.h"
@@ -67,6 +68,8 @@ namespace internal {
 // Forward declare static functions
 static size_t MapValueRefDataOnlyByteSize(const FieldDescriptor* field,
                                           const MapValueConstRef& value);
+static const TcParseTableBase* GetTcParseTableOfMessage(
+    const MessageLite& message);
 
 // ===================================================================
 
@@ -1494,6 +1497,29 @@ size_t WireFormat::ByteSize(const Message& message) {
   return our_size;
 }
 
+bool WireFormat::SerializeReverse(const Message& message,
+                                  std::string* output) {
+  if (!TcReverseSerializer::Serialize(message, &GetTcParseTableOfMessage,
+                                      output)) {
+    GOOGLE_ABSL_LOG(ERROR) << message.GetTypeName()
+                    << " exceeded maximum protobuf size of 2GB";
+    return false;
+  }
+  return true;
+}
+
+const TcParseTableBase* WireFormat::GetTcParseTable(const Message& message) {
+  const Descriptor* descriptor = message.GetDescriptor();
+  if (descriptor->extension_range_count() > 0) return nullptr;
+  return message.GetReflection()->GetTcParseTable();
+}
+
+// Sub-messages of a Message are Messages too.
+static const TcParseTableBase* GetTcParseTableOfMessage(
+    const MessageLite& message) {
+  return WireFormat::GetTcParseTable(DownCast<const Message&>(message));
+}
+
 size_t WireFormat::FieldByteSize(const FieldDescriptor* field,
                                  const Message& message) {
   const Reflection* message_reflection = message.GetReflection();
@@ -144,6 +144,18 @@ class PROTOBUF_EXPORT WireFormat {
   // WireFormat::SerializeWithCachedSizes() on the same object.
   static size_t ByteSize(const Message& message);
 
+  // Experimental: replaces the contents of `output` with the serialization of
+  // `message`, written back to front in a single pass by TcReverseSerializer
+  // using the tables reflection builds for the table-driven parser.  No sizes
+  // are computed up front or cached.  Does not check required fields.
+  // Returns false if the serialization would exceed 2GB.
+  static bool SerializeReverse(const Message& message, std::string* output);
+
+  // Returns the table reflection builds for the table-driven parser of
+  // `message`'s type, or nullptr for extendable types, whose extensions the
+  // table does not describe.
+  static const TcParseTableBase* GetTcParseTable(const Message& message);
+
   // -----------------------------------------------------------------
   // Helpers for dealing with unknown fields
 
@@ -42,6 +42,8 @@
 
 #include <limits>
 #include <string>
+#include <type_traits>
+#include <vector>
 
 #include "google/protobuf/stubs/common.h"
 #include "google/protobuf/port.h"
@@ -75,6 +77,42 @@ namespace google {
 namespace protobuf {
 namespace internal {
 
+// Sizes of length-delimited sub-messages, recorded by
+// MessageLite::FlatByteSizeLong() in the order in which _InternalSerialize()
+// writes them.  An entry is reserved before the sub-message's own fields are
+// sized, so nested sub-messages follow their parent (pre-order).
+class FlatSizeCache {
+ public:
+  FlatSizeCache() = default;
+  FlatSizeCache(const FlatSizeCache&) = delete;
+  FlatSizeCache& operator=(const FlatSizeCache&) = delete;
+
+  // Reserves the entry for the next sub-message in serialization order.
+  size_t Reserve() {
+    sizes_.push_back(0);
+    return sizes_.size() - 1;
+  }
+  void Set(size_t index, size_t size) {
+    sizes_[index] = static_cast<uint32_t>(size);
+  }
+
+  const uint32_t* data() const { return sizes_.data(); }
+  size_t size() const { return sizes_.size(); }
+  void Clear() { sizes_.clear(); }
+
+ private:
+  std::vector<uint32_t> sizes_;
+};
+
+// Whether the generated class T records its sub-message sizes in a
+// FlatSizeCache, rather than inheriting the default FlatByteSizeLong() that
+// only calls ByteSizeLong().
+template <typename T, typename = void>
+struct IsFlatSizeCacheSupported : std::false_type {};
+template <typename T>
+struct IsFlatSizeCacheSupported<T, typename T::InternalFlatSizeCacheSupported_>
+    : std::true_type {};
+
 // This class is for internal use by the protocol buffer library and by
 // protocol-compiler-generated message classes.  It must not be called
 // directly by clients.
@@ -637,6 +675,16 @@ class PROTOBUF_EXPORT WireFormatLite {
                                        int cached_size, uint8_t* target,
                                        io::EpsCopyOutputStream* stream);
 
+  // Like InternalWriteMessage(), but for _InternalSerializeFlatSized(): if
+  // MessageType supports flat sizes, takes the size of `value` from `stream`
+  // (see EpsCopyOutputStream::SetFlatSizes()) instead of from its cached size,
+  // and serializes it with flat sizes too.  The field must have been sized
+  // with MessageSize(value, sizes).
+  template <typename MessageType>
+  PROTOBUF_NDEBUG_INLINE static uint8_t* InternalWriteMessageFlatSized(
+      int field_number, const MessageType& value, uint8_t* target,
+      io::EpsCopyOutputStream* stream);
+
   // Like above, but de-virtualize the call to SerializeWithCachedSizes().  The
   // pointer must point at an instance of MessageType, *not* a subclass (or
   // the subclass must not override SerializeWithCachedSizes()).
@@ -716,6 +764,14 @@ class PROTOBUF_EXPORT WireFormatLite {
   template <typename MessageType>
   static inline size_t MessageSize(const MessageType& value);
 
+  // Like above, but if MessageType supports it, reserves an entry for `value`
+  // in `sizes` and sizes it with FlatByteSizeLong(), leaving the cached sizes
+  // of `value` and its sub-messages untouched.  Otherwise falls back to
+  // ByteSizeLong(), and the field is then serialized with cached sizes.
+  template <typename MessageType>
+  static inline size_t MessageSize(const MessageType& value,
+                                   FlatSizeCache* sizes);
+
   // Like above, but de-virtualize the call to ByteSize().  The
   // pointer must point at an instance of MessageType, *not* a subclass (or
   // the subclass must not override ByteSize()).
@@ -729,6 +785,22 @@ class PROTOBUF_EXPORT WireFormatLite {
   static inline size_t LengthDelimitedSize(size_t length);
 
  private:
+  // Dispatch on IsFlatSizeCacheSupported<MessageType>.
+  template <typename MessageType>
+  static inline size_t MessageSize(const MessageType& value,
+                                   FlatSizeCache* sizes, std::true_type);
+  template <typename MessageType>
+  static inline size_t MessageSize(const MessageType& value,
+                                   FlatSizeCache* sizes, std::false_type);
+  template <typename MessageType>
+  static inline uint8_t* InternalWriteMessageFlatSized(
+      int field_number, const MessageType& value, uint8_t* target,
+      io::EpsCopyOutputStream* stream, std::true_type);
+  template <typename MessageType>
+  static inline uint8_t* InternalWriteMessageFlatSized(
+      int field_number, const MessageType& value, uint8_t* target,
+      io::EpsCopyOutputStream* stream, std::false_type);
+
   // A helper method for the repeated primitive reader. This method has
   // optimizations for primitive types that have fixed size on the wire, and
   // can be read using potentially faster paths.
@@ -1710,6 +1782,31 @@ inline uint8_t* WireFormatLite::WriteBytesToArray(int field_number,
 }
 
 
+template <typename MessageType>
+inline uint8_t* WireFormatLite::InternalWriteMessageFlatSized(
+    int field_number, const MessageType& value, uint8_t* target,
+    io::EpsCopyOutputStream* stream) {
+  return InternalWriteMessageFlatSized(field_number, value, target, stream,
+                                       IsFlatSizeCacheSupported<MessageType>());
+}
+template <typename MessageType>
+inline uint8_t* WireFormatLite::InternalWriteMessageFlatSized(
+    int field_number, const MessageType& value, uint8_t* target,
+    io::EpsCopyOutputStream* stream, std::true_type) {
+  target = stream->EnsureSpace(target);
+  target = WriteTagToArray(field_number, WIRETYPE_LENGTH_DELIMITED, target);
+  target =
+      io::CodedOutputStream::WriteVarint32ToArray(stream->NextFlatSize(), target);
+  return value._InternalSerializeFlatSized(target, stream);
+}
+template <typename MessageType>
+inline uint8_t* WireFormatLite::InternalWriteMessageFlatSized(
+    int field_number, const MessageType& value, uint8_t* target,
+    io::EpsCopyOutputStream* stream, std::false_type) {
+  return InternalWriteMessage(field_number, value, value.GetCachedSize(),
+                              target, stream);
+}
+
 // See comment on ReadGroupNoVirtual to understand the need for this template
 // parameter name.
 template <typename MessageType_WorkAroundCppLookupDefect>
@@ -1797,6 +1894,26 @@ template <typename MessageType>
 inline size_t WireFormatLite::MessageSize(const MessageType& value) {
   return LengthDelimitedSize(value.ByteSizeLong());
 }
+template <typename MessageType>
+inline size_t WireFormatLite::MessageSize(const MessageType& value,
+                                          FlatSizeCache* sizes) {
+  return MessageSize(value, sizes, IsFlatSizeCacheSupported<MessageType>());
+}
+template <typename MessageType>
+inline size_t WireFormatLite::MessageSize(const MessageType& value,
+                                          FlatSizeCache* sizes,
+                                          std::true_type) {
+  const size_t index = sizes->Reserve();
+  const size_t size = value.FlatByteSizeLong(sizes);
+  sizes->Set(index, size);
+  return LengthDelimitedSize(size);
+}
+template <typename MessageType>
+inline size_t WireFormatLite::MessageSize(const MessageType& value,
+                                          FlatSizeCache* /*sizes*/,
+                                          std::false_type) {
+  return MessageSize(value);
+}
 
 // See comment on ReadGroupNoVirtual to understand the need for this template
 // parameter name.